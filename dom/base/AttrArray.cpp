@@ -474,7 +474,21 @@ bool AttrArray::GrowBy(uint32_t aGrowSize) {
     capacity = 1u << shift;
   }
 
-  CheckedUint32 sizeInBytes = capacity.value();
+  return SetCapacity(capacity.value());
+}
+
+nsresult AttrArray::EnsureCapacity(uint32_t aAttrCount) {
+  if (aAttrCount <= (mImpl ? mImpl->mCapacity : 0)) {
+    return NS_OK;
+  }
+
+  return SetCapacity(aAttrCount) ? NS_OK : NS_ERROR_OUT_OF_MEMORY;
+}
+
+bool AttrArray::SetCapacity(uint32_t aCapacity) {
+  MOZ_ASSERT(aCapacity >= NonMappedAttrCount());
+
+  CheckedUint32 sizeInBytes = aCapacity;
   sizeInBytes *= sizeof(InternalAttr);
   if (!sizeInBytes.isValid()) {
     return false;
@@ -486,7 +500,7 @@ bool AttrArray::GrowBy(uint32_t aGrowSize) {
   }
 
   MOZ_ASSERT(sizeInBytes.value() ==
-             Impl::AllocationSizeForAttributes(capacity.value()));
+             Impl::AllocationSizeForAttributes(aCapacity));
 
   const bool needToInitialize = !mImpl;
   Impl* newImpl =
@@ -501,7 +515,7 @@ bool AttrArray::GrowBy(uint32_t aGrowSize) {
     mImpl->mAttrCount = 0;
   }
 
-  mImpl->mCapacity = capacity.value();
+  mImpl->mCapacity = aCapacity;
   return true;
 }
 
@@ -120,6 +120,11 @@ class AttrArray {
   // unmapped attributes of |aOther|.
   nsresult EnsureCapacityToClone(const AttrArray& aOther);
 
+  // Increases capacity (if necessary) to hold exactly aAttrCount unmapped
+  // attributes, so that callers who know the attribute count up front (like
+  // the parser) don't over-allocate in GrowBy's linear steps.
+  nsresult EnsureCapacity(uint32_t aAttrCount);
+
   struct InternalAttr {
     nsAttrName mName;
     nsAttrValue mValue;
@@ -146,6 +151,10 @@ class AttrArray {
 
   bool GrowBy(uint32_t aGrowSize);
 
+  // Reallocates the buffer to hold exactly aCapacity unmapped attributes,
+  // initializing it if there was none before.
+  bool SetCapacity(uint32_t aCapacity);
+
   // Tries to create an attribute, growing the buffer if needed, with the given
   // name and value.
   //
@@ -155,6 +155,7 @@ class DOMIntersectionObserver final : public nsISupports,
 
   void Update(Document* aDocument, DOMHighResTimeStamp time);
   MOZ_CAN_RUN_SCRIPT void Notify();
+  bool HasQueuedEntries() const { return !mQueuedEntries.IsEmpty(); }
 
   static already_AddRefed<DOMIntersectionObserver> CreateLazyLoadObserver(
       Document&);
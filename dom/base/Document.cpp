@@ -15916,6 +15916,18 @@ void Document::ScheduleIntersectionObserverNotification() {
   if (mIntersectionObservers.IsEmpty()) {
     return;
   }
+  // Most ticks don't cross any threshold, so don't queue a task that would
+  // have nothing to deliver.
+  bool hasQueuedEntries = false;
+  for (DOMIntersectionObserver* observer : mIntersectionObservers) {
+    if (observer->HasQueuedEntries()) {
+      hasQueuedEntries = true;
+      break;
+    }
+  }
+  if (!hasQueuedEntries) {
+    return;
+  }
   MOZ_RELEASE_ASSERT(NS_IsMainThread());
   nsCOMPtr<nsIRunnable> notification =
       NewRunnableMethod("Document::NotifyIntersectionObservers", this,
@@ -1027,6 +1027,15 @@ class Element : public FragmentOrElement {
    */
   uint32_t GetAttrCount() const { return mAttrs.AttrCount(); }
 
+  /**
+   * Reserve room for aAttrCount attributes that are about to be set, so that
+   * the attribute storage is allocated once and at its final size.  Used by
+   * the parser, which knows the attribute count of the elements it creates.
+   */
+  nsresult EnsureAttrCapacity(uint32_t aAttrCount) {
+    return mAttrs.EnsureCapacity(aAttrCount);
+  }
+
   virtual bool IsNodeOfType(uint32_t aFlags) const override;
 
   /**
@@ -8885,6 +8885,18 @@ class StringBuilder {
     mLength += len;
   }
 
+  // Appends aString without copying it. The caller must guarantee that the
+  // string buffer outlives the builder, e.g. because it is owned by a node
+  // being serialized.
+  void AppendUnowned(const nsAString& aString) {
+    Unit* u = AddUnit();
+    u->mLiteral = aString.BeginReading();
+    u->mType = Unit::eLiteral;
+    uint32_t len = aString.Length();
+    u->mLength = len;
+    mLength += len;
+  }
+
   void Append(nsAutoString* aString) {
     Unit* u = AddUnit();
     u->mString = aString;
@@ -9160,7 +9172,8 @@ static void StartElement(Element* aContent, StringBuilder& aBuilder) {
       aContent->IsMathMLElement()) {
     aBuilder.Append(localName);
   } else {
-    aBuilder.Append(aContent->NodeName());
+    // The node's NodeInfo keeps the name alive for the whole serialization.
+    aBuilder.AppendUnowned(aContent->NodeName());
   }
 
   CustomElementData* ceData = aContent->GetCustomElementData();
@@ -9168,7 +9181,7 @@ static void StartElement(Element* aContent, StringBuilder& aBuilder) {
     nsAtom* isAttr = ceData->GetIs(aContent);
     if (isAttr && !aContent->HasAttr(kNameSpaceID_None, nsGkAtoms::is)) {
       aBuilder.Append(uR"( is=")");
-      aBuilder.Append(nsDependentAtomString(isAttr));
+      aBuilder.Append(isAttr);
       aBuilder.Append(uR"(")");
     }
   }
@@ -9336,14 +9349,14 @@ bool nsContentUtils::SerializeNodeToMarkup(nsINode* aRoot,
 
       case nsINode::DOCUMENT_TYPE_NODE: {
         builder.Append(u"<!DOCTYPE ");
-        builder.Append(current->NodeName());
+        builder.AppendUnowned(current->NodeName());
         builder.Append(u">");
         break;
       }
 
       case nsINode::PROCESSING_INSTRUCTION_NODE: {
         builder.Append(u"<?");
-        builder.Append(current->NodeName());
+        builder.AppendUnowned(current->NodeName());
         builder.Append(u" ");
         builder.Append(static_cast<nsIContent*>(current)->GetText());
         builder.Append(u">");
@@ -9359,7 +9372,7 @@ bool nsContentUtils::SerializeNodeToMarkup(nsINode* aRoot,
             elem->IsMathMLElement()) {
           builder.Append(elem->NodeInfo()->NameAtom());
         } else {
-          builder.Append(current->NodeName());
+          builder.AppendUnowned(current->NodeName());
         }
         builder.Append(u">");
       }
@@ -2048,6 +2048,21 @@ void nsJSContext::EnsureStatics() {
                                        "javascript.options.mem.gc_compacting",
                                        (void*)JSGC_COMPACTING_ENABLED);
 
+  Preferences::RegisterCallbackAndCall(
+      SetMemoryPrefChangedCallbackInt,
+      "javascript.options.mem.gc_compacting_fragmentation_threshold",
+      (void*)JSGC_COMPACTING_FRAGMENTATION_THRESHOLD);
+
+  Preferences::RegisterCallbackAndCall(
+      SetMemoryPrefChangedCallbackBool,
+      "javascript.options.mem.gc_parallel_minor",
+      (void*)JSGC_PARALLEL_MINOR_GC_ENABLED);
+
+  Preferences::RegisterCallbackAndCall(
+      SetMemoryPrefChangedCallbackBool,
+      "javascript.options.mem.gc_background_marking",
+      (void*)JSGC_BACKGROUND_MARKING_ENABLED);
+
   Preferences::RegisterCallbackAndCall(
       SetMemoryPrefChangedCallbackBool,
       "javascript.options.mem.incremental_weakmap",
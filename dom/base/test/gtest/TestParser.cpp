@@ -8,6 +8,8 @@
 #include "nsString.h"
 #include "mozilla/dom/DOMParser.h"
 #include "mozilla/dom/Document.h"
+#include "mozilla/dom/Element.h"
+#include "nsGkAtoms.h"
 #include "nsIDocumentEncoder.h"
 #include "mozilla/ErrorResult.h"
 
@@ -50,3 +52,80 @@ TEST(TestParser, TestParserMain)
 
   EXPECT_TRUE(allTestsPassed);
 }
+
+// The tokenizer skips over runs of code units that can't end the current text
+// or attribute value in one go. Put each code unit that has to stop such a run
+// at every offset up to a little over 32 code units into text, RCDATA and both
+// kinds of quoted attribute values, and check that it is still handled.
+TEST(TestParser, TestOrdinaryTextRuns)
+{
+  struct SpecialCase {
+    nsLiteralString mInput;
+    nsLiteralString mText;
+    nsLiteralString mRcdata;
+    nsLiteralString mAttribute;
+  };
+  const SpecialCase cases[] = {
+      {u"&amp;"_ns, u"&"_ns, u"&"_ns, u"&"_ns},
+      {u"&"_ns, u"&"_ns, u"&"_ns, u"&"_ns},
+      {u"\r\n"_ns, u"\n"_ns, u"\n"_ns, u"\n"_ns},
+      {u"\r"_ns, u"\n"_ns, u"\n"_ns, u"\n"_ns},
+      {u"\n"_ns, u"\n"_ns, u"\n"_ns, u"\n"_ns},
+      // NUL is dropped from text in the body, and replaced elsewhere.
+      {u"\0"_ns, u""_ns, u"\uFFFD"_ns, u"\uFFFD"_ns},
+  };
+  const uint32_t kRunLength = 40;
+
+  mozilla::IgnoredErrorResult rv;
+  RefPtr<mozilla::dom::DOMParser> parser =
+      mozilla::dom::DOMParser::CreateWithoutGlobal(rv);
+  ASSERT_FALSE(rv.Failed());
+
+  for (const SpecialCase& special : cases) {
+    for (uint32_t offset = 0; offset <= kRunLength; offset++) {
+      auto build = [&](const nsAString& aSpecial) {
+        nsAutoString run(u"a"_ns);
+        for (uint32_t i = 0; i < offset; i++) {
+          run.Append(u'x');
+        }
+        run.Append(aSpecial);
+        for (uint32_t i = offset; i < kRunLength; i++) {
+          run.Append(u'y');
+        }
+        return run;
+      };
+      nsAutoString input = build(special.mInput);
+
+      nsAutoString html(u"<!DOCTYPE html><div id=d title=\""_ns);
+      html.Append(input);
+      html.AppendLiteral(u"\">");
+      html.Append(input);
+      html.AppendLiteral(u"</div><div id=s title='");
+      html.Append(input);
+      html.AppendLiteral(u"'></div><textarea id=t>");
+      html.Append(input);
+      html.AppendLiteral(u"</textarea>");
+
+      RefPtr<mozilla::dom::Document> document = parser->ParseFromString(
+          html, mozilla::dom::SupportedType::Text_html, rv);
+      ASSERT_FALSE(rv.Failed());
+
+      mozilla::dom::Element* doubleQuoted =
+          document->GetElementById(u"d"_ns);
+      mozilla::dom::Element* singleQuoted =
+          document->GetElementById(u"s"_ns);
+      mozilla::dom::Element* textarea = document->GetElementById(u"t"_ns);
+      ASSERT_TRUE(doubleQuoted && singleQuoted && textarea);
+
+      nsAutoString value;
+      doubleQuoted->GetAttr(nsGkAtoms::title, value);
+      EXPECT_TRUE(value.Equals(build(special.mAttribute)));
+      singleQuoted->GetAttr(nsGkAtoms::title, value);
+      EXPECT_TRUE(value.Equals(build(special.mAttribute)));
+      doubleQuoted->GetTextContent(value, mozilla::IgnoreErrors());
+      EXPECT_TRUE(value.Equals(build(special.mText)));
+      textarea->GetTextContent(value, mozilla::IgnoreErrors());
+      EXPECT_TRUE(value.Equals(build(special.mRcdata)));
+    }
+  }
+}
@@ -475,13 +475,16 @@ static bool IsColorFormatSupportedForUsingCustomizedBuffer(
   // use the shmem texture for 10 bit+ videos which would be uploaded by the
   // web render. See Bug 1751498.
   return aFormat == AV_PIX_FMT_YUV420P || aFormat == AV_PIX_FMT_YUVJ420P ||
-         aFormat == AV_PIX_FMT_YUV444P;
+         aFormat == AV_PIX_FMT_YUV422P || aFormat == AV_PIX_FMT_YUV444P;
 #  else
-  // For now, we only support for YUV420P, YUVJ420P and YUV444 which are the
-  // only non-HW accelerated format supported by FFmpeg's H264 and VP9 decoder.
+  // For now, we only support for YUV420P, YUVJ420P, YUV422P and YUV444 which
+  // are the non-HW accelerated formats produced by FFmpeg's H264 and VP9
+  // decoders.
   return aFormat == AV_PIX_FMT_YUV420P || aFormat == AV_PIX_FMT_YUVJ420P ||
          aFormat == AV_PIX_FMT_YUV420P10LE ||
-         aFormat == AV_PIX_FMT_YUV420P12LE || aFormat == AV_PIX_FMT_YUV444P ||
+         aFormat == AV_PIX_FMT_YUV420P12LE || aFormat == AV_PIX_FMT_YUV422P ||
+         aFormat == AV_PIX_FMT_YUV422P10LE ||
+         aFormat == AV_PIX_FMT_YUV422P12LE || aFormat == AV_PIX_FMT_YUV444P ||
          aFormat == AV_PIX_FMT_YUV444P10LE || aFormat == AV_PIX_FMT_YUV444P12LE;
 #  endif
 }
@@ -512,6 +515,11 @@ static bool IsYUV420Sampling(const AVPixelFormat& aFormat) {
          aFormat == AV_PIX_FMT_YUV420P10LE || aFormat == AV_PIX_FMT_YUV420P12LE;
 }
 
+static bool IsYUV422Sampling(const AVPixelFormat& aFormat) {
+  return aFormat == AV_PIX_FMT_YUV422P || aFormat == AV_PIX_FMT_YUV422P10LE ||
+         aFormat == AV_PIX_FMT_YUV422P12LE;
+}
+
 layers::TextureClient*
 FFmpegVideoDecoder<LIBAV_VER>::AllocateTextureClientForImage(
     struct AVCodecContext* aCodecContext, PlanarYCbCrImage* aImage) {
@@ -558,6 +566,9 @@ FFmpegVideoDecoder<LIBAV_VER>::AllocateTextureClientForImage(
     uvDims.width = (uvDims.width + 1) / 2;
     uvDims.height = (uvDims.height + 1) / 2;
     data.mChromaSubsampling = gfx::ChromaSubsampling::HALF_WIDTH_AND_HEIGHT;
+  } else if (IsYUV422Sampling(aCodecContext->pix_fmt)) {
+    uvDims.width = (uvDims.width + 1) / 2;
+    data.mChromaSubsampling = gfx::ChromaSubsampling::HALF_WIDTH;
   }
   auto paddedCbCrSize = uvDims;
   mLib->avcodec_align_dimensions(aCodecContext, &paddedCbCrSize.width,
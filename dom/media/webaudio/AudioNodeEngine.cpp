@@ -146,6 +146,13 @@ void AudioBlockCopyChannelWithScale(const float* aInput, float aScale,
 
 void BufferComplexMultiply(const float* aInput, const float* aScale,
                            float* aOutput, uint32_t aSize) {
+#ifdef USE_NEON
+  if (mozilla::supports_neon()) {
+    BufferComplexMultiply_NEON(aInput, aScale, aOutput, aSize);
+    return;
+  }
+#endif
+
 #ifdef USE_SSE2
   if (mozilla::supports_sse()) {
     BufferComplexMultiply_SSE(aInput, aScale, aOutput, aSize);
@@ -349,4 +349,39 @@ void AudioBlockPanStereoToStereo_NEON(
     vst1q_f32(ADDRESS_OF(aOutputR, i + 4), voutR1);
   }
 }
+
+void BufferComplexMultiply_NEON(const float* aInput, const float* aScale,
+                                float* aOutput, uint32_t aSize) {
+  ASSERT_ALIGNED(aInput);
+  ASSERT_ALIGNED(aScale);
+  ASSERT_ALIGNED(aOutput);
+
+  // aSize is in complex numbers, each stored as an interleaved (real, imag)
+  // pair. vld2q deinterleaves four of them at a time.
+  float32x4x2_t vin, vscale, vout;
+
+  uint32_t dif = aSize % 4;
+  aSize -= dif;
+  unsigned i = 0;
+  for (; i < aSize * 2; i += 8) {
+    vin = vld2q_f32(ADDRESS_OF(aInput, i));
+    vscale = vld2q_f32(ADDRESS_OF(aScale, i));
+
+    vout.val[0] = vmlsq_f32(vmulq_f32(vin.val[0], vscale.val[0]), vin.val[1],
+                            vscale.val[1]);
+    vout.val[1] = vmlaq_f32(vmulq_f32(vin.val[0], vscale.val[1]), vin.val[1],
+                            vscale.val[0]);
+
+    vst2q_f32(ADDRESS_OF(aOutput, i), vout);
+  }
+
+  for (unsigned j = 0; j < dif; ++j, i += 2) {
+    float real1 = aInput[i];
+    float imag1 = aInput[i + 1];
+    float real2 = aScale[i];
+    float imag2 = aScale[i + 1];
+    aOutput[i] = real1 * real2 - imag1 * imag2;
+    aOutput[i + 1] = real1 * imag2 + imag1 * real2;
+  }
+}
 }  // namespace mozilla
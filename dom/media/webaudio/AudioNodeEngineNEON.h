@@ -37,6 +37,9 @@ void AudioBlockPanStereoToStereo_NEON(
     const float aGainR[WEBAUDIO_BLOCK_SIZE],
     const bool aIsOnTheLeft[WEBAUDIO_BLOCK_SIZE],
     float aOutputL[WEBAUDIO_BLOCK_SIZE], float aOutputR[WEBAUDIO_BLOCK_SIZE]);
+
+void BufferComplexMultiply_NEON(const float* aInput, const float* aScale,
+                                float* aOutput, uint32_t aSize);
 }  // namespace mozilla
 
 #endif /* MOZILLA_AUDIONODEENGINENEON_H_ */
@@ -361,6 +361,10 @@ void LoadJSGCMemoryOptions(const char* aPrefName, void* /* aClosure */) {
       PREF("gc_min_empty_chunk_count", JSGC_MIN_EMPTY_CHUNK_COUNT),
       PREF("gc_max_empty_chunk_count", JSGC_MAX_EMPTY_CHUNK_COUNT),
       PREF("gc_compacting", JSGC_COMPACTING_ENABLED),
+      PREF("gc_compacting_fragmentation_threshold",
+           JSGC_COMPACTING_FRAGMENTATION_THRESHOLD),
+      PREF("gc_parallel_minor", JSGC_PARALLEL_MINOR_GC_ENABLED),
+      PREF("gc_background_marking", JSGC_BACKGROUND_MARKING_ENABLED),
   };
 #undef PREF
 
@@ -408,7 +412,9 @@ void LoadJSGCMemoryOptions(const char* aPrefName, void* /* aClosure */) {
         UpdateOtherJSGCMemoryOption(rts, pref->key, value);
         break;
       }
-      case JSGC_COMPACTING_ENABLED: {
+      case JSGC_COMPACTING_ENABLED:
+      case JSGC_PARALLEL_MINOR_GC_ENABLED:
+      case JSGC_BACKGROUND_MARKING_ENABLED: {
         bool present;
         bool prefValue = GetPref(pref->fullName, false, &present);
         Maybe<uint32_t> value = present ? Some(prefValue ? 1 : 0) : Nothing();
@@ -428,6 +434,7 @@ void LoadJSGCMemoryOptions(const char* aPrefName, void* /* aClosure */) {
       case JSGC_URGENT_THRESHOLD_MB:
       case JSGC_MIN_EMPTY_CHUNK_COUNT:
       case JSGC_MAX_EMPTY_CHUNK_COUNT:
+      case JSGC_COMPACTING_FRAGMENTATION_THRESHOLD:
         UpdateCommonJSGCMemoryOption(rts, pref->fullName, pref->key);
         break;
       default:
@@ -7,12 +7,15 @@
 #include "DisplayItemCache.h"
 #include "nsDisplayList.h"
 
+#include <algorithm>
+
 namespace mozilla {
 namespace layers {
 
 DisplayItemCache::DisplayItemCache()
     : mDisplayList(nullptr),
       mMaximumSize(0),
+      mOccupiedSlotsEnd(0),
       mPipelineId{},
       mCaching(false),
       mInvalid(false),
@@ -82,11 +85,15 @@ void DisplayItemCache::UpdateState() {
 }
 
 void DisplayItemCache::Clear() {
-  memset(mSlots.Elements(), 0, mSlots.Length() * sizeof(Slot));
+  const size_t occupiedSlotsEnd = std::min(mOccupiedSlotsEnd, CurrentSize());
+  memset(mSlots.Elements(), 0, occupiedSlotsEnd * sizeof(Slot));
+  mOccupiedSlotsEnd = 0;
   mFreeSlots.ClearAndRetainStorage();
 
-  for (size_t i = 0; i < CurrentSize(); ++i) {
-    mFreeSlots.AppendElement(i);
+  // Free slots are handed out from the back, so push them in reverse order to
+  // keep occupied slots packed at the start of |mSlots|.
+  for (size_t i = CurrentSize(); i > 0; --i) {
+    mFreeSlots.AppendElement(i - 1);
   }
 }
 
@@ -114,7 +121,10 @@ bool DisplayItemCache::GrowIfPossible() {
 }
 
 void DisplayItemCache::FreeUnusedSlots() {
-  for (size_t i = 0; i < CurrentSize(); ++i) {
+  // Slots past |mOccupiedSlotsEnd| have not been occupied since the last
+  // Clear(), so there is nothing to free there.
+  size_t occupiedSlotsEnd = 0;
+  for (size_t i = 0; i < mOccupiedSlotsEnd; ++i) {
     auto& slot = mSlots[i];
 
     if (!slot.mUsed && slot.mOccupied) {
@@ -123,15 +133,22 @@ void DisplayItemCache::FreeUnusedSlots() {
       mFreeSlots.AppendElement(i);
     }
 
+    if (slot.mOccupied) {
+      occupiedSlotsEnd = i + 1;
+    }
+
     slot.mUsed = false;
   }
+  mOccupiedSlotsEnd = occupiedSlotsEnd;
 }
 
 void DisplayItemCache::SetCapacity(const size_t aInitialSize,
                                    const size_t aMaximumSize) {
   mMaximumSize = aMaximumSize;
   mSlots.SetLength(aInitialSize);
-  mFreeSlots.SetCapacity(aMaximumSize);
+  // The free list grows along with |mSlots| in GrowIfPossible(), so don't
+  // reserve storage for the maximum size up front.
+  mFreeSlots.SetCapacity(aInitialSize);
   Clear();
 }
 
@@ -163,6 +180,7 @@ void DisplayItemCache::MarkSlotOccupied(
   MOZ_ASSERT(!slot.mUsed);
   slot.mUsed = true;
   slot.mSpaceAndClip = aSpaceAndClip;
+  mOccupiedSlotsEnd = std::max<size_t>(mOccupiedSlotsEnd, aSlotIndex + 1);
 }
 
 Maybe<uint16_t> DisplayItemCache::CanReuseItem(
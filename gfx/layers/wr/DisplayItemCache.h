@@ -173,6 +173,8 @@ class DisplayItemCache final {
   nsDisplayList* mDisplayList;
 
   size_t mMaximumSize;
+  // One past the highest slot index that may be occupied.
+  size_t mOccupiedSlotsEnd;
   nsTArray<Slot> mSlots;
   nsTArray<uint16_t> mFreeSlots;
 
@@ -51,7 +51,12 @@ WebRenderLayerManager::WebRenderLayerManager(nsIWidget* aWidget)
   if (XRE_IsContentProcess() &&
       StaticPrefs::gfx_webrender_enable_item_cache_AtStartup()) {
     static const size_t kInitialCacheSize = 1024;
-    static const size_t kMaximumCacheSize = 10240;
+    // Cache slots are indexed by uint16_t. The cache starts at
+    // kInitialCacheSize and only grows when it runs out of free slots, so a
+    // large cap only costs memory on pages that have that many cacheable
+    // items at once, which are the pages that benefit most from not
+    // re-sending them.
+    static const size_t kMaximumCacheSize = UINT16_MAX;
 
     mDisplayItemCache.SetCapacity(kInitialCacheSize, kMaximumCacheSize);
   }
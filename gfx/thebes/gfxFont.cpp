@@ -2868,6 +2868,25 @@ bool gfxFont::AgeCachedWords() {
   return true;
 }
 
+void gfxFont::TrimCachedWordsLocked(uint32_t aMaxEntries) {
+  MOZ_ASSERT(mWordCache);
+  // Words that are still on screen are re-used on every reflow, so dropping
+  // only the ones that have aged avoids reshaping the whole document when a
+  // large page fills up the cache.
+  for (auto it = mWordCache->Iter(); !it.Done(); it.Next()) {
+    CacheHashEntry* entry = it.Get();
+    if (!entry->mShapedWord || entry->mShapedWord->Age() > 0) {
+      it.Remove();
+    }
+  }
+  // If that didn't free a good part of the cache, flush it, so that we don't
+  // end up scanning the whole table again for every new word.
+  if (mWordCache->Count() > aMaxEntries / 4 * 3) {
+    NS_WARNING("flushing shaped-word cache");
+    ClearCachedWordsLocked();
+  }
+}
+
 void gfxFont::NotifyGlyphsChanged() const {
   AutoReadLock lock(mLock);
   uint32_t i, count = mGlyphExtentsArray.Length();
@@ -2950,9 +2969,7 @@ gfxShapedWord* gfxFont::GetShapedWord(
       uint32_t wordCacheMaxEntries =
           gfxPlatform::GetPlatform()->WordCacheMaxEntries();
       if (mWordCache->Count() > wordCacheMaxEntries) {
-        // Flush the cache if it is getting overly big.
-        NS_WARNING("flushing shaped-word cache");
-        ClearCachedWordsLocked();
+        TrimCachedWordsLocked(wordCacheMaxEntries);
       }
     }
     CacheHashEntry* entry = mWordCache->PutEntry(key, fallible);
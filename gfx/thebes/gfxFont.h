@@ -1347,6 +1347,7 @@ class gfxShapedWord final : public gfxShapedText {
   gfxFontShaper::RoundingFlags GetRounding() const { return mRounding; }
 
   void ResetAge() { mAgeCounter = 0; }
+  uint32_t Age() const { return mAgeCounter; }
   uint32_t IncrementAge() { return ++mAgeCounter; }
 
   // Helper used when hashing a word for the shaped-word caches
@@ -1862,6 +1863,10 @@ class gfxFont {
     mWordCache->Clear();
   }
 
+  // Make room in a full word cache, preferring to keep words that have been
+  // used since the last expiration timer tick.
+  void TrimCachedWordsLocked(uint32_t aMaxEntries) REQUIRES(mLock);
+
   // Glyph rendering/geometry has changed, so invalidate data as necessary.
   void NotifyGlyphsChanged() const;
 
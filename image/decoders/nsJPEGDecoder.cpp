@@ -24,6 +24,7 @@
 #include "gfxPlatform.h"
 #include "mozilla/EndianUtils.h"
 #include "mozilla/gfx/Types.h"
+#include "mozilla/StaticPrefs_image.h"
 #include "mozilla/Telemetry.h"
 
 extern "C" {
@@ -80,6 +81,7 @@ nsJPEGDecoder::nsJPEGDecoder(RasterImage* aImage,
       mProfile(nullptr),
       mProfileLength(0),
       mCMSLine(nullptr),
+      mScaleDenom(1),
       mDecodeStyle(aDecodeStyle) {
   this->mErr.pub.error_exit = nullptr;
   this->mErr.pub.emit_message = nullptr;
@@ -350,6 +352,12 @@ LexerTransition<nsJPEGDecoder::State> nsJPEGDecoder::ReadJPEGData(
       mInfo.buffered_image =
           mDecodeStyle == PROGRESSIVE && jpeg_has_multiple_scans(&mInfo);
 
+      // If we're downscaling by at least a factor of two, have libjpeg skip
+      // most of that work with a reduced-size IDCT.
+      mScaleDenom = ChooseScaleDenom();
+      mInfo.scale_num = 1;
+      mInfo.scale_denom = mScaleDenom;
+
       /* Used to set up image size so arrays can be allocated */
       jpeg_calc_output_dimensions(&mInfo);
 
@@ -360,8 +368,12 @@ LexerTransition<nsJPEGDecoder::State> nsJPEGDecoder::ReadJPEGData(
       qcms_transform* pipeTransform =
           mInfo.out_color_space != JCS_GRAYSCALE ? mTransform : nullptr;
 
+      OrientedIntSize inputSize = GetOrientation().ToOriented(
+          UnorientedIntSize(mInfo.output_width, mInfo.output_height));
+      MOZ_ASSERT_IF(mScaleDenom == 1, inputSize == Size());
+
       Maybe<SurfacePipe> pipe = SurfacePipeFactory::CreateReorientSurfacePipe(
-          this, Size(), OutputSize(), SurfaceFormat::OS_RGBX, pipeTransform,
+          this, inputSize, OutputSize(), SurfaceFormat::OS_RGBX, pipeTransform,
           GetOrientation());
       if (!pipe) {
         mState = JPEG_ERROR;
@@ -661,13 +673,40 @@ WriteState nsJPEGDecoder::OutputScanlines() {
 
   Maybe<SurfaceInvalidRect> invalidRect = mPipe.TakeInvalidRect();
   if (invalidRect) {
-    PostInvalidation(invalidRect->mInputSpaceRect,
-                     Some(invalidRect->mOutputSpaceRect));
+    // The pipe's input space is the IDCT-scaled image, but invalidations are
+    // expected in terms of the full image size.
+    OrientedIntRect inputRect = invalidRect->mInputSpaceRect;
+    if (mScaleDenom > 1) {
+      const int32_t denom = int32_t(mScaleDenom);
+      inputRect = OrientedIntRect(inputRect.x * denom, inputRect.y * denom,
+                                  inputRect.width * denom,
+                                  inputRect.height * denom)
+                      .Intersect(FullFrame());
+    }
+    PostInvalidation(inputRect, Some(invalidRect->mOutputSpaceRect));
   }
 
   return result;
 }
 
+uint32_t nsJPEGDecoder::ChooseScaleDenom() const {
+  if (!StaticPrefs::image_downscale_during_decode_jpeg_dct_scaling()) {
+    return 1;
+  }
+
+  UnorientedIntSize target = GetOrientation().ToUnoriented(OutputSize());
+  for (uint32_t denom : {8u, 4u, 2u}) {
+    // libjpeg rounds scaled dimensions up, and we must never end up below the
+    // output size, since the SurfacePipe can only downscale.
+    uint32_t width = (mInfo.image_width + denom - 1) / denom;
+    uint32_t height = (mInfo.image_height + denom - 1) / denom;
+    if (width >= uint32_t(target.width) && height >= uint32_t(target.height)) {
+      return denom;
+    }
+  }
+  return 1;
+}
+
 // Override the standard error method in the IJG JPEG decoder code.
 METHODDEF(void)
 my_error_exit(j_common_ptr cinfo) {
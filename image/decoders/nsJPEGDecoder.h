@@ -64,6 +64,7 @@ class nsJPEGDecoder : public Decoder {
  protected:
   EXIFData ReadExifData() const;
   WriteState OutputScanlines();
+  uint32_t ChooseScaleDenom() const;
 
  private:
   friend class DecoderFactory;
@@ -100,6 +101,10 @@ class nsJPEGDecoder : public Decoder {
 
   uint32_t* mCMSLine;
 
+  // The IDCT scaling denominator we asked libjpeg for (1, 2, 4 or 8). Rows
+  // coming out of libjpeg are this many times smaller than Size().
+  uint32_t mScaleDenom;
+
   bool mReading;
 
   const Decoder::DecodeStyle mDecodeStyle;
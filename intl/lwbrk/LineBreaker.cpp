@@ -1114,6 +1114,12 @@ void LineBreaker::ComputeBreakPositions(const uint8_t* aChars, uint32_t aLength,
   int8_t lastClass = CLASS_NONE;
   ContextState state(aChars, aLength);
 
+  // GetClass() only depends on the character and on aLevel and
+  // aIsChineseOrJapanese, which are fixed for this call, so for 8-bit text
+  // each distinct byte needs to be classified at most once.
+  int8_t classCache[256];
+  memset(classCache, CLASS_NONE, sizeof(classCache));
+
   for (cur = 0; cur < aLength; ++cur, state.AdvanceIndex()) {
     char32_t ch = aChars[cur];
     int8_t cl;
@@ -1125,7 +1131,10 @@ void LineBreaker::ComputeBreakPositions(const uint8_t* aChars, uint32_t aLength,
     } else {
       if (ch == U_EQUAL) state.NotifySeenEqualsSign();
       state.NotifyNonHyphenCharacter(ch);
-      cl = GetClass(ch, aLevel, aIsChineseOrJapanese);
+      cl = classCache[ch];
+      if (cl == CLASS_NONE) {
+        cl = classCache[ch] = GetClass(ch, aLevel, aIsChineseOrJapanese);
+      }
     }
     if (aWordBreak == WordBreakRule::BreakAll &&
         (cl == CLASS_CHARACTER || cl == CLASS_CLOSE ||
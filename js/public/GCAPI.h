@@ -441,6 +441,36 @@ typedef enum JSGCParamKey {
    * incremental limit.
    */
   JSGC_URGENT_THRESHOLD_MB = 48,
+
+  /**
+   * Whether minor GCs may use helper threads for work that is independent
+   * between zones, such as sweeping wrapper and inner view tables after
+   * tenuring.
+   *
+   * Default: ParallelMinorGCEnabled
+   * Pref: javascript.options.mem.gc_parallel_minor
+   */
+  JSGC_PARALLEL_MINOR_GC_ENABLED = 49,
+
+  /**
+   * Whether marking work generated by barriers during incremental sweeping
+   * may be done on a helper thread, overlapping with the main thread's
+   * sweeping work for the current slice.
+   *
+   * Default: BackgroundMarkingEnabled
+   * Pref: javascript.options.mem.gc_background_marking
+   */
+  JSGC_BACKGROUND_MARKING_ENABLED = 50,
+
+  /**
+   * If non-zero, non-shrinking GCs will also compact zones where at least this
+   * percentage of the zone's arenas could be freed by moving cells into free
+   * space in other arenas. Zero means only shrinking GCs compact.
+   *
+   * Default: CompactingFragmentationThreshold
+   * Pref: javascript.options.mem.gc_compacting_fragmentation_threshold
+   */
+  JSGC_COMPACTING_FRAGMENTATION_THRESHOLD = 51,
 } JSGCParamKey;
 
 /*
@@ -10,6 +10,7 @@
 #ifndef js_JSON_h
 #define js_JSON_h
 
+#include <stddef.h>  // size_t
 #include <stdint.h>  // uint32_t
 
 #include "jstypes.h"  // JS_PUBLIC_API
@@ -87,4 +88,28 @@ extern JS_PUBLIC_API bool JS_ParseJSONWithReviver(
     JSContext* cx, JS::Handle<JSString*> str, JS::Handle<JS::Value> reviver,
     JS::MutableHandle<JS::Value> vp);
 
+namespace JS {
+
+/**
+ * Performs the JSON.parse operation on a helper thread, for large inputs that
+ * would otherwise block the main thread.  The characters are copied, and a
+ * promise is returned that will be resolved with the parsed value, or rejected
+ * with the error JSON.parse would have thrown.  The parsed value itself is
+ * created on the main thread when the promise is resolved.
+ *
+ * This requires the embedding to support off-thread promises, see
+ * JS::InitDispatchToEventLoop.  Returns nullptr on failure.
+ */
+extern JS_PUBLIC_API JSObject* ParseJSONOffThread(JSContext* cx,
+                                                  const char16_t* chars,
+                                                  size_t len);
+
+/**
+ * As above, for the contents of |str|.
+ */
+extern JS_PUBLIC_API JSObject* ParseJSONOffThread(JSContext* cx,
+                                                  JS::Handle<JSString*> str);
+
+} /* namespace JS */
+
 #endif /* js_JSON_h */
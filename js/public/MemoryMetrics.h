@@ -501,6 +501,7 @@ struct RuntimeSizes {
   MACRO(_, MallocHeap, interpreterStack)            \
   MACRO(_, MallocHeap, sharedImmutableStringsCache) \
   MACRO(_, MallocHeap, sharedIntlData)              \
+  MACRO(_, MallocHeap, regExpBytecodeCache)         \
   MACRO(_, MallocHeap, uncompressedSourceCache)     \
   MACRO(_, MallocHeap, scriptData)                  \
   MACRO(_, MallocHeap, wasmRuntime)                 \
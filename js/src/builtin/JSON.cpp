@@ -18,7 +18,9 @@
 
 #include "builtin/Array.h"
 #include "builtin/BigInt.h"
+#include "builtin/Promise.h"  // js::RejectPromiseWithPendingError
 #include "js/CallAndConstruct.h"      // JS::IsCallable
+#include "js/ErrorReport.h"           // JS_ReportErrorASCII
 #include "js/friend/ErrorMessages.h"  // js::GetErrorMessage, JSMSG_*
 #include "js/friend/StackLimits.h"    // js::AutoCheckRecursionLimit
 #include "js/Object.h"                // JS::GetBuiltinClass
@@ -27,6 +29,8 @@
 #include "js/TypeDecls.h"
 #include "js/Value.h"
 #include "util/StringBuffer.h"
+#include "vm/HelperThreadState.h"  // js::PromiseHelperTask
+#include "vm/HelperThreads.h"      // js::StartOffThreadPromiseHelperTask
 #include "vm/Interpreter.h"
 #include "vm/JSAtom.h"
 #include "vm/JSContext.h"
@@ -34,6 +38,7 @@
 #include "vm/JSONParser.h"
 #include "vm/NativeObject.h"
 #include "vm/PlainObject.h"    // js::PlainObject
+#include "vm/PromiseObject.h"  // js::PromiseObject
 #include "vm/WellKnownAtom.h"  // js_*_str
 #ifdef ENABLE_RECORD_TUPLE
 #  include "builtin/RecordObject.h"
@@ -309,13 +314,21 @@ static bool PreprocessValue(JSContext* cx, HandleObject holder, KeyType key,
   // primitive value as receiver.
   if (vp.isObject() || vp.isBigInt()) {
     RootedValue toJSON(cx);
-    RootedObject obj(cx, JS::ToObject(cx, vp));
-    if (!obj) {
-      return false;
-    }
 
-    if (!GetProperty(cx, obj, vp, cx->names().toJSON, &toJSON)) {
-      return false;
+    // Most objects have no toJSON method anywhere on their prototype chain.
+    // Look it up without side effects first, so we don't need the generic
+    // property lookup for them.
+    if (!vp.isObject() ||
+        !GetPropertyPure(cx, &vp.toObject(), NameToId(cx->names().toJSON),
+                         toJSON.address())) {
+      RootedObject obj(cx, JS::ToObject(cx, vp));
+      if (!obj) {
+        return false;
+      }
+
+      if (!GetProperty(cx, obj, vp, cx->names().toJSON, &toJSON)) {
+        return false;
+      }
     }
 
     if (IsCallable(toJSON)) {
@@ -425,6 +438,47 @@ class CycleDetector {
   bool appended_;
 };
 
+// Get the keys of a plain object's own enumerable string-keyed properties in
+// the order GetPropertyKeys would return them, along with the slots holding
+// their values. This only works if the object's shape tells us everything: it
+// must have no elements or integer keys, and all of the properties must be
+// data properties. Otherwise leave |ids| empty and set |*optimized| to false.
+static bool GetPlainObjectDataPropertyKeys(JSContext* cx, PlainObject* obj,
+                                           MutableHandleIdVector ids,
+                                           Vector<uint32_t, 8>& slots,
+                                           bool* optimized) {
+  MOZ_ASSERT(ids.empty());
+  MOZ_ASSERT(slots.empty());
+
+  *optimized = false;
+  if (obj->getDenseInitializedLength() != 0 || obj->isIndexed()) {
+    return true;
+  }
+
+  for (ShapePropertyIter<NoGC> iter(obj->shape()); !iter.done(); iter++) {
+    PropertyKey key = iter->key();
+    if (key.isSymbol() || !iter->enumerable()) {
+      continue;
+    }
+    MOZ_ASSERT(key.isAtom());
+    if (!iter->isDataProperty() || key.toAtom()->isIndex()) {
+      ids.clear();
+      slots.clear();
+      return true;
+    }
+    if (!ids.append(key) || !slots.append(iter->slot())) {
+      return false;
+    }
+  }
+
+  // The shape lists properties from most to least recently added.
+  std::reverse(ids.begin(), ids.end());
+  std::reverse(slots.begin(), slots.end());
+
+  *optimized = true;
+  return true;
+}
+
 #ifdef ENABLE_RECORD_TUPLE
 enum class JOType { Record, Object };
 template <JOType type = JOType::Object>
@@ -466,6 +520,12 @@ static bool JO(JSContext* cx, HandleObject obj, StringifyContext* scx) {
   /* Steps 5-7. */
   Maybe<RootedIdVector> ids;
   const RootedIdVector* props;
+
+  // For plain objects we may know which slot holds each property's value. We
+  // can read it directly as long as the object's shape doesn't change, which
+  // could happen if a toJSON method or the replacer modifies the object.
+  Vector<uint32_t, 8> slots(cx);
+  Rooted<Shape*> slotsShape(cx);
   if (scx->replacer && !scx->replacer->isCallable()) {
     // NOTE: We can't assert |IsArray(scx->replacer)| because the replacer
     //       might have been a revocable proxy to an array.  Such a proxy
@@ -476,7 +536,18 @@ static bool JO(JSContext* cx, HandleObject obj, StringifyContext* scx) {
   } else {
     MOZ_ASSERT_IF(scx->replacer, scx->propertyList.length() == 0);
     ids.emplace(cx);
-    if (!GetPropertyKeys(cx, obj, JSITER_OWNONLY, ids.ptr())) {
+    bool optimized = false;
+    if (obj->is<PlainObject>()) {
+      if (!GetPlainObjectDataPropertyKeys(cx, &obj->as<PlainObject>(),
+                                          ids.ptr(), slots, &optimized)) {
+        return false;
+      }
+      if (optimized) {
+        slotsShape = obj->shape();
+      }
+    }
+    if (!optimized &&
+        !GetPropertyKeys(cx, obj, JSITER_OWNONLY, ids.ptr())) {
       return false;
     }
     props = ids.ptr();
@@ -520,9 +591,13 @@ static bool JO(JSContext* cx, HandleObject obj, StringifyContext* scx) {
     } else
 #endif
     {
-      RootedValue objValue(cx, ObjectValue(*obj));
-      if (!GetProperty(cx, obj, objValue, id, &outputValue)) {
-        return false;
+      if (slotsShape && obj->shape() == slotsShape) {
+        outputValue = obj->as<PlainObject>().getSlot(slots[i]);
+      } else {
+        RootedValue objValue(cx, ObjectValue(*obj));
+        if (!GetProperty(cx, obj, objValue, id, &outputValue)) {
+          return false;
+        }
       }
     }
     if (!PreprocessValue(cx, obj, HandleId(id), &outputValue, scx)) {
@@ -669,7 +744,12 @@ static bool JA(JSContext* cx, HandleObject obj, StringifyContext* scx) {
         }
       }
 #endif
-      if (!GetElement(cx, obj, i, &outputValue)) {
+      // Read dense elements directly. A toJSON method or the replacer can
+      // modify the array, so this must be checked for every element.
+      if (MOZ_LIKELY(obj->is<ArrayObject>()) &&
+          obj->as<ArrayObject>().containsDenseElement(i)) {
+        outputValue = obj->as<ArrayObject>().getDenseElement(i);
+      } else if (!GetElement(cx, obj, i, &outputValue)) {
         return false;
       }
       if (!PreprocessValue(cx, obj, i, &outputValue, scx)) {
@@ -1136,6 +1216,102 @@ template bool js::ParseJSONWithReviver(
     JSContext* cx, const mozilla::Range<const char16_t> chars,
     HandleValue reviver, MutableHandleValue vp);
 
+namespace {
+
+// Checks and tokenizes JSON text on a helper thread, then creates the parsed
+// value on the main thread. See JSONTape.
+template <typename CharT>
+class ParseJSONTask : public PromiseHelperTask {
+  UniquePtr<CharT[], JS::FreePolicy> chars;
+  size_t length;
+  JSONTape<CharT> tape;
+  typename JSONTape<CharT>::Result result;
+
+  mozilla::Range<const CharT> range() const {
+    return mozilla::Range<const CharT>(chars.get(), length);
+  }
+
+ public:
+  ParseJSONTask(JSContext* cx, Handle<PromiseObject*> promise,
+                UniquePtr<CharT[], JS::FreePolicy> chars, size_t length)
+      : PromiseHelperTask(cx, promise),
+        chars(std::move(chars)),
+        length(length),
+        tape(range()),
+        result(JSONTape<CharT>::Result::OOM) {}
+
+  void execute() override { result = tape.build(); }
+
+  bool resolve(JSContext* cx, Handle<PromiseObject*> promise) override {
+    RootedValue value(cx);
+    bool ok;
+    switch (result) {
+      case JSONTape<CharT>::Result::Ok:
+        ok = tape.materialize(cx, &value);
+        break;
+      case JSONTape<CharT>::Result::SyntaxError:
+        // The tape doesn't record where the error is, so parse again to
+        // report it.
+        ok = ParseJSON(cx, range(), &value);
+        MOZ_ASSERT(!ok);
+        break;
+      case JSONTape<CharT>::Result::OOM:
+        ReportOutOfMemory(cx);
+        ok = false;
+        break;
+    }
+
+    if (!ok) {
+      return RejectPromiseWithPendingError(cx, promise);
+    }
+    return PromiseObject::resolve(cx, promise, value);
+  }
+};
+
+}  // namespace
+
+template <typename CharT>
+PromiseObject* js::ParseJSONOffThread(JSContext* cx,
+                                      const mozilla::Range<const CharT> chars) {
+  if (!cx->runtime()->offThreadPromiseState.ref().initialized()) {
+    JS_ReportErrorASCII(
+        cx, "Off-thread JSON parsing not supported in this runtime.");
+    return nullptr;
+  }
+
+  Rooted<PromiseObject*> promise(cx, PromiseObject::createSkippingExecutor(cx));
+  if (!promise) {
+    return nullptr;
+  }
+
+  // Allocate at least one character so empty input is not mistaken for OOM.
+  size_t length = chars.length();
+  UniquePtr<CharT[], JS::FreePolicy> copy(
+      cx->pod_malloc<CharT>(std::max(length, size_t(1))));
+  if (!copy) {
+    return nullptr;
+  }
+  std::copy(chars.begin().get(), chars.end().get(), copy.get());
+
+  auto task = cx->make_unique<ParseJSONTask<CharT>>(cx, promise,
+                                                    std::move(copy), length);
+  if (!task || !task->init(cx)) {
+    return nullptr;
+  }
+
+  if (!StartOffThreadPromiseHelperTask(cx, std::move(task))) {
+    return nullptr;
+  }
+
+  return promise;
+}
+
+template PromiseObject* js::ParseJSONOffThread(
+    JSContext* cx, const mozilla::Range<const Latin1Char> chars);
+
+template PromiseObject* js::ParseJSONOffThread(
+    JSContext* cx, const mozilla::Range<const char16_t> chars);
+
 static bool json_toSource(JSContext* cx, unsigned argc, Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
   args.rval().setString(cx->names().JSON);
@@ -15,6 +15,7 @@
 
 namespace js {
 
+class PromiseObject;
 class StringBuffer;
 
 extern const JSClass JSONClass;
@@ -35,6 +36,16 @@ extern bool ParseJSONWithReviver(JSContext* cx,
                                  const mozilla::Range<const CharT> chars,
                                  HandleValue reviver, MutableHandleValue vp);
 
+/**
+ * Parse |chars| as JSON on a helper thread and return a promise for the
+ * result. The promise is resolved on the main thread with the parsed value, or
+ * rejected with the error JSON.parse would throw. |chars| is copied. Requires
+ * off-thread promise support in the runtime.
+ */
+template <typename CharT>
+extern PromiseObject* ParseJSONOffThread(
+    JSContext* cx, const mozilla::Range<const CharT> chars);
+
 }  // namespace js
 
 #endif /* builtin_JSON_h */
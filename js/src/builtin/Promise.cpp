@@ -1378,6 +1378,8 @@ static bool ResolvePromiseFunction(JSContext* cx, unsigned argc, Value* vp) {
 }
 
 static bool PromiseReactionJob(JSContext* cx, unsigned argc, Value* vp);
+[[nodiscard]] static bool RunPromiseReactionJob(
+    JSContext* cx, Handle<PromiseReactionRecord*> reaction);
 
 /**
  * ES2022 draft rev d03c1ec6e235a5180fa772b6178727c17974cb14
@@ -1446,6 +1448,18 @@ static bool PromiseReactionJob(JSContext* cx, unsigned argc, Value* vp);
   RootedValue reactionVal(cx, ObjectValue(*reaction));
   RootedValue handler(cx, reaction->handler());
 
+  // The runtime's own job queue can run a reaction record directly, without
+  // the job function created below. Do that when there's no handler object,
+  // which covers await in async functions and generators and the default
+  // resolving handlers: the job then runs in the reaction's realm, just as the
+  // job function would. See InternalJobQueue::runJobs.
+  if (!handler.isObject() && cx->internalJobQueue.ref() &&
+      cx->jobQueue == cx->internalJobQueue.ref().get()) {
+    RootedObject job(cx, reaction);
+    return cx->internalJobQueue->enqueuePromiseJob(cx, nullptr, job, nullptr,
+                                                   nullptr);
+  }
+
   // NewPromiseReactionJob
   // Step 2. Let handlerRealm be null.
   // NOTE: Instead of passing job and realm separately, we use the job's
@@ -2165,9 +2179,26 @@ static bool PromiseReactionJob(JSContext* cx, unsigned argc, Value* vp) {
     ar.emplace(cx, reactionObj);
   }
 
+  return RunPromiseReactionJob(cx, reactionObj.as<PromiseReactionRecord>());
+}
+
+bool js::IsPromiseReactionRecord(JSObject* obj) {
+  return obj->is<PromiseReactionRecord>();
+}
+
+bool js::RunPromiseReactionRecordJob(JSContext* cx, HandleObject job) {
+  MOZ_ASSERT(job->is<PromiseReactionRecord>());
+  MOZ_ASSERT(cx->realm() == job->nonCCWRealm());
+  return RunPromiseReactionJob(cx, job.as<PromiseReactionRecord>());
+}
+
+/**
+ * The steps of PromiseReactionJob, for a reaction record in the current
+ * compartment.
+ */
+[[nodiscard]] static bool RunPromiseReactionJob(
+    JSContext* cx, Handle<PromiseReactionRecord*> reaction) {
   // Optimized/special cases.
-  Handle<PromiseReactionRecord*> reaction =
-      reactionObj.as<PromiseReactionRecord>();
   if (reaction->isDefaultResolvingHandler()) {
     return DefaultResolvingPromiseReactionJob(cx, reaction);
   }
@@ -5433,6 +5464,32 @@ template <typename T>
                                         PromiseHandler onFulfilled,
                                         PromiseHandler onRejected,
                                         T extraStep) {
+  // Steps 3-6 for creating onFulfilled/onRejected are done by caller.
+
+  // The reaction record for step 7 is created first, which isn't observable,
+  // so it can be shared with the fast path below.
+  RootedValue onFulfilledValue(cx, Int32Value(int32_t(onFulfilled)));
+  RootedValue onRejectedValue(cx, Int32Value(int32_t(onRejected)));
+  Rooted<PromiseCapability> resultCapability(cx);
+  resultCapability.promise().set(resultPromise);
+  Rooted<PromiseReactionRecord*> reaction(
+      cx, NewReactionRecord(cx, resultCapability, onFulfilledValue,
+                            onRejectedValue, IncumbentGlobalObject::Yes));
+  if (!reaction) {
+    return false;
+  }
+  extraStep(reaction);
+
+  // Fast path for primitive values: PromiseResolve creates a new promise
+  // that's immediately fulfilled with the value, and PerformPromiseThen then
+  // enqueues the reaction job right away. Only a debugger can observe that
+  // promise, so otherwise skip allocating it and enqueue the job directly.
+  // The job is enqueued at the same point, so the tick ordering is unchanged.
+  if (!value.isObject() && !cx->realm()->isDebuggee()) {
+    return EnqueuePromiseReactionJob(cx, reaction, value,
+                                     JS::PromiseState::Fulfilled);
+  }
+
   // Step 2. Let promise be ? PromiseResolve(%Promise%, value).
   RootedObject promise(cx, PromiseObject::unforgeableResolve(cx, value));
   if (!promise) {
@@ -5448,20 +5505,7 @@ template <typename T>
     return false;
   }
 
-  // Steps 3-6 for creating onFulfilled/onRejected are done by caller.
-
   // Step 7. Perform ! PerformPromiseThen(promise, onFulfilled, onRejected).
-  RootedValue onFulfilledValue(cx, Int32Value(int32_t(onFulfilled)));
-  RootedValue onRejectedValue(cx, Int32Value(int32_t(onRejected)));
-  Rooted<PromiseCapability> resultCapability(cx);
-  resultCapability.promise().set(resultPromise);
-  Rooted<PromiseReactionRecord*> reaction(
-      cx, NewReactionRecord(cx, resultCapability, onFulfilledValue,
-                            onRejectedValue, IncumbentGlobalObject::Yes));
-  if (!reaction) {
-    return false;
-  }
-  extraStep(reaction);
   return PerformPromiseThenWithReaction(cx, unwrappedPromise, reaction);
 }
 
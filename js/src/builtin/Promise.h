@@ -162,6 +162,19 @@ enum class UnhandledRejectionBehavior { Ignore, Report };
  */
 [[nodiscard]] PromiseObject* CreatePromiseObjectForAsync(JSContext* cx);
 
+/**
+ * Promise reaction jobs without a handler object are enqueued on the internal
+ * job queue as just their reaction record, instead of as a job function.
+ * Returns true if |obj| is such a job.
+ */
+[[nodiscard]] bool IsPromiseReactionRecord(JSObject* obj);
+
+/**
+ * Run a job for which IsPromiseReactionRecord returned true, in its realm.
+ */
+[[nodiscard]] bool RunPromiseReactionRecordJob(JSContext* cx,
+                                               JS::Handle<JSObject*> job);
+
 /**
  * Returns true if the given object is a promise created by
  * either CreatePromiseObjectForAsync function or async generator's method.
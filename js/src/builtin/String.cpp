@@ -2147,6 +2147,16 @@ bool js::str_includes(JSContext* cx, unsigned argc, Value* vp) {
   // Step 8.
   uint32_t start = std::min(pos, textLen);
 
+  // Search the leaves of a rope without flattening it.
+  if (str->isRope() && start == 0) {
+    int match;
+    if (!RopeMatch(cx, &str->asRope(), searchStr, &match)) {
+      return false;
+    }
+    args.rval().setBoolean(match != -1);
+    return true;
+  }
+
   // Steps 9-10.
   JSLinearString* text = str->ensureLinear(cx);
   if (!text) {
@@ -2202,6 +2212,16 @@ bool js::str_indexOf(JSContext* cx, unsigned argc, Value* vp) {
     return true;
   }
 
+  // Search the leaves of a rope without flattening it.
+  if (str->isRope() && start == 0) {
+    int match;
+    if (!RopeMatch(cx, &str->asRope(), searchStr, &match)) {
+      return false;
+    }
+    args.rval().setInt32(match);
+    return true;
+  }
+
   // Steps 10 and 11
   JSLinearString* text = str->ensureLinear(cx);
   if (!text) {
@@ -2394,13 +2414,16 @@ bool js::str_startsWith(JSContext* cx, unsigned argc, Value* vp) {
     return true;
   }
 
-  // Steps 11-12.
-  JSLinearString* text = str->ensureLinear(cx);
+  // Steps 11-12. Only flatten the part of a rope which holds the characters
+  // to compare.
+  size_t offset = start;
+  JSLinearString* text =
+      str->ropeNodeContaining(&offset, searchLen)->ensureLinear(cx);
   if (!text) {
     return false;
   }
 
-  args.rval().setBoolean(HasSubstringAt(text, searchStr, start));
+  args.rval().setBoolean(HasSubstringAt(text, searchStr, offset));
   return true;
 }
 
@@ -2460,13 +2483,16 @@ bool js::str_endsWith(JSContext* cx, unsigned argc, Value* vp) {
   // Step 10.
   uint32_t start = end - searchLen;
 
-  // Steps 12-13.
-  JSLinearString* text = str->ensureLinear(cx);
+  // Steps 12-13. Only flatten the part of a rope which holds the characters
+  // to compare.
+  size_t offset = start;
+  JSLinearString* text =
+      str->ropeNodeContaining(&offset, searchLen)->ensureLinear(cx);
   if (!text) {
     return false;
   }
 
-  args.rval().setBoolean(HasSubstringAt(text, searchStr, start));
+  args.rval().setBoolean(HasSubstringAt(text, searchStr, offset));
   return true;
 }
 
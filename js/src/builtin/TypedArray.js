@@ -312,8 +312,8 @@ function TypedArrayFill(value, start = 0, end = undefined) {
         ThrowTypeError(JSMSG_TYPED_ARRAY_DETACHED);
 
     // Step 10.
-    for (; k < final; k++) {
-        O[k] = value;
+    if (k < final) {
+        TypedArrayNativeFill(O, value, k, final);
     }
 
     // Step 11.
@@ -555,18 +555,8 @@ function TypedArrayIndexOf(searchElement, fromIndex = 0) {
             k = 0;
     }
 
-    // Step 11.
-    for (; k < len; k++) {
-        // Step 11.a (not necessary in our implementation).
-        assert(k in O, "unexpected missing element");
-
-        // Steps 11.b.i-iii.
-        if (O[k] === searchElement)
-            return k;
-    }
-
-    // Step 12.
-    return -1;
+    // Steps 11-12.
+    return TypedArrayNativeIndexOf(O, searchElement, k);
 }
 
 // ES2021 draft rev 190d474c3d8728653fbf8a5a37db1de34b9c1472
@@ -1345,6 +1335,11 @@ function TypedArrayIncludes(searchElement, fromIndex = 0) {
             k = 0;
     }
 
+    // Steps 11-12, unless ToInteger() detached the ArrayBuffer, in which case
+    // the remaining elements are read as undefined.
+    if (len === TypedArrayLength(O))
+        return TypedArrayNativeIncludes(O, searchElement, k);
+
     // Step 11.
     while (k < len) {
         // Steps 11.a-b.
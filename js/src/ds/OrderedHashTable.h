@@ -229,14 +229,22 @@ class OrderedHashTable {
     // data[dataLength - 1], decrements dataLength. LIFO use cases would
     // benefit.
 
-    // If a matching entry exists, empty it.
-    Data* e = lookup(l, prepareHash(l));
+    // If a matching entry exists, unlink it from its hash chain and empty
+    // it. Removed entries stay in |data| until the next rehash, but unlinking
+    // them keeps lookups from having to step over them in the meantime.
+    Data** ep = &hashTable[prepareHash(l) >> hashShift];
+    while (*ep && !Ops::match(Ops::getKey((*ep)->element), l)) {
+      ep = &(*ep)->chain;
+    }
+    Data* e = *ep;
     if (e == nullptr) {
       *foundp = false;
       return true;
     }
 
     *foundp = true;
+    *ep = e->chain;
+    e->chain = nullptr;
     liveCount--;
     Ops::makeEmpty(&e->element);
 
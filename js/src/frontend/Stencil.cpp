@@ -3704,6 +3704,8 @@ void ScriptStencilExtra::dumpFields(js::JSONPrinter& json) const {
   json.property("memberInitializers", memberInitializers_);
 
   json.property("nargs", nargs);
+
+  json.property("warmUpHint", warmUpHint);
 }
 
 void SharedDataContainer::dump() const {
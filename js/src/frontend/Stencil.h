@@ -964,8 +964,10 @@ class ScriptStencilExtra {
   // See `JSFunction::nargs_`.
   uint16_t nargs = 0;
 
-  // To make this struct packed, add explicit field for padding.
-  uint16_t padding_ = 0;
+  // The warm-up count the script had reached when this stencil was
+  // incrementally encoded, saturated to fit. Zero for freshly compiled
+  // stencils. See `ScriptSource::xdrFinalizeEncoder`.
+  uint16_t warmUpHint = 0;
 
   ScriptStencilExtra() = default;
 
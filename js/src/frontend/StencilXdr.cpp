@@ -310,6 +310,15 @@ XDRResult StencilXDR::codeSharedData(XDRState<mode>* xdr,
     return Ok();
   }
 
+  // Transcode the hash used to share the data, such that decoding does not
+  // have to read all the bytecode, which is especially useful when it is
+  // pinned in a memory-mapped buffer.
+  mozilla::HashNumber hash;
+  if (mode == XDR_ENCODE) {
+    hash = sisd->hash();
+  }
+  MOZ_TRY(xdr->codeUint32(&hash));
+
   MOZ_TRY(xdr->align32());
   static_assert(alignof(ImmutableScriptData) <= alignof(uint32_t));
 
@@ -344,6 +353,10 @@ XDRResult StencilXDR::codeSharedData(XDRState<mode>* xdr,
       MOZ_ASSERT(false, "Bad ImmutableScriptData");
       return xdr->fail(JS::TranscodeResult::Failure_BadDecode);
     }
+
+    // A corrupted hash can at worst prevent this data from being shared, as
+    // matching entries still compare the full content.
+    sisd->hash_ = hash;
   }
 
   if (mode == XDR_DECODE) {
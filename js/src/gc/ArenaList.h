@@ -326,6 +326,10 @@ class ArenaLists {
 
   void checkEmptyArenaList(AllocKind kind);
 
+  // Choose arenas to relocate for each compacting alloc kind and return
+  // whether enough of them would be freed to make compacting worthwhile.
+  bool pickArenasToRelocate(JS::GCReason reason,
+                            AllAllocKindArray<Arena**>& toRelocate);
   bool relocateArenas(Arena*& relocatedListOut, JS::GCReason reason,
                       js::SliceBudget& sliceBudget, gcstats::Statistics& stats);
 
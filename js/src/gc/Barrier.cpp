@@ -18,6 +18,7 @@
 #include "vm/JSObject.h"
 #include "vm/PropMap.h"
 #include "vm/Realm.h"
+#include "vm/Shape.h"
 #include "vm/SharedArrayObject.h"
 #include "vm/SymbolType.h"
 #include "wasm/WasmJS.h"
@@ -155,6 +156,7 @@ template struct JS_PUBLIC_API MovableCellHasher<BaseScript*>;
 template struct JS_PUBLIC_API MovableCellHasher<PropMap*>;
 template struct JS_PUBLIC_API MovableCellHasher<ScriptSourceObject*>;
 template struct JS_PUBLIC_API MovableCellHasher<SavedFrame*>;
+template struct JS_PUBLIC_API MovableCellHasher<Shape*>;
 template struct JS_PUBLIC_API MovableCellHasher<WasmInstanceObject*>;
 
 }  // namespace js
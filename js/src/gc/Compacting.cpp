@@ -10,6 +10,8 @@
 
 #include "mozilla/Maybe.h"
 
+#include <algorithm>
+
 #include "debugger/DebugAPI.h"
 #include "gc/ArenaList.h"
 #include "gc/GCInternals.h"
@@ -35,9 +37,43 @@ using namespace js;
 using namespace js::gc;
 
 using mozilla::Maybe;
+using mozilla::TimeStamp;
 
 bool GCRuntime::canRelocateZone(Zone* zone) const {
-  return !zone->isAtomsZone();
+  // Zones that preserve JIT code are only possible in non-shrinking GCs, which
+  // only compact when fragmentation-driven compaction is enabled.
+  return !zone->isAtomsZone() && !zone->isPreservingCode();
+}
+
+bool GCRuntime::shouldCompactForFragmentation(JS::GCReason reason) {
+  // Non-shrinking GCs decide whether to compact at the end of sweeping, when
+  // we know how many arenas could be freed in each zone.
+  MOZ_ASSERT(!isCompacting);
+
+  if (isShrinkingGC() || !tunables.compactOnFragmentation() ||
+      !isCompactingGCEnabled()) {
+    return false;
+  }
+
+  if (isIncremental &&
+      IsCurrentlyAnimating(rt->lastAnimationTime, TimeStamp::Now())) {
+    return false;
+  }
+
+  for (GCZonesIter zone(this); !zone.done(); zone.next()) {
+    if (!canRelocateZone(zone)) {
+      continue;
+    }
+
+    // The free lists are not cleared here, but the arenas they refer to are
+    // all before the cursor and are not considered for relocation.
+    AllAllocKindArray<Arena**> toRelocate;
+    if (zone->arenas.pickArenasToRelocate(reason, toRelocate)) {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 void GCRuntime::beginCompactPhase() {
@@ -330,8 +366,19 @@ Arena* ArenaList::relocateArenas(Arena* toRelocate, Arena* relocated,
 // heap memory.
 static const float MIN_ZONE_RECLAIM_PERCENT = 2.0;
 
+float GCRuntime::minZoneReclaimPercent() const {
+  if (isShrinkingGC()) {
+    return MIN_ZONE_RECLAIM_PERCENT;
+  }
+
+  // Compaction in other GCs is opportunistic, so require that the zone is
+  // fragmented enough to make it worthwhile.
+  float threshold = float(tunables.compactingFragmentationThreshold() * 100.0);
+  return std::max(threshold, MIN_ZONE_RECLAIM_PERCENT);
+}
+
 static bool ShouldRelocateZone(size_t arenaCount, size_t relocCount,
-                               JS::GCReason reason) {
+                               JS::GCReason reason, float minReclaimPercent) {
   if (relocCount == 0) {
     return false;
   }
@@ -340,7 +387,7 @@ static bool ShouldRelocateZone(size_t arenaCount, size_t relocCount,
     return true;
   }
 
-  return (relocCount * 100.0f) / arenaCount >= MIN_ZONE_RECLAIM_PERCENT;
+  return (relocCount * 100.0f) / arenaCount >= minReclaimPercent;
 }
 
 static AllocKinds CompactingAllocKinds() {
@@ -353,6 +400,19 @@ static AllocKinds CompactingAllocKinds() {
   return result;
 }
 
+bool ArenaLists::pickArenasToRelocate(JS::GCReason reason,
+                                      AllAllocKindArray<Arena**>& toRelocate) {
+  size_t arenaCount = 0;
+  size_t relocCount = 0;
+  for (auto kind : CompactingAllocKinds()) {
+    toRelocate[kind] =
+        arenaList(kind).pickArenasToRelocate(arenaCount, relocCount);
+  }
+
+  return ShouldRelocateZone(arenaCount, relocCount, reason,
+                            runtime()->gc.minZoneReclaimPercent());
+}
+
 bool ArenaLists::relocateArenas(Arena*& relocatedListOut, JS::GCReason reason,
                                 SliceBudget& sliceBudget,
                                 gcstats::Statistics& stats) {
@@ -378,16 +438,8 @@ bool ArenaLists::relocateArenas(Arena*& relocatedListOut, JS::GCReason reason,
           al.relocateArenas(allArenas, relocatedListOut, sliceBudget, stats);
     }
   } else {
-    size_t arenaCount = 0;
-    size_t relocCount = 0;
     AllAllocKindArray<Arena**> toRelocate;
-
-    for (auto kind : allocKindsToRelocate) {
-      toRelocate[kind] =
-          arenaList(kind).pickArenasToRelocate(arenaCount, relocCount);
-    }
-
-    if (!ShouldRelocateZone(arenaCount, relocCount, reason)) {
+    if (!pickArenasToRelocate(reason, toRelocate)) {
       return false;
     }
 
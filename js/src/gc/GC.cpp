@@ -225,6 +225,7 @@
 #include "gc/ParallelWork.h"
 #include "gc/Policy.h"
 #include "gc/WeakMap.h"
+#include "irregexp/RegExpAPI.h"
 #include "jit/ExecutableAllocator.h"
 #include "jit/JitCode.h"
 #include "jit/JitRealm.h"
@@ -460,6 +461,8 @@ GCRuntime::GCRuntime(JSRuntime* rt)
       defaultTimeBudgetMS_(TuningDefaults::DefaultTimeBudgetMS),
       incrementalAllowed(true),
       compactingEnabled(TuningDefaults::CompactingEnabled),
+      parallelMinorGCEnabled(TuningDefaults::ParallelMinorGCEnabled),
+      backgroundMarkingEnabled(TuningDefaults::BackgroundMarkingEnabled),
       rootsRemoved(false),
 #ifdef JS_GC_ZEAL
       zealModeBits(0),
@@ -1016,6 +1019,12 @@ bool GCRuntime::setParameter(JSGCParamKey key, uint32_t value,
     case JSGC_COMPACTING_ENABLED:
       compactingEnabled = value != 0;
       break;
+    case JSGC_PARALLEL_MINOR_GC_ENABLED:
+      parallelMinorGCEnabled = value != 0;
+      break;
+    case JSGC_BACKGROUND_MARKING_ENABLED:
+      backgroundMarkingEnabled = value != 0;
+      break;
     case JSGC_INCREMENTAL_WEAKMAP_ENABLED:
       marker.incrementalWeakMapMarkingEnabled = value != 0;
       break;
@@ -1081,6 +1090,12 @@ void GCRuntime::resetParameter(JSGCParamKey key, AutoLockGC& lock) {
     case JSGC_COMPACTING_ENABLED:
       compactingEnabled = TuningDefaults::CompactingEnabled;
       break;
+    case JSGC_PARALLEL_MINOR_GC_ENABLED:
+      parallelMinorGCEnabled = TuningDefaults::ParallelMinorGCEnabled;
+      break;
+    case JSGC_BACKGROUND_MARKING_ENABLED:
+      backgroundMarkingEnabled = TuningDefaults::BackgroundMarkingEnabled;
+      break;
     case JSGC_INCREMENTAL_WEAKMAP_ENABLED:
       marker.incrementalWeakMapMarkingEnabled =
           TuningDefaults::IncrementalWeakMapMarkingEnabled;
@@ -1176,6 +1191,10 @@ uint32_t GCRuntime::getParameter(JSGCParamKey key, const AutoLockGC& lock) {
       return maxEmptyChunkCount(lock);
     case JSGC_COMPACTING_ENABLED:
       return compactingEnabled;
+    case JSGC_PARALLEL_MINOR_GC_ENABLED:
+      return parallelMinorGCEnabled;
+    case JSGC_BACKGROUND_MARKING_ENABLED:
+      return backgroundMarkingEnabled;
     case JSGC_INCREMENTAL_WEAKMAP_ENABLED:
       return marker.incrementalWeakMapMarkingEnabled;
     case JSGC_NURSERY_FREE_THRESHOLD_FOR_IDLE_COLLECTION:
@@ -1185,6 +1204,8 @@ uint32_t GCRuntime::getParameter(JSGCParamKey key, const AutoLockGC& lock) {
                       100.0f);
     case JSGC_NURSERY_TIMEOUT_FOR_IDLE_COLLECTION_MS:
       return tunables.nurseryTimeoutForIdleCollection().ToMilliseconds();
+    case JSGC_COMPACTING_FRAGMENTATION_THRESHOLD:
+      return uint32_t(tunables.compactingFragmentationThreshold() * 100);
     case JSGC_PRETENURE_THRESHOLD:
       return uint32_t(tunables.pretenureThreshold() * 100);
     case JSGC_PRETENURE_GROUP_THRESHOLD:
@@ -2133,6 +2154,12 @@ void GCRuntime::purgeRuntime() {
   // memory when they are next idle.
   if (!rt->parentRuntime) {
     HelperThreadState().triggerFreeUnusedMemory();
+
+    // Shrinking GCs are what memory pressure triggers, so drop the
+    // process-wide regexp bytecode cache too.
+    if (isShrinkingGC()) {
+      irregexp::PurgeBytecodeCache();
+    }
   }
 }
 
@@ -3303,6 +3330,11 @@ void GCRuntime::incrementalSlice(SliceBudget& budget, JS::GCReason reason,
       MOZ_ASSERT(!startedCompacting);
       incrementalState = State::Compact;
 
+      // Non-shrinking GCs may still compact zones that have become fragmented.
+      if (!isCompacting && shouldCompactForFragmentation(reason)) {
+        isCompacting = true;
+      }
+
       // Always yield before compacting since it is not incremental.
       if (isCompacting && !budget.isUnlimited()) {
         break;
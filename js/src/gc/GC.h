@@ -78,6 +78,10 @@ struct Cell;
   _("zoneAllocDelayKB", JSGC_ZONE_ALLOC_DELAY_KB, true)                    \
   _("mallocThresholdBase", JSGC_MALLOC_THRESHOLD_BASE, true)               \
   _("urgentThreshold", JSGC_URGENT_THRESHOLD_MB, true)                     \
+  _("parallelMinorGCEnabled", JSGC_PARALLEL_MINOR_GC_ENABLED, true)        \
+  _("backgroundMarkingEnabled", JSGC_BACKGROUND_MARKING_ENABLED, true)     \
+  _("compactingFragmentationThreshold",                                    \
+    JSGC_COMPACTING_FRAGMENTATION_THRESHOLD, true)                         \
   _("chunkBytes", JSGC_CHUNK_BYTES, false)                                 \
   _("helperThreadRatio", JSGC_HELPER_THREAD_RATIO, true)                   \
   _("maxHelperThreads", JSGC_MAX_HELPER_THREADS, true)                     \
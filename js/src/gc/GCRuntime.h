@@ -465,6 +465,8 @@ class GCRuntime {
 
   bool isCompactingGCEnabled() const;
 
+  bool isParallelMinorGCEnabled() const { return parallelMinorGCEnabled; }
+
   bool isShrinkingGC() const { return gcOptions() == JS::GCOptions::Shrink; }
 
   bool isShutdownGC() const { return gcOptions() == JS::GCOptions::Shutdown; }
@@ -864,6 +866,8 @@ class GCRuntime {
   void endCompactPhase();
   void sweepZoneAfterCompacting(MovingTracer* trc, Zone* zone);
   bool canRelocateZone(Zone* zone) const;
+  bool shouldCompactForFragmentation(JS::GCReason reason);
+  float minZoneReclaimPercent() const;
   [[nodiscard]] bool relocateArenas(Zone* zone, JS::GCReason reason,
                                     Arena*& relocatedListOut,
                                     SliceBudget& sliceBudget);
@@ -1192,6 +1196,23 @@ class GCRuntime {
    */
   MainThreadData<bool> compactingEnabled;
 
+  /*
+   * Whether minor GCs may use helper threads for per-zone work.
+   *
+   * JSGC_PARALLEL_MINOR_GC_ENABLED
+   * pref: javascript.options.mem.gc_parallel_minor
+   */
+  MainThreadData<bool> parallelMinorGCEnabled;
+
+  /*
+   * Whether barrier marking during incremental sweeping may be done on a
+   * helper thread.
+   *
+   * JSGC_BACKGROUND_MARKING_ENABLED
+   * pref: javascript.options.mem.gc_background_marking
+   */
+  MainThreadData<bool> backgroundMarkingEnabled;
+
   MainThreadData<bool> rootsRemoved;
 
   /*
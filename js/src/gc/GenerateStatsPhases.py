@@ -101,7 +101,8 @@ PhaseKindGraphRoots = [
                     addPhaseKind("MARK_RUNTIME_DATA", "Mark Runtime-wide Data", 52),
                     addPhaseKind("MARK_EMBEDDING", "Mark Embedding", 53),
                 ],
-            )
+            ),
+            addPhaseKind("MINOR_GC_SWEEP_ZONES", "Sweep Zones After Minor GC", 78),
         ],
     ),
     addPhaseKind("WAIT_BACKGROUND_THREAD", "Wait Background Thread", 2),
@@ -230,6 +231,7 @@ PhaseKindGraphRoots = [
         45,
         [
             getPhaseKind("MARK_ROOTS"),
+            getPhaseKind("MINOR_GC_SWEEP_ZONES"),
         ],
     ),
     addPhaseKind(
@@ -238,6 +240,7 @@ PhaseKindGraphRoots = [
         46,
         [
             getPhaseKind("MARK_ROOTS"),
+            getPhaseKind("MINOR_GC_SWEEP_ZONES"),
         ],
     ),
     addPhaseKind(
@@ -246,6 +249,7 @@ PhaseKindGraphRoots = [
         47,
         [
             getPhaseKind("MARK_ROOTS"),
+            getPhaseKind("MINOR_GC_SWEEP_ZONES"),
         ],
     ),
 ]
@@ -2576,13 +2576,33 @@ IncrementalProgress JS::Zone::enterWeakMarkingMode(GCMarker* marker,
     auto& edges = r.front().value;
     r.popFront();  // Pop before any mutations happen.
 
+    // Nothing can be marked through keys that are not marked yet.
+    if (srcColor == CellColor::White && edges.length() > 0) {
+      budget.step(1);
+      if (budget.isOverBudget()) {
+        return NotFinished;
+      }
+      continue;
+    }
+
     if (edges.length() > 0) {
       uint32_t steps = edges.length();
       marker->markEphemeronEdges(edges, srcColor);
       budget.step(steps);
-      if (budget.isOverBudget()) {
-        return NotFinished;
-      }
+    }
+
+    // Once every edge from a key has been marked black, drop its entry so
+    // that later entries into weak marking mode during this GC don't have to
+    // scan it again. Marking the key again would find no entry, which is
+    // equivalent to an empty one. |edges| must not be used after this.
+    if (edges.empty()) {
+      bool found;
+      (void)gcEphemeronEdges().remove(src, &found);
+      MOZ_ASSERT(found);
+    }
+
+    if (budget.isOverBudget()) {
+      return NotFinished;
     }
   }
 
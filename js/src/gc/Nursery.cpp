@@ -21,6 +21,7 @@
 #include "gc/GCInternals.h"
 #include "gc/GCLock.h"
 #include "gc/Memory.h"
+#include "gc/ParallelWork.h"
 #include "gc/PublicIterators.h"
 #include "gc/Tenuring.h"
 #include "jit/JitFrames.h"
@@ -1475,8 +1476,15 @@ void js::Nursery::sweep() {
   }
   cellsWithUid_.clear();
 
-  for (ZonesIter zone(runtime(), SkipAtoms); !zone.done(); zone.next()) {
-    zone->sweepAfterMinorGC(&trc);
+  if (shouldSweepZonesInParallel()) {
+    for (ZonesIter zone(runtime(), SkipAtoms); !zone.done(); zone.next()) {
+      zone->sweepEphemeronTablesAfterMinorGC();
+    }
+    sweepZoneWrappersInParallel();
+  } else {
+    for (ZonesIter zone(runtime(), SkipAtoms); !zone.done(); zone.next()) {
+      zone->sweepAfterMinorGC(&trc);
+    }
   }
 
   sweepMapAndSetObjects();
@@ -1484,6 +1492,42 @@ void js::Nursery::sweep() {
   runtime()->caches().sweepAfterMinorGC(&trc);
 }
 
+bool js::Nursery::shouldSweepZonesInParallel() const {
+  if (!gc->isParallelMinorGCEnabled() || gc->parallelWorkerCount() <= 1) {
+    return false;
+  }
+
+  // There's no point starting helper tasks if there's only one zone's worth of
+  // work to do.
+  ZonesIter zone(runtime(), SkipAtoms);
+  if (zone.done()) {
+    return false;
+  }
+  zone.next();
+  return !zone.done();
+}
+
+static size_t SweepZoneWrappersAfterMinorGC(GCRuntime* gc, Zone* const& zone) {
+  MinorSweepingTracer trc(gc->rt);
+  zone->sweepWrappersAfterMinorGC(&trc);
+  return 1;
+}
+
+void js::Nursery::sweepZoneWrappersInParallel() {
+  // Each zone's wrapper maps and inner view tables are independent of every
+  // other zone's, so hand them out to helper threads one zone at a time. The
+  // helper tasks don't record their own parallel phase times since we may not
+  // be inside a major GC slice here.
+  gcstats::AutoPhase ap(stats(), gcstats::PhaseKind::MINOR_GC_SWEEP_ZONES);
+
+  ZonesIter work(gc, SkipAtoms);
+  AutoLockHelperThreadState lock;
+  AutoRunParallelWork sweepTasks(gc, SweepZoneWrappersAfterMinorGC,
+                                 gcstats::PhaseKind::NONE, GCUse::Sweeping,
+                                 work, SliceBudget::unlimited(), lock);
+  AutoUnlockHelperThreadState unlock(lock);
+}
+
 void js::Nursery::clear() {
   // Poison the nursery contents so touching a freed object will crash.
   unsigned firstClearChunk;
@@ -662,6 +662,8 @@ class Nursery {
   // Updates pointers to nursery objects that have been tenured and discards
   // pointers to objects that have been freed.
   void sweep();
+  bool shouldSweepZonesInParallel() const;
+  void sweepZoneWrappersInParallel();
 
   // Reset the current chunk and position after a minor collection. Also poison
   // the nursery on debug & nightly builds.
@@ -290,6 +290,16 @@ void AllocSite::updateStateOnMinorGC(double promotionRate) {
   }
 }
 
+void AllocSite::restoreLongLivedState(uint32_t numInvalidations) {
+  MOZ_ASSERT(hasScript());
+  MOZ_ASSERT(state() == State::Unknown);
+  MOZ_ASSERT(invalidationCount == 0);
+  MOZ_ASSERT(numInvalidations < MaxInvalidationCount);
+
+  invalidationCount = numInvalidations;
+  setState(State::LongLived);
+}
+
 bool AllocSite::maybeResetState() {
   if (invalidationLimitReached()) {
     MOZ_ASSERT(state() == State::Unknown);
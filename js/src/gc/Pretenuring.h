@@ -80,19 +80,28 @@ class AllocSite {
   // Number of times the script has been invalidated.
   uint32_t invalidationCount : 8;
 
+  // Bytecode offset of the allocation in the owning script, or
+  // InvalidPCOffset for catch-all sites and sites created for inlined
+  // allocations.
+  uint32_t pcOffset_ = InvalidPCOffset;
+
   static AllocSite* const EndSentinel;
 
   friend class PretenuringZone;
   friend class PretenuringNursery;
 
  public:
+  static constexpr uint32_t InvalidPCOffset = UINT32_MAX;
+
   // Create a dummy site to use for unknown allocations.
   explicit AllocSite(JS::Zone* zone)
       : zone_(zone), nurseryTenuredCount(0), invalidationCount(0) {}
 
   // Create a site for an opcode in the given script.
-  AllocSite(JS::Zone* zone, JSScript* script) : AllocSite(zone) {
+  AllocSite(JS::Zone* zone, JSScript* script, uint32_t pcOffset)
+      : AllocSite(zone) {
     setScript(script);
+    pcOffset_ = pcOffset;
   }
 
   JS::Zone* zone() const { return zone_; }
@@ -104,6 +113,11 @@ class AllocSite {
   }
   bool hasScript() const { return script(); }
 
+  uint32_t pcOffset() const { return pcOffset_; }
+  bool hasPCOffset() const { return pcOffset_ != InvalidPCOffset; }
+
+  uint32_t numInvalidations() const { return invalidationCount; }
+
   enum class Kind : uint32_t { Normal, Unknown, Optimized };
   Kind kind() const;
 
@@ -144,6 +158,10 @@ class AllocSite {
   bool invalidationLimitReached() const;
   bool invalidateScript(GCRuntime* gc);
 
+  // Initialize a newly created site with a long lived state that was
+  // recorded for the same bytecode before the previous site was discarded.
+  void restoreLongLivedState(uint32_t numInvalidations);
+
   void trace(JSTracer* trc);
 
   static void printInfoHeader(JS::GCReason reason, double promotionRate);
@@ -61,6 +61,8 @@ GCSchedulingTunables::GCSchedulingTunables()
           TuningDefaults::NurseryFreeThresholdForIdleCollectionFraction),
       nurseryTimeoutForIdleCollection_(TimeDuration::FromMilliseconds(
           TuningDefaults::NurseryTimeoutForIdleCollectionMS)),
+      compactingFragmentationThreshold_(
+          TuningDefaults::CompactingFragmentationThreshold),
       pretenureThreshold_(TuningDefaults::PretenureThreshold),
       pretenureGroupThreshold_(TuningDefaults::PretenureGroupThreshold),
       pretenureStringThreshold_(TuningDefaults::PretenureStringThreshold),
@@ -182,6 +184,13 @@ bool GCSchedulingTunables::setParameter(JSGCParamKey key, uint32_t value) {
     case JSGC_NURSERY_TIMEOUT_FOR_IDLE_COLLECTION_MS:
       nurseryTimeoutForIdleCollection_ = TimeDuration::FromMilliseconds(value);
       break;
+    case JSGC_COMPACTING_FRAGMENTATION_THRESHOLD:
+      // 0 disables compacting on fragmentation.
+      if (value > 100) {
+        return false;
+      }
+      compactingFragmentationThreshold_ = value / 100.0;
+      break;
     case JSGC_PRETENURE_THRESHOLD: {
       // 100 disables pretenuring
       if (value == 0 || value > 100) {
@@ -362,6 +371,10 @@ void GCSchedulingTunables::resetParameter(JSGCParamKey key) {
       nurseryTimeoutForIdleCollection_ = TimeDuration::FromMilliseconds(
           TuningDefaults::NurseryTimeoutForIdleCollectionMS);
       break;
+    case JSGC_COMPACTING_FRAGMENTATION_THRESHOLD:
+      compactingFragmentationThreshold_ =
+          TuningDefaults::CompactingFragmentationThreshold;
+      break;
     case JSGC_PRETENURE_THRESHOLD:
       pretenureThreshold_ = TuningDefaults::PretenureThreshold;
       break;
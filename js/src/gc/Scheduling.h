@@ -408,6 +408,15 @@ static const bool CompactingEnabled = true;
 /* JSGC_INCREMENTAL_WEAKMAP_ENABLED */
 static const bool IncrementalWeakMapMarkingEnabled = true;
 
+/* JSGC_PARALLEL_MINOR_GC_ENABLED */
+static const bool ParallelMinorGCEnabled = false;
+
+/* JSGC_BACKGROUND_MARKING_ENABLED */
+static const bool BackgroundMarkingEnabled = true;
+
+/* JSGC_COMPACTING_FRAGMENTATION_THRESHOLD */
+static const double CompactingFragmentationThreshold = 0.0;
+
 /* JSGC_NURSERY_FREE_THRESHOLD_FOR_IDLE_COLLECTION */
 static const uint32_t NurseryFreeThresholdForIdleCollection = ChunkSize / 4;
 
@@ -542,6 +551,15 @@ class GCSchedulingTunables {
   /* See JSGC_NURSERY_TIMEOUT_FOR_IDLE_COLLECTION_MS. */
   MainThreadData<mozilla::TimeDuration> nurseryTimeoutForIdleCollection_;
 
+  /*
+   * JSGC_COMPACTING_FRAGMENTATION_THRESHOLD
+   *
+   * Fraction of a zone's arenas that must be reclaimable before a
+   * non-shrinking GC will compact it (between 0 and 1). If this is zero then
+   * only shrinking GCs compact.
+   */
+  MainThreadData<double> compactingFragmentationThreshold_;
+
   /*
    * JSGC_PRETENURE_THRESHOLD
    *
@@ -635,6 +653,13 @@ class GCSchedulingTunables {
     return nurseryTimeoutForIdleCollection_;
   }
 
+  bool compactOnFragmentation() const {
+    return compactingFragmentationThreshold_ > 0.0;
+  }
+  double compactingFragmentationThreshold() const {
+    return compactingFragmentationThreshold_;
+  }
+
   bool attemptPretenuring() const { return pretenureThreshold_ < 1.0; }
   double pretenureThreshold() const { return pretenureThreshold_; }
   uint32_t pretenureGroupThreshold() const { return pretenureGroupThreshold_; }
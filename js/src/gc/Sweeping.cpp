@@ -1546,7 +1546,8 @@ IncrementalProgress GCRuntime::beginSweepingSweepGroup(JS::GCContext* gcx,
   MOZ_ASSERT(!sweepZone);
 
   safeToYield = true;
-  markOnBackgroundThreadDuringSweeping = CanUseExtraThreads();
+  markOnBackgroundThreadDuringSweeping =
+      backgroundMarkingEnabled && CanUseExtraThreads();
 
   return Finished;
 }
@@ -981,8 +981,11 @@ size_t js::TenuringTracer::moveBigIntToTenured(JS::BigInt* dst, JS::BigInt* src,
 MinorSweepingTracer::MinorSweepingTracer(JSRuntime* rt)
     : GenericTracerImpl(rt, JS::TracerKind::MinorSweeping,
                         JS::WeakMapTraceAction::TraceKeysAndValues) {
-  MOZ_ASSERT(CurrentThreadCanAccessRuntime(runtime()));
-  MOZ_ASSERT(JS::RuntimeHeapIsMinorCollecting());
+  // This can be used from GC helper threads if per-zone sweeping is done in
+  // parallel; see Nursery::sweepZoneWrappersInParallel.
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(runtime()) ||
+             CurrentThreadIsGCSweeping());
+  MOZ_ASSERT(runtime()->gc.heapState() == JS::HeapState::MinorCollecting);
 }
 
 template <typename T>
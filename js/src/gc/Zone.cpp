@@ -267,6 +267,13 @@ static void SweepEphemeronEdgesWhileMinorSweeping(
 
 void Zone::sweepAfterMinorGC(JSTracer* trc) {
   sweepEphemeronTablesAfterMinorGC();
+  sweepWrappersAfterMinorGC(trc);
+}
+
+void Zone::sweepWrappersAfterMinorGC(JSTracer* trc) {
+  // Unlike the ephemeron tables, which can contain entries for delegates in
+  // other zones, this only touches data owned by this zone and so can run in
+  // parallel with the same operation on other zones.
   crossZoneStringWrappers().sweepAfterMinorGC(trc);
 
   for (CompartmentsInZoneIter comp(this); !comp.done(); comp.next()) {
@@ -422,6 +429,12 @@ void Zone::discardJitCode(JS::GCContext* gcx, const DiscardOptions& options) {
     jit::MarkActiveJitScripts(this);
   }
 
+  // Forget which sites were pretenured if we're recovering from having made
+  // the wrong pretenuring decisions.
+  if (options.resetPretenuredAllocSites) {
+    jitZone()->clearPretenuredAllocSites();
+  }
+
   // Invalidate all Ion code in this zone.
   jit::InvalidateAll(gcx, this);
 
@@ -454,6 +467,9 @@ void Zone::discardJitCode(JS::GCContext* gcx, const DiscardOptions& options) {
     // releasing JIT code because we can't do this when the script still has
     // JIT code.
     if (options.discardJitScripts) {
+      if (!options.resetPretenuredAllocSites) {
+        jitZone()->rememberPretenuredAllocSites(script, jitScript);
+      }
       script->maybeReleaseJitScript(gcx);
       jitScript = script->maybeJitScript();
       if (!jitScript) {
@@ -503,6 +519,10 @@ void JS::Zone::resetAllocSitesAndInvalidate(bool resetNurserySites,
     return;
   }
 
+  if (resetPretenuredSites) {
+    jitZone()->clearPretenuredAllocSites();
+  }
+
   JSContext* cx = runtime_->mainContextFromOwnThread();
   for (auto base = cellIterUnsafe<BaseScript>(); !base.done(); base.next()) {
     jit::JitScript* jitScript = base->maybeJitScript();
@@ -406,6 +406,8 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
   void traceRootsInMajorGC(JSTracer* trc);
 
   void sweepAfterMinorGC(JSTracer* trc);
+  void sweepEphemeronTablesAfterMinorGC();
+  void sweepWrappersAfterMinorGC(JSTracer* trc);
   void sweepUniqueIds();
   void sweepCompartments(JS::GCContext* gcx, bool keepAtleastOne, bool lastGC);
 
@@ -598,8 +600,6 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
 
   bool isQueuedForBackgroundSweep() { return isOnList(); }
 
-  void sweepEphemeronTablesAfterMinorGC();
-
   js::gc::FinalizationObservers* finalizationObservers() {
     return finalizationObservers_.ref().get();
   }
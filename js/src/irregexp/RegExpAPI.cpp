@@ -12,6 +12,8 @@
 
 #include "mozilla/ArrayUtils.h"
 #include "mozilla/Casting.h"
+#include "mozilla/HashFunctions.h"
+#include "mozilla/RefPtr.h"
 
 #include "frontend/TokenStream.h"
 #include "gc/Zone.h"
@@ -29,8 +31,12 @@
 #include "jit/JitCommon.h"
 #include "js/friend/ErrorMessages.h"  // JSMSG_*
 #include "js/friend/StackLimits.h"    // js::ReportOverRecursed
+#include "js/RefCounted.h"
+#include "threading/ExclusiveData.h"
 #include "util/StringBuffer.h"
+#include "util/Text.h"
 #include "vm/MatchPairs.h"
+#include "vm/MutexIDs.h"
 #include "vm/RegExpShared.h"
 
 namespace js {
@@ -455,6 +461,251 @@ class RegExpDepthCheck final : public v8::internal::RegExpVisitor {
   static const size_t FRAME_PADDING = 256;
 };
 
+// Process-wide cache of the bytecode generated for the regexp interpreter.
+//
+// Bytecode contains no pointers to GC things or other runtime data, so the
+// bytecode compiled for a given source, flags and input encoding can be reused
+// by every RegExpShared with the same key, in any zone or runtime, instead of
+// being regenerated for each of them. This is a small direct-mapped table:
+// a colliding insertion simply replaces the previous entry. Each RegExpShared
+// receives its own copy of the bytecode, so ownership of RegExpShared's
+// bytecode is unchanged. Every allocation, copy and free happens outside the
+// lock: entries share their bytecode by reference, so a hit only takes a
+// reference under the lock and copies it after unlocking.
+class RegExpBytecodeCache {
+ public:
+  static const size_t NumEntries = 256;
+
+  // Don't hold on to large patterns or large programs.
+  static const size_t MaxSourceLength = 1024;
+  static const size_t MaxByteCodeLength = 64 * 1024;
+
+  using ByteCode = RegExpShared::ByteCode;
+
+  static ExclusiveData<RegExpBytecodeCache>* instance;
+
+  struct SharedByteCode : public js::AtomicRefCounted<SharedByteCode> {
+    uint32_t numRegisters = 0;
+    UniquePtr<ByteCode, JS::FreePolicy> byteCode;
+  };
+
+  struct Entry {
+    UniqueTwoByteChars source;
+    size_t sourceLength = 0;
+    mozilla::HashNumber hash = 0;
+    JS::RegExpFlags flags;
+    bool latin1 = false;
+    RefPtr<SharedByteCode> byteCode;
+
+    bool matches(JSAtom* atom, mozilla::HashNumber h, JS::RegExpFlags f,
+                 bool l) const;
+  };
+
+  // On a hit, return a reference to the cached bytecode. Returns nullptr on a
+  // miss. Use copyByteCode() on the result after releasing the lock.
+  already_AddRefed<SharedByteCode> lookup(JSAtom* source,
+                                          JS::RegExpFlags flags, bool latin1);
+
+  // Fill |entry| with copies of the source and bytecode. This allocates, so
+  // call it without holding the lock. Returns false if the regexp is too large
+  // to be cached, or on OOM.
+  static bool makeEntry(JSAtom* source, JS::RegExpFlags flags, bool latin1,
+                        uint32_t numRegisters, const ByteCode* byteCode,
+                        Entry* entry);
+
+  // Store |entry| in its slot. |entry| receives the evicted entry, if any, so
+  // that the caller frees it after releasing the lock.
+  void insert(Entry& entry);
+
+  // Move every entry into |evicted|, so that the caller frees them after
+  // releasing the lock.
+  void purge(Entry (&evicted)[NumEntries]);
+
+  size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const;
+
+  size_t entryCount() const;
+  uint64_t hitCount() const { return hits_; }
+
+  static ByteCode* copyByteCode(const ByteCode* byteCode) {
+    size_t allocSize = sizeof(ByteCode) + byteCode->length;
+    ByteCode* copy = static_cast<ByteCode*>(js_malloc(allocSize));
+    if (copy) {
+      memcpy(copy, byteCode, allocSize);
+    }
+    return copy;
+  }
+
+ private:
+  static mozilla::HashNumber hash(JSAtom* source, JS::RegExpFlags flags,
+                                  bool latin1) {
+    return mozilla::AddToHash(source->hash(), flags.value(), latin1);
+  }
+
+  Entry entries_[NumEntries];
+  uint64_t hits_ = 0;
+};
+
+/* static */
+ExclusiveData<RegExpBytecodeCache>* RegExpBytecodeCache::instance = nullptr;
+
+bool RegExpBytecodeCache::Entry::matches(JSAtom* atom, mozilla::HashNumber h,
+                                         JS::RegExpFlags f, bool l) const {
+  if (!byteCode || hash != h || flags != f || latin1 != l ||
+      sourceLength != atom->length()) {
+    return false;
+  }
+  JS::AutoCheckCannotGC nogc;
+  return atom->hasLatin1Chars()
+             ? EqualChars(atom->latin1Chars(nogc), source.get(), sourceLength)
+             : EqualChars(atom->twoByteChars(nogc), source.get(),
+                          sourceLength);
+}
+
+already_AddRefed<RegExpBytecodeCache::SharedByteCode>
+RegExpBytecodeCache::lookup(JSAtom* source, JS::RegExpFlags flags,
+                            bool latin1) {
+  mozilla::HashNumber h = hash(source, flags, latin1);
+  const Entry& entry = entries_[h % NumEntries];
+  if (!entry.matches(source, h, flags, latin1)) {
+    return nullptr;
+  }
+  hits_++;
+  return do_AddRef(entry.byteCode);
+}
+
+/* static */
+bool RegExpBytecodeCache::makeEntry(JSAtom* source, JS::RegExpFlags flags,
+                                    bool latin1, uint32_t numRegisters,
+                                    const ByteCode* byteCode, Entry* entry) {
+  size_t length = source->length();
+  if (length > MaxSourceLength || byteCode->length > MaxByteCodeLength) {
+    return false;
+  }
+
+  // Failing to fill the cache is harmless, so ignore OOM here.
+  RefPtr<SharedByteCode> shared = js_new<SharedByteCode>();
+  if (!shared) {
+    return false;
+  }
+  shared->numRegisters = numRegisters;
+  shared->byteCode.reset(copyByteCode(byteCode));
+  if (!shared->byteCode) {
+    return false;
+  }
+  UniqueTwoByteChars chars(js_pod_malloc<char16_t>(length));
+  if (!chars) {
+    return false;
+  }
+  {
+    JS::AutoCheckCannotGC nogc;
+    if (source->hasLatin1Chars()) {
+      CopyAndInflateChars(chars.get(), source->latin1Chars(nogc), length);
+    } else {
+      PodCopy(chars.get(), source->twoByteChars(nogc), length);
+    }
+  }
+
+  entry->source = std::move(chars);
+  entry->sourceLength = length;
+  entry->hash = hash(source, flags, latin1);
+  entry->flags = flags;
+  entry->latin1 = latin1;
+  entry->byteCode = std::move(shared);
+  return true;
+}
+
+void RegExpBytecodeCache::insert(Entry& entry) {
+  MOZ_ASSERT(entry.byteCode);
+  std::swap(entries_[entry.hash % NumEntries], entry);
+}
+
+void RegExpBytecodeCache::purge(Entry (&evicted)[NumEntries]) {
+  for (size_t i = 0; i < NumEntries; i++) {
+    std::swap(entries_[i], evicted[i]);
+  }
+}
+
+size_t RegExpBytecodeCache::sizeOfExcludingThis(
+    mozilla::MallocSizeOf mallocSizeOf) const {
+  size_t n = 0;
+  for (const Entry& entry : entries_) {
+    n += mallocSizeOf(entry.source.get());
+    if (entry.byteCode) {
+      n += mallocSizeOf(entry.byteCode.get());
+      n += mallocSizeOf(entry.byteCode->byteCode.get());
+    }
+  }
+  return n;
+}
+
+size_t RegExpBytecodeCache::entryCount() const {
+  size_t count = 0;
+  for (const Entry& entry : entries_) {
+    if (entry.byteCode) {
+      count++;
+    }
+  }
+  return count;
+}
+
+bool InitBytecodeCache() {
+  MOZ_ASSERT(!RegExpBytecodeCache::instance);
+  RegExpBytecodeCache::instance = js_new<ExclusiveData<RegExpBytecodeCache>>(
+      mutexid::RegExpBytecodeCache);
+  return !!RegExpBytecodeCache::instance;
+}
+
+void FinishBytecodeCache() {
+  js_delete(RegExpBytecodeCache::instance);
+  RegExpBytecodeCache::instance = nullptr;
+}
+
+void PurgeBytecodeCache() {
+  // The lock is released at the end of the statement, before |evicted| is
+  // destroyed.
+  RegExpBytecodeCache::Entry evicted[RegExpBytecodeCache::NumEntries];
+  RegExpBytecodeCache::instance->lock()->purge(evicted);
+}
+
+size_t SizeOfBytecodeCache(mozilla::MallocSizeOf mallocSizeOf) {
+  return mallocSizeOf(RegExpBytecodeCache::instance) +
+         RegExpBytecodeCache::instance->lock()->sizeOfExcludingThis(
+             mallocSizeOf);
+}
+
+size_t BytecodeCacheEntryCountForTesting() {
+  return RegExpBytecodeCache::instance->lock()->entryCount();
+}
+
+uint64_t BytecodeCacheHitCountForTesting() {
+  return RegExpBytecodeCache::instance->lock()->hitCount();
+}
+
+// Return the atom that every match of |tree| must start with, or nullptr if
+// there is no such literal prefix.
+static v8::internal::RegExpAtom* RequiredLiteralPrefix(
+    v8::internal::RegExpTree* tree) {
+  while (true) {
+    if (tree->IsAtom()) {
+      v8::internal::RegExpAtom* atom = tree->AsAtom();
+      return atom->length() > 0 ? atom : nullptr;
+    }
+    if (tree->IsAlternative()) {
+      auto* nodes = tree->AsAlternative()->nodes();
+      if (nodes->is_empty()) {
+        return nullptr;
+      }
+      tree = nodes->at(0);
+      continue;
+    }
+    if (tree->IsCapture()) {
+      tree = tree->AsCapture()->body();
+      continue;
+    }
+    return nullptr;
+  }
+}
+
 enum class AssembleResult {
   Success,
   TooLarge,
@@ -577,6 +828,14 @@ enum class AssembleResult {
     ByteArray bytecode =
         v8::internal::ByteArray::cast(*result.code).takeOwnership(cx->isolate);
     uint32_t length = bytecode->length;
+    RegExpBytecodeCache::Entry entry;
+    if (RegExpBytecodeCache::makeEntry(pattern, re->getFlags(), isLatin1,
+                                       result.num_registers, bytecode.get(),
+                                       &entry)) {
+      // The evicted entry ends up in |entry| and is freed here, outside the
+      // lock.
+      RegExpBytecodeCache::instance->lock()->insert(entry);
+    }
     re->setByteCode(bytecode.release(), isLatin1);
     js::AddCellMemory(re, length, MemoryUse::RegExpSharedBytecode);
   }
@@ -642,6 +901,20 @@ bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
         return false;
       }
     }
+    // Record the literal prefix, if any, so that execution can skip to
+    // candidate positions with a string search. Case-insensitive prefixes
+    // can't be found that way, and sticky regexps only match at lastIndex.
+    if (!flags.ignoreCase() && !flags.sticky()) {
+      if (v8::internal::RegExpAtom* prefix =
+              RequiredLiteralPrefix(data.tree)) {
+        JSAtom* prefixAtom =
+            AtomizeChars(cx, prefix->data().begin(), prefix->length());
+        if (!prefixAtom) {
+          return false;
+        }
+        re->setPrefixAtom(prefixAtom);
+      }
+    }
     // All fallible initialization has succeeded, so we can change state.
     // Add one to capture_count to account for the whole-match capture.
     uint32_t pairCount = data.capture_count + 1;
@@ -650,10 +923,32 @@ bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
 
   MOZ_ASSERT(re->kind() == RegExpShared::Kind::RegExp);
 
-  RegExpCompiler compiler(cx->isolate, &zone, data.capture_count,
-                          input->hasLatin1Chars());
-
   bool isLatin1 = input->hasLatin1Chars();
+  bool useNativeCode = codeKind == RegExpShared::CodeKind::Jitcode;
+  MOZ_ASSERT_IF(useNativeCode, IsNativeRegExpEnabled());
+
+  // Bytecode for this pattern may already have been generated elsewhere in
+  // the process.
+  if (!useNativeCode) {
+    // The lock is only held while looking up the entry. The bytecode is
+    // copied after releasing it.
+    RefPtr<RegExpBytecodeCache::SharedByteCode> shared =
+        RegExpBytecodeCache::instance->lock()->lookup(pattern, flags,
+                                                      isLatin1);
+    RegExpShared::ByteCode* byteCode =
+        shared ? RegExpBytecodeCache::copyByteCode(shared->byteCode.get())
+               : nullptr;
+    if (byteCode) {
+      uint32_t length = byteCode->length;
+      re->updateMaxRegisters(shared->numRegisters);
+      re->setByteCode(byteCode, isLatin1);
+      js::AddCellMemory(re, length, MemoryUse::RegExpSharedBytecode);
+      return true;
+    }
+  }
+
+  RegExpCompiler compiler(cx->isolate, &zone, data.capture_count,
+                          isLatin1);
 
   FlatStringReader sample_subject(cx, input);
   SampleCharacters(&sample_subject, compiler);
@@ -665,9 +960,6 @@ bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
     return false;
   }
 
-  bool useNativeCode = codeKind == RegExpShared::CodeKind::Jitcode;
-  MOZ_ASSERT_IF(useNativeCode, IsNativeRegExpEnabled());
-
   switch (Assemble(cx, &compiler, &data, re, pattern, &zone, useNativeCode,
                    isLatin1)) {
     case AssembleResult::TooLarge:
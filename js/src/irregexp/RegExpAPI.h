@@ -55,6 +55,19 @@ bool CheckPatternSyntax(JSContext* cx, frontend::TokenStreamAnyChars& ts,
 bool CheckPatternSyntax(JSContext* cx, frontend::TokenStreamAnyChars& ts,
                         Handle<JSAtom*> pattern, JS::RegExpFlags flags);
 
+// Create and destroy the process-wide cache of regexp bytecode shared between
+// runtimes. Called from JS_Init and JS_ShutDown.
+bool InitBytecodeCache();
+void FinishBytecodeCache();
+
+// Drop every cached program. Called on shrinking GCs.
+void PurgeBytecodeCache();
+
+size_t SizeOfBytecodeCache(mozilla::MallocSizeOf mallocSizeOf);
+
+size_t BytecodeCacheEntryCountForTesting();
+uint64_t BytecodeCacheHitCountForTesting();
+
 bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
                     Handle<JSLinearString*> input,
                     RegExpShared::CodeKind codeKind);
@@ -0,0 +1,92 @@
+// %TypedArray%.prototype.fill over every element type, with and without
+// start/end arguments, on unshared and shared memory.
+
+const numberCtors = [
+    Int8Array, Uint8Array, Uint8ClampedArray, Int16Array, Uint16Array,
+    Int32Array, Uint32Array, Float32Array, Float64Array,
+];
+const bigIntCtors = [BigInt64Array, BigUint64Array];
+
+const numberValues = [
+    0, -0, 1, -1, 127, 128, 255, 256, -129, 1.5, 2.5, -1.5, 65535, 65536,
+    2 ** 31, -(2 ** 31) - 1, 2 ** 32 + 3, NaN, Infinity, -Infinity, "7",
+    true, undefined,
+];
+const bigIntValues = [
+    0n, 1n, -1n, 2n ** 63n, -(2n ** 63n) - 1n, 2n ** 64n + 5n, "3", true,
+];
+
+const ranges = [
+    [], [0], [3], [-3], [100], [-100], [2, 5], [5, 2], [-5, -2], [0, 100],
+    [-100, 100], [1, -1], [NaN, NaN], [undefined, 4], [1.5, 4.5], ["2", "6"],
+];
+
+function relativeIndex(arg, len, dflt) {
+    if (arg === undefined)
+        return dflt;
+    let n = Math.trunc(Number(arg)) || 0;
+    return n < 0 ? Math.max(len + n, 0) : Math.min(n, len);
+}
+
+// Reference implementation: store each element through [[Set]].
+function expectedFill(ta, value, range) {
+    let len = ta.length;
+    let isBigInt = ta instanceof BigInt64Array || ta instanceof BigUint64Array;
+    value = isBigInt ? BigInt(value) : Number(value);
+    let k = relativeIndex(range[0], len, 0);
+    let final = relativeIndex(range[1], len, len);
+    for (; k < final; k++)
+        ta[k] = value;
+}
+
+function checkFill(ctor, values, buffer) {
+    for (let value of values) {
+        for (let range of ranges) {
+            let actual = new ctor(buffer(ctor.BYTES_PER_ELEMENT * 16));
+            let expected = new ctor(16);
+            for (let i = 0; i < 16; i++) {
+                actual[i] = expected[i] = typeof expected[0] === "bigint"
+                                          ? BigInt(i + 1) : i + 1;
+            }
+
+            assertEq(actual.fill(value, ...range), actual);
+            expectedFill(expected, value, range);
+
+            for (let i = 0; i < 16; i++)
+                assertEq(actual[i], expected[i], `${ctor.name} ${value} ${range} ${i}`);
+        }
+    }
+}
+
+const buffers = [n => new ArrayBuffer(n)];
+if (typeof SharedArrayBuffer === "function")
+    buffers.push(n => new SharedArrayBuffer(n));
+
+for (let buffer of buffers) {
+    for (let ctor of numberCtors)
+        checkFill(ctor, numberValues, buffer);
+    for (let ctor of bigIntCtors)
+        checkFill(ctor, bigIntValues, buffer);
+}
+
+// Fill on a subarray view only touches the view's elements.
+for (let ctor of numberCtors) {
+    let ta = new ctor(10);
+    ta.subarray(2, 8).fill(3, 1, -1);
+    assertEq(ta.join(), "0,0,0,3,3,3,3,0,0,0");
+}
+
+// The value is converted once, not once per element.
+let conversions = 0;
+let converted = new Int32Array(8);
+converted.fill({ valueOf() { conversions++; return 5; } });
+assertEq(converted.join(), "5,5,5,5,5,5,5,5");
+assertEq(conversions, 1);
+
+// Run fill enough times to be compiled.
+let hot = new Float64Array(64);
+for (let i = 0; i < 2000; i++) {
+    hot.fill(i, i & 7, 64 - (i & 7));
+    assertEq(hot[i & 7], i);
+    assertEq(hot[63 - (i & 7)], i);
+}
@@ -0,0 +1,101 @@
+// Bounds checks of strided accesses like |ta[i * 4 + c]| are hoisted out of
+// the loop. Check that the hoisted check fails, and that the accesses still
+// behave as specified, when the index goes negative, overflows int32, or when
+// the length changes inside the loop.
+
+setJitCompilerOption("ion.warmup.trigger", 30);
+
+function sumPixels(ta, start, end) {
+    var sum = 0;
+    for (var i = start; i < end; i++) {
+        sum += (ta[i * 4] | 0) + (ta[i * 4 + 1] | 0) +
+               (ta[i * 4 + 2] | 0) + (ta[i * 4 + 3] | 0);
+    }
+    return sum;
+}
+
+function fillPixels(ta, start, end, v) {
+    for (var i = start; i < end; i++) {
+        ta[i * 4] = v;
+        ta[i * 4 + 3] = v;
+    }
+}
+
+function expectedSum(ta, start, end) {
+    var sum = 0;
+    for (var i = start; i < end; i++) {
+        for (var c = 0; c < 4; c++) {
+            var index = i * 4 + c;
+            if (index >= 0 && index < ta.length)
+                sum += ta[index];
+        }
+    }
+    return sum;
+}
+
+var pixels = new Uint8Array(64);
+for (var i = 0; i < pixels.length; i++)
+    pixels[i] = i;
+
+// In bounds, so the hoisted check succeeds.
+for (var i = 0; i < 200; i++)
+    assertEq(sumPixels(pixels, 0, 16), expectedSum(pixels, 0, 16));
+
+// The last iterations read past the end.
+for (var i = 0; i < 50; i++) {
+    assertEq(sumPixels(pixels, 0, 16), expectedSum(pixels, 0, 16));
+    assertEq(sumPixels(pixels, 10, 20), expectedSum(pixels, 10, 20));
+}
+
+// The first iterations read before the start.
+for (var i = 0; i < 50; i++) {
+    assertEq(sumPixels(pixels, 0, 16), expectedSum(pixels, 0, 16));
+    assertEq(sumPixels(pixels, -3, 4), expectedSum(pixels, -3, 4));
+}
+
+// i * 4 overflows int32.
+for (var i = 0; i < 50; i++) {
+    assertEq(sumPixels(pixels, 0, 16), expectedSum(pixels, 0, 16));
+    assertEq(sumPixels(pixels, 0x1fffffff, 0x20000002), 0);
+    assertEq(sumPixels(pixels, -0x20000002, -0x1fffffff), 0);
+}
+
+// Out-of-bounds stores are ignored.
+var small = new Uint8Array(16);
+for (var i = 0; i < 200; i++)
+    fillPixels(small, 0, 4, i & 0xff);
+fillPixels(small, 2, 8, 7);
+assertEq(small.length, 16);
+assertEq(small[8], 7);
+assertEq(small[11], 7);
+assertEq(small[12], 7);
+assertEq(small[15], 7);
+fillPixels(small, -2, 1, 9);
+assertEq(small[0], 9);
+assertEq(small[3], 9);
+
+// Dense elements whose length changes inside the loop.
+function sumShrinking(arr, shrinkAt) {
+    var sum = 0;
+    for (var i = 0; i < 8; i++) {
+        if (i === shrinkAt)
+            arr.length = 10;
+        sum += (arr[i * 2] | 0) + (arr[i * 2 + 1] | 0);
+    }
+    return sum;
+}
+
+function makeArray() {
+    var arr = [];
+    for (var i = 0; i < 16; i++)
+        arr.push(i + 1);
+    return arr;
+}
+
+for (var i = 0; i < 200; i++)
+    assertEq(sumShrinking(makeArray(), -1), 136);
+for (var i = 0; i < 50; i++) {
+    assertEq(sumShrinking(makeArray(), -1), 136);
+    // Elements 10 to 15 are gone once the length is 10.
+    assertEq(sumShrinking(makeArray(), 3), 55);
+}
@@ -0,0 +1,83 @@
+// Arrays grown with push in the block of their allocation are scalar
+// replaced, and are recovered with the pushed elements on bailout.
+
+// Ion eager runs the loop body before baseline has attached the ICs which
+// provide the template objects.
+if (getJitCompilerOptions()["ion.warmup.trigger"] <= 100)
+    setJitCompilerOption("ion.warmup.trigger", 100);
+
+// Inline caches would hide the element accesses from scalar replacement.
+if (getJitCompilerOptions()["ion.forceinlineCaches"])
+    setJitCompilerOption("ion.forceinlineCaches", 0);
+
+var uceFault = function (i) {
+    if (i > 98)
+        uceFault = function (i) { return true; };
+    return false;
+};
+
+var uceFault_pushEmpty = eval(`(${uceFault})`.replace('uceFault', 'uceFault_pushEmpty'));
+function pushEmpty(i) {
+    var a = [];
+    a.push(i);
+    a.push(i + 1);
+    if (uceFault_pushEmpty(i) || uceFault_pushEmpty(i)) {
+        assertEq(a.length, 2);
+        assertEq(a[0], i);
+        assertEq(a[1], i + 1);
+    }
+    assertRecoveredOnBailout(a, true);
+    return a[0] + a[1];
+}
+
+var uceFault_pushLiteral = eval(`(${uceFault})`.replace('uceFault', 'uceFault_pushLiteral'));
+function pushLiteral(i) {
+    var a = [i, i];
+    a.push(i * 2);
+    if (uceFault_pushLiteral(i) || uceFault_pushLiteral(i)) {
+        assertEq(a.length, 3);
+        assertEq(a[2], i * 2);
+    }
+    assertRecoveredOnBailout(a, true);
+    return a.length + a[2];
+}
+
+var uceFault_pushResult = eval(`(${uceFault})`.replace('uceFault', 'uceFault_pushResult'));
+function pushResult(i) {
+    var a = [i];
+    var len = a.push(i);
+    if (uceFault_pushResult(i) || uceFault_pushResult(i)) {
+        assertEq(len, 2);
+        assertEq(a.length, 2);
+        assertEq(a[1], i);
+    }
+    assertRecoveredOnBailout(a, true);
+    return len;
+}
+
+// Arrays with a hole can't be emulated, as the push would not append to a
+// fully initialized array.
+function pushSparse(i) {
+    var a = new Array(2);
+    a.push(i);
+    assertRecoveredOnBailout(a, false);
+    return a.length;
+}
+
+// Pushing past the element limit of scalar replacement escapes.
+function pushMany(i) {
+    var a = [];
+    a.push(i, i, i, i, i, i, i, i);
+    a.push(i, i, i, i, i, i, i, i);
+    a.push(i);
+    assertRecoveredOnBailout(a, false);
+    return a.length;
+}
+
+for (var i = 0; i < 200; i++) {
+    assertEq(pushEmpty(i), 2 * i + 1);
+    assertEq(pushLiteral(i), 3 + 2 * i);
+    assertEq(pushResult(i), 2);
+    assertEq(pushSparse(i), 3);
+    assertEq(pushMany(i), 17);
+}
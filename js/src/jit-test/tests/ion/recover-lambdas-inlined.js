@@ -0,0 +1,57 @@
+// Call objects captured by closures which are called inline are scalar
+// replaced, and are recovered on bailout.
+
+if (getJitCompilerOptions()["ion.warmup.trigger"] <= 100)
+    setJitCompilerOption("ion.warmup.trigger", 100);
+
+var uceFault = function (i) {
+    if (i > 98)
+        uceFault = function (i) { return true; };
+    return false;
+};
+
+var uceFault_inlined = eval(`(${uceFault})`.replace('uceFault', 'uceFault_inlined'));
+function inlinedClosure(i) {
+    var x = i;
+    var f = function () { return x + 1; };
+    var r = f();
+    if (uceFault_inlined(i) || uceFault_inlined(i)) {
+        // The recovered closure still sees the recovered call object.
+        assertEq(f(), i + 1);
+    }
+    assertRecoveredOnBailout(f, true);
+    return r;
+}
+
+var uceFault_mutated = eval(`(${uceFault})`.replace('uceFault', 'uceFault_mutated'));
+function mutatedByClosure(i) {
+    var x = i;
+    var inc = function () { x++; };
+    inc();
+    inc();
+    var r = x;
+    if (uceFault_mutated(i) || uceFault_mutated(i)) {
+        assertEq(x, i + 2);
+        inc();
+        assertEq(x, i + 3);
+    }
+    assertRecoveredOnBailout(inc, true);
+    return r;
+}
+
+// A closure which flows out of the function escapes.
+var escaped;
+function escapingClosure(i) {
+    var x = i;
+    var f = function () { return x; };
+    escaped = f;
+    assertRecoveredOnBailout(f, false);
+    return f();
+}
+
+for (var i = 0; i < 200; i++) {
+    assertEq(inlinedClosure(i), i + 1);
+    assertEq(mutatedByClosure(i), i + 2);
+    assertEq(escapingClosure(i), i);
+}
+assertEq(escaped(), 199);
@@ -11843,7 +11843,11 @@ static gc::AllocSite* MaybeCreateAllocSite(jsbytecode* pc,
     return outerScript->zone()->unknownAllocSite();
   }
 
-  return outerScript->createAllocSite();
+  // For inlined frames the pc is in the inlined script, not the outer script
+  // that owns the site.
+  uint32_t pcOffset = isInlined ? gc::AllocSite::InvalidPCOffset
+                                : outerScript->pcToOffset(pc);
+  return outerScript->createAllocSite(pcOffset);
 }
 
 AttachDecision NewArrayIRGenerator::tryAttachArrayObject() {
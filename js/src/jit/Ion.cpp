@@ -13,6 +13,7 @@
 #include "mozilla/ThreadLocal.h"
 
 #include "gc/GCContext.h"
+#include "gc/Pretenuring.h"
 #include "gc/PublicIterators.h"
 #include "jit/AliasAnalysis.h"
 #include "jit/AlignmentMaskAnalysis.h"
@@ -499,6 +500,52 @@ bool RecompileInfo::traceWeak(JSTracer* trc) {
 void JitZone::traceWeak(JSTracer* trc) {
   baselineCacheIRStubCodes_.traceWeak(trc);
   inlinedCompilations_.traceWeak(trc);
+  pretenuredAllocSites_.traceWeak(trc);
+}
+
+void JitZone::rememberPretenuredAllocSites(JSScript* script,
+                                          JitScript* jitScript) {
+  PretenuredAllocSiteVector sites;
+  for (gc::AllocSite* site : jitScript->allocSites()) {
+    if (site->initialHeap() != gc::TenuredHeap || !site->hasPCOffset()) {
+      continue;
+    }
+    if (!sites.append(
+            PretenuredAllocSite{site->pcOffset(), site->numInvalidations()})) {
+      return;
+    }
+  }
+
+  if (sites.empty()) {
+    pretenuredAllocSites_.remove(script);
+    return;
+  }
+
+  (void)pretenuredAllocSites_.put(script, std::move(sites));
+}
+
+void JitZone::maybeRestorePretenuredAllocSite(JSScript* script,
+                                             gc::AllocSite* site) {
+  MOZ_ASSERT(site->script() == script);
+  MOZ_ASSERT(site->hasPCOffset());
+
+  auto p = pretenuredAllocSites_.lookup(script);
+  if (!p) {
+    return;
+  }
+
+  PretenuredAllocSiteVector& sites = p->value();
+  for (size_t i = 0; i < sites.length(); i++) {
+    if (sites[i].pcOffset == site->pcOffset()) {
+      site->restoreLongLivedState(sites[i].numInvalidations);
+      sites.erase(&sites[i]);
+      break;
+    }
+  }
+
+  if (sites.empty()) {
+    pretenuredAllocSites_.remove(p);
+  }
 }
 
 size_t JitRealm::sizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf) const {
@@ -63,7 +63,15 @@ IonCompileTask::IonCompileTask(JSContext* cx, MIRGenerator& mirGen,
                                WarpSnapshot* snapshot)
     : mirGen_(mirGen),
       snapshot_(snapshot),
-      isExecuting_(cx->isExecutingRef()) {}
+      isExecuting_(cx->isExecutingRef()),
+      initialWarmUpCount_(script()->jitScript()->warmUpCount()),
+      creationTime_(mozilla::TimeStamp::Now()) {}
+
+uint32_t IonCompileTask::warmUpCountSinceCreation() {
+  // The count may have been reset, e.g. to delay Ion compilation.
+  uint32_t count = script()->jitScript()->warmUpCount();
+  return count > initialWarmUpCount_ ? count - initialWarmUpCount_ : 0;
+}
 
 size_t IonCompileTask::sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) {
   // See js::jit::FreeIonCompileTask.
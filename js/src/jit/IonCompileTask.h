@@ -8,6 +8,7 @@
 #define jit_IonCompileTask_h
 
 #include "mozilla/LinkedList.h"
+#include "mozilla/TimeStamp.h"
 
 #include "jit/MIRGenerator.h"
 
@@ -40,6 +41,12 @@ class IonCompileTask final : public HelperThreadTask,
   // removed from the helper threads. Thus this should be safe.
   const mozilla::Atomic<bool, mozilla::ReleaseAcquire>& isExecuting_;
 
+  // The script's warm-up count and the time when this task was created. These
+  // measure how quickly the script is still warming up while the task waits to
+  // be compiled.
+  uint32_t initialWarmUpCount_;
+  mozilla::TimeStamp creationTime_;
+
  public:
   explicit IonCompileTask(JSContext* cx, MIRGenerator& mirGen,
                           WarpSnapshot* snapshot);
@@ -61,6 +68,11 @@ class IonCompileTask final : public HelperThreadTask,
   // executing JS code. This changes the way we prioritize tasks.
   bool isMainThreadRunningJS() const { return isExecuting_; }
 
+  // The number of warm-up counts the script gained since this task was
+  // created. This may race with the main thread.
+  uint32_t warmUpCountSinceCreation();
+  mozilla::TimeStamp creationTime() const { return creationTime_; }
+
   ThreadType threadType() override { return THREAD_TYPE_ION; }
   void runTask();
   void runHelperThreadTask(AutoLockHelperThreadState& locked) override;
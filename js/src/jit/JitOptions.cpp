@@ -214,6 +214,11 @@ DefaultJitOptions::DefaultJitOptions() {
   // invalidating the script.
   SET_DEFAULT(osrPcMismatchesBeforeRecompile, 6000);
 
+  // How long, in milliseconds, an off-thread Ion compilation may wait in the
+  // worklist while its script does not run at all before it is cancelled.
+  // Zero disables cancellation.
+  SET_DEFAULT(staleIonCompileTimeoutMs, 1000);
+
   // The bytecode length limit for small function.
   SET_DEFAULT(smallFunctionMaxBytecodeLength, 130);
 
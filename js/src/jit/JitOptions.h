@@ -97,6 +97,7 @@ struct DefaultJitOptions {
   uint32_t frequentBailoutThreshold;
   uint32_t maxStackArgs;
   uint32_t osrPcMismatchesBeforeRecompile;
+  uint32_t staleIonCompileTimeoutMs;
   uint32_t smallFunctionMaxBytecodeLength;
   uint32_t inliningEntryThreshold;
   uint32_t jumpThreshold;
@@ -17,6 +17,7 @@
 #include "jit/IonScript.h"
 #include "jit/JitFrames.h"
 #include "jit/JitSpewer.h"
+#include "jit/JitZone.h"
 #include "jit/ScriptFromCalleeToken.h"
 #include "jit/TrialInlining.h"
 #include "vm/BytecodeUtil.h"
@@ -625,7 +626,8 @@ InliningRoot* JitScript::getOrCreateInliningRoot(JSContext* cx,
   return inliningRoot_.get();
 }
 
-gc::AllocSite* JitScript::createAllocSite(JSScript* script) {
+gc::AllocSite* JitScript::createAllocSite(JSScript* script,
+                                          uint32_t pcOffset) {
   MOZ_ASSERT(script->jitScript() == this);
 
   Nursery& nursery = script->runtimeFromMainThread()->gc.nursery();
@@ -646,7 +648,15 @@ gc::AllocSite* JitScript::createAllocSite(JSScript* script) {
     return nullptr;
   }
 
-  new (site) gc::AllocSite(script->zone(), script);
+  new (site) gc::AllocSite(script->zone(), script, pcOffset);
+
+  // If we previously found this site to be long lived before its JitScript was
+  // discarded, start off pretenuring rather than relearning that.
+  if (site->hasPCOffset()) {
+    if (JitZone* jitZone = script->zone()->jitZone()) {
+      jitZone->maybeRestorePretenuredAllocSite(script, site);
+    }
+  }
 
   allocSites_.infallibleAppend(site);
 
@@ -454,10 +454,14 @@ class alignas(uintptr_t) JitScript final : public TrailingArray {
     return cachedIonData().bytecodeInfo.usesEnvironmentChain;
   }
 
-  gc::AllocSite* createAllocSite(JSScript* script);
+  gc::AllocSite* createAllocSite(JSScript* script, uint32_t pcOffset);
 
   bool resetAllocSites(bool resetNurserySites, bool resetPretenuredSites);
 
+  const Vector<gc::AllocSite*, 0, SystemAllocPolicy>& allocSites() const {
+    return allocSites_;
+  }
+
  private:
   // Methods to set baselineScript_ to a BaselineScript*, nullptr, or
   // BaselineDisabledScriptPtr.
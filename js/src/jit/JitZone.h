@@ -34,11 +34,17 @@ struct CodeSizes;
 }
 
 namespace js {
+
+namespace gc {
+class AllocSite;
+}  // namespace gc
+
 namespace jit {
 
 enum class CacheKind : uint8_t;
 class CacheIRStubInfo;
 class JitCode;
+class JitScript;
 
 enum class ICStubEngine : uint8_t {
   // Baseline IC, see BaselineIC.h.
@@ -81,6 +87,23 @@ struct BaselineCacheIRStubCodeMapGCPolicy {
   }
 };
 
+// The bytecode offset and invalidation count of an allocation site that was
+// pretenured when its JitScript was discarded.
+struct PretenuredAllocSite {
+  uint32_t pcOffset;
+  uint32_t numInvalidations;
+};
+
+using PretenuredAllocSiteVector =
+    Vector<PretenuredAllocSite, 1, SystemAllocPolicy>;
+
+struct PretenuredAllocSiteMapGCPolicy {
+  static bool traceWeak(JSTracer* trc, WeakHeapPtr<BaseScript*>* script,
+                        PretenuredAllocSiteVector* sites) {
+    return TraceWeakEdge(trc, script, "traceWeak");
+  }
+};
+
 class JitZone {
   // Allocated space for optimized baseline stubs.
   OptimizedICStubSpace optimizedStubSpace_;
@@ -105,6 +128,16 @@ class JitZone {
                 MovableCellHasher<WeakHeapPtr<BaseScript*>>, SystemAllocPolicy>;
   InlinedScriptMap inlinedCompilations_;
 
+  // Allocation sites live in the JitScript and are lost when it is discarded.
+  // To avoid having to relearn that a site's allocations are long lived,
+  // remember which sites were pretenured so that they can start off
+  // pretenured when they are next created.
+  using PretenuredAllocSiteMap =
+      GCHashMap<WeakHeapPtr<BaseScript*>, PretenuredAllocSiteVector,
+                MovableCellHasher<WeakHeapPtr<BaseScript*>>, SystemAllocPolicy,
+                PretenuredAllocSiteMapGCPolicy>;
+  PretenuredAllocSiteMap pretenuredAllocSites_;
+
   mozilla::Maybe<IonCompilationId> currentCompilationId_;
   bool keepJitScripts_ = false;
 
@@ -165,6 +198,12 @@ class JitZone {
     inlinedCompilations_.remove(inlined);
   }
 
+  // Record the long lived allocation sites of a JitScript that is about to be
+  // discarded. This is an optimization and is skipped on OOM.
+  void rememberPretenuredAllocSites(JSScript* script, JitScript* jitScript);
+  void maybeRestorePretenuredAllocSite(JSScript* script, gc::AllocSite* site);
+  void clearPretenuredAllocSites() { pretenuredAllocSites_.clearAndCompact(); }
+
   bool keepJitScripts() const { return keepJitScripts_; }
   void setKeepJitScripts(bool keep) { keepJitScripts_ = keep; }
 
@@ -4568,15 +4568,18 @@ MObjectState* MObjectState::Copy(TempAllocator& alloc, MObjectState* state) {
   return res;
 }
 
-MArrayState::MArrayState(MDefinition* arr) : MVariadicInstruction(classOpcode) {
+MArrayState::MArrayState(MDefinition* arr, uint32_t numElements)
+    : MVariadicInstruction(classOpcode), numElements_(numElements) {
   // This instruction is only used as a summary for bailout paths.
   setResultType(MIRType::Object);
   setRecoveredOnBailout();
+#ifdef DEBUG
   if (arr->isNewArrayObject()) {
-    numElements_ = arr->toNewArrayObject()->length();
+    MOZ_ASSERT(numElements_ >= arr->toNewArrayObject()->length());
   } else {
-    numElements_ = arr->toNewArray()->length();
+    MOZ_ASSERT(numElements_ >= arr->toNewArray()->length());
   }
+#endif
 }
 
 bool MArrayState::init(TempAllocator& alloc, MDefinition* obj,
@@ -4599,8 +4602,8 @@ void MArrayState::initFromTemplateObject(TempAllocator& alloc,
 }
 
 MArrayState* MArrayState::New(TempAllocator& alloc, MDefinition* arr,
-                              MDefinition* initLength) {
-  MArrayState* res = new (alloc) MArrayState(arr);
+                              MDefinition* initLength, uint32_t numElements) {
+  MArrayState* res = new (alloc) MArrayState(arr, numElements);
   if (!res || !res->init(alloc, arr, initLength)) {
     return nullptr;
   }
@@ -4610,7 +4613,7 @@ MArrayState* MArrayState::New(TempAllocator& alloc, MDefinition* arr,
 MArrayState* MArrayState::Copy(TempAllocator& alloc, MArrayState* state) {
   MDefinition* arr = state->array();
   MDefinition* len = state->initializedLength();
-  MArrayState* res = new (alloc) MArrayState(arr);
+  MArrayState* res = new (alloc) MArrayState(arr, state->numElements());
   if (!res || !res->init(alloc, arr, len)) {
     return nullptr;
   }
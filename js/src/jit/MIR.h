@@ -2111,7 +2111,7 @@ class MArrayState : public MVariadicInstruction,
  private:
   uint32_t numElements_;
 
-  explicit MArrayState(MDefinition* arr);
+  MArrayState(MDefinition* arr, uint32_t numElements);
 
   [[nodiscard]] bool init(TempAllocator& alloc, MDefinition* obj,
                           MDefinition* len);
@@ -2124,8 +2124,11 @@ class MArrayState : public MVariadicInstruction,
   INSTRUCTION_HEADER(ArrayState)
   NAMED_OPERANDS((0, array), (1, initializedLength))
 
+  // |numElements| is the number of elements emulated by the state, which can
+  // be larger than the length of the allocation when the array is grown by
+  // MArrayPush.
   static MArrayState* New(TempAllocator& alloc, MDefinition* arr,
-                          MDefinition* initLength);
+                          MDefinition* initLength, uint32_t numElements);
   static MArrayState* Copy(TempAllocator& alloc, MArrayState* state);
 
   void initFromTemplateObject(TempAllocator& alloc, MDefinition* undefinedVal);
@@ -2287,31 +2287,58 @@ bool RangeAnalysis::tryHoistBoundsCheck(MBasicBlock* header,
     return false;
   }
 
+  // Strided accesses, such as |ta[i * 4 + c]| in pixel loops, use a constant
+  // multiple of the term which has symbolic bounds. Scale its bounds by the
+  // stride, which has to be positive to preserve the order of the bounds.
+  MDefinition* term = index.term;
+  int32_t stride = 1;
+  if (term->isMul() && term->type() == MIRType::Int32) {
+    MDefinition* lhs = term->toMul()->lhs();
+    MDefinition* rhs = term->toMul()->rhs();
+    if (lhs->isConstant()) {
+      std::swap(lhs, rhs);
+    }
+    if (rhs->isConstant() && rhs->type() == MIRType::Int32 &&
+        rhs->toConstant()->toInt32() > 0 && lhs->type() == MIRType::Int32) {
+      term = DefinitionOrBetaInputDefinition(lhs);
+      stride = rhs->toConstant()->toInt32();
+      if (!term->block()->isMarked()) {
+        return false;
+      }
+    }
+  }
+
   // Check for a symbolic lower and upper bound on the index. If either
   // condition depends on an iteration bound for the loop, only hoist if
   // the bounds check is dominated by the iteration bound's test.
-  if (!index.term->range()) {
+  if (!term->range()) {
     return false;
   }
-  const SymbolicBound* lower = index.term->range()->symbolicLower();
+  const SymbolicBound* lower = term->range()->symbolicLower();
   if (!lower || !SymbolicBoundIsValid(header, ins, lower)) {
     return false;
   }
-  const SymbolicBound* upper = index.term->range()->symbolicUpper();
+  const SymbolicBound* upper = term->range()->symbolicUpper();
   if (!upper || !SymbolicBoundIsValid(header, ins, upper)) {
     return false;
   }
 
+  LinearSum lowerSum(lower->sum);
+  LinearSum upperSum(upper->sum);
+  if (!lowerSum.multiply(stride) || !upperSum.multiply(stride)) {
+    return false;
+  }
+
   MBasicBlock* preLoop = header->loopPredecessor();
   MOZ_ASSERT(!preLoop->isMarked());
 
-  MDefinition* lowerTerm = ConvertLinearSum(alloc(), preLoop, lower->sum,
+  MDefinition* lowerTerm = ConvertLinearSum(alloc(), preLoop, lowerSum,
                                             BailoutKind::HoistBoundsCheck);
   if (!lowerTerm) {
     return false;
   }
 
-  MDefinition* upperTerm = ConvertLinearSum(alloc(), preLoop, upper->sum,
+  MDefinition* upperTerm = ConvertLinearSum(alloc(), preLoop, upperSum,
                                             BailoutKind::HoistBoundsCheck);
   if (!upperTerm) {
     return false;
@@ -2327,7 +2354,7 @@ bool RangeAnalysis::tryHoistBoundsCheck(MBasicBlock* header,
   if (!SafeSub(lowerConstant, index.constant, &lowerConstant)) {
     return false;
   }
-  if (!SafeSub(lowerConstant, lower->sum.constant(), &lowerConstant)) {
+  if (!SafeSub(lowerConstant, lowerSum.constant(), &lowerConstant)) {
     return false;
   }
 
@@ -2337,7 +2364,7 @@ bool RangeAnalysis::tryHoistBoundsCheck(MBasicBlock* header,
   // upperTerm + upperConstant < boundsLength
 
   int32_t upperConstant = index.constant;
-  if (!SafeAdd(upper->sum.constant(), upperConstant, &upperConstant)) {
+  if (!SafeAdd(upperSum.constant(), upperConstant, &upperConstant)) {
     return false;
   }
 
@@ -1793,9 +1793,20 @@ RArrayState::RArrayState(CompactBufferReader& reader) {
 
 bool RArrayState::recover(JSContext* cx, SnapshotIterator& iter) const {
   RootedValue result(cx);
-  ArrayObject* object = &iter.read().toObject().as<ArrayObject>();
+  Rooted<ArrayObject*> object(cx,
+                              &iter.read().toObject().as<ArrayObject>());
   uint32_t initLength = iter.read().toInt32();
 
+  // Arrays grown by MArrayPush can have more elements than the capacity and
+  // length of the allocation. Elements are only pushed on fully initialized
+  // arrays, thus the initialized length is also the length of the array.
+  if (initLength > object->length()) {
+    if (!object->ensureElements(cx, initLength)) {
+      return false;
+    }
+    object->setLength(initLength);
+  }
+
   MOZ_ASSERT(object->getDenseInitializedLength() == 0,
              "initDenseElement call below relies on this");
   object->setDenseInitializedLength(initLength);
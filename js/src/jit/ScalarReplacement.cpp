@@ -155,7 +155,8 @@ static bool IsObjectEscaped(MDefinition* ins, MInstruction* newObject,
 // ScalarReplacementOfObject.
 static bool IsLambdaEscaped(MInstruction* lambda, MInstruction* newObject,
                             const Shape* shape) {
-  MOZ_ASSERT(lambda->isLambda() || lambda->isFunctionWithProto());
+  MOZ_ASSERT(lambda->isLambda() || lambda->isFunctionWithProto() ||
+             lambda->isGuardFunctionScript());
   MOZ_ASSERT(IsOptimizableObjectInstruction(newObject));
   JitSpewDef(JitSpew_Escape, "Check lambda\n", lambda);
   JitSpewIndent spewIndent(JitSpew_Escape);
@@ -174,6 +175,24 @@ static bool IsLambdaEscaped(MInstruction* lambda, MInstruction* newObject,
     }
 
     MDefinition* def = consumer->toDefinition();
+
+    // Calls to the lambda which are inlined by TrialInlining are guarded by
+    // the script of the callee, and the inlined body only accesses the
+    // scope chain through the guard.
+    if (def->isGuardFunctionScript() && lambda->isLambda()) {
+      auto* guard = def->toGuardFunctionScript();
+      JSFunction* fun = lambda->toLambda()->templateFunction();
+      if (guard->expected() != fun->baseScript()) {
+        JitSpewDef(JitSpew_Escape, "has a non-matching script guard\n", def);
+        return true;
+      }
+      if (IsLambdaEscaped(guard, newObject, shape)) {
+        JitSpewDef(JitSpew_Escape, "is indirectly escaped by\n", def);
+        return true;
+      }
+      continue;
+    }
+
     if (!def->isFunctionEnvironment()) {
       JitSpewDef(JitSpew_Escape, "is escaped by\n", def);
       return true;
@@ -406,6 +425,7 @@ class ObjectMemoryView : public MDefinitionVisitorDefaultNoop {
   void visitCheckIsObj(MCheckIsObj* ins);
   void visitUnbox(MUnbox* ins);
   void visitFunctionEnvironment(MFunctionEnvironment* ins);
+  void visitGuardFunctionScript(MGuardFunctionScript* ins);
   void visitLambda(MLambda* ins);
   void visitFunctionWithProto(MFunctionWithProto* ins);
   void visitPhi(MPhi* ins);
@@ -774,6 +794,25 @@ void ObjectMemoryView::visitFunctionEnvironment(MFunctionEnvironment* ins) {
   ins->block()->discard(ins);
 }
 
+void ObjectMemoryView::visitGuardFunctionScript(MGuardFunctionScript* ins) {
+  // Skip guards which are not on a lambda capturing the NewCallObject.
+  MDefinition* input = ins->input();
+  if (!input->isLambda() || input->toLambda()->environmentChain() != obj_) {
+    return;
+  }
+
+  // The script of the lambda is known, as checked by IsLambdaEscaped.
+  MOZ_ASSERT(input->toLambda()->templateFunction()->baseScript() ==
+             ins->expected());
+
+  // Replace the guard by the lambda, such that the function environment can
+  // be replaced by the scope chain.
+  ins->replaceAllUsesWith(input);
+
+  // Remove original instruction.
+  ins->block()->discard(ins);
+}
+
 void ObjectMemoryView::visitLambda(MLambda* ins) {
   if (ins->environmentChain() != obj_) {
     return;
@@ -979,11 +1018,71 @@ static bool IsElementEscaped(MDefinition* def, MInstruction* newArray,
   return false;
 }
 
+// Follow the guards and unboxes which IsArrayEscaped looks through, to find
+// the allocation aliased by |def|.
+static MDefinition* SkipArrayGuards(MDefinition* def) {
+  while (def->isGuardShape() || def->isGuardToClass() ||
+         def->isGuardArrayIsPacked() || def->isUnbox()) {
+    def = def->getOperand(0);
+  }
+  return def;
+}
+
+// Returns False if the MArrayPush instructions of |newArray| cannot be
+// emulated by ArrayMemoryView. Otherwise |numPushes| is set to the number of
+// elements appended to the array.
+//
+// Pushes are emulated with constant indices. Thus, they have to be in the
+// block of the allocation, and have to append to a fully initialized array.
+static bool CountArrayPushes(MInstruction* newArray, uint32_t length,
+                             uint32_t* numPushes) {
+  *numPushes = 0;
+  uint32_t initLength = 0;
+
+  MBasicBlock* block = newArray->block();
+  for (MInstructionIterator iter(block->begin(newArray)); iter != block->end();
+       iter++) {
+    if (iter->isSetInitializedLength()) {
+      MSetInitializedLength* ins = iter->toSetInitializedLength();
+      MDefinition* elements = ins->elements();
+      if (!elements->isElements() ||
+          SkipArrayGuards(elements->toElements()->object()) != newArray) {
+        continue;
+      }
+
+      MConstant* index = ins->index()->maybeConstantValue();
+      if (!index || index->type() != MIRType::Int32) {
+        return false;
+      }
+      initLength = index->toInt32() + 1;
+      continue;
+    }
+
+    if (iter->isArrayPush()) {
+      MArrayPush* ins = iter->toArrayPush();
+      if (SkipArrayGuards(ins->object()) != newArray) {
+        continue;
+      }
+
+      if (initLength != length + *numPushes) {
+        JitSpewDef(JitSpew_Escape, "pushes on a partially initialized array\n",
+                   ins);
+        return false;
+      }
+      initLength++;
+      (*numPushes)++;
+    }
+  }
+
+  return true;
+}
+
 // Returns False if the array is not escaped and if it is optimizable by
 // ScalarReplacementOfArray.
 //
-// For the moment, this code is dumb as it only supports arrays which are not
-// changing length, with only access with known constants.
+// For the moment, this code is dumb as it only supports arrays which are only
+// growing by MArrayPush in the block of the allocation, with only access with
+// known constants.
 static bool IsArrayEscaped(MInstruction* ins, MInstruction* newArray) {
   MOZ_ASSERT(ins->type() == MIRType::Object);
   MOZ_ASSERT(IsOptimizableArrayInstruction(newArray));
@@ -1006,6 +1105,13 @@ static bool IsArrayEscaped(MInstruction* ins, MInstruction* newArray) {
     shape = templateObject->shape();
   }
 
+  uint32_t numPushes;
+  if (!CountArrayPushes(newArray, length, &numPushes)) {
+    JitSpew(JitSpew_Escape, "Array has unsupported pushes");
+    return true;
+  }
+  length += numPushes;
+
   if (length >= 16) {
     JitSpew(JitSpew_Escape, "Array has too many elements");
     return true;
@@ -1105,6 +1211,21 @@ static bool IsArrayEscaped(MInstruction* ins, MInstruction* newArray) {
       case MDefinition::Opcode::PostWriteElementBarrier:
         break;
 
+      // Pushes have been checked by CountArrayPushes, as long as they are in
+      // the block of the allocation.
+      case MDefinition::Opcode::ArrayPush: {
+        MArrayPush* push = def->toArrayPush();
+        if (push->value() == ins) {
+          JitSpewDef(JitSpew_Escape, "is pushed by\n", def);
+          return true;
+        }
+        if (push->block() != newArray->block()) {
+          JitSpewDef(JitSpew_Escape, "is pushed in another block by\n", def);
+          return true;
+        }
+        break;
+      }
+
       // This instruction is a no-op used to verify that scalar replacement
       // is working as expected in jit-test.
       case MDefinition::Opcode::AssertRecoveredOnBailout:
@@ -1120,9 +1241,10 @@ static bool IsArrayEscaped(MInstruction* ins, MInstruction* newArray) {
   return false;
 }
 
-// This class replaces every MStoreElement and MSetInitializedLength by an
-// MArrayState which emulates the content of the array. All MLoadElement,
-// MInitializedLength and MArrayLength are replaced by the corresponding value.
+// This class replaces every MStoreElement, MSetInitializedLength and
+// MArrayPush by an MArrayState which emulates the content of the array. All
+// MLoadElement, MInitializedLength and MArrayLength are replaced by the
+// corresponding value.
 //
 // In order to restore the value of the array correctly in case of bailouts, we
 // replace all reference of the allocation by the MArrayState definition.
@@ -1136,6 +1258,10 @@ class ArrayMemoryView : public MDefinitionVisitorDefaultNoop {
   MConstant* undefinedVal_;
   MConstant* length_;
   MInstruction* arr_;
+
+  // Length of the array, which is incremented by each MArrayPush.
+  uint32_t arrayLength_;
+
   MBasicBlock* startBlock_;
   BlockState* state_;
 
@@ -1174,6 +1300,7 @@ class ArrayMemoryView : public MDefinitionVisitorDefaultNoop {
   void visitSetInitializedLength(MSetInitializedLength* ins);
   void visitInitializedLength(MInitializedLength* ins);
   void visitArrayLength(MArrayLength* ins);
+  void visitArrayPush(MArrayPush* ins);
   void visitPostWriteBarrier(MPostWriteBarrier* ins);
   void visitPostWriteElementBarrier(MPostWriteElementBarrier* ins);
   void visitGuardShape(MGuardShape* ins);
@@ -1192,6 +1319,7 @@ ArrayMemoryView::ArrayMemoryView(TempAllocator& alloc, MInstruction* arr)
       undefinedVal_(nullptr),
       length_(nullptr),
       arr_(arr),
+      arrayLength_(0),
       startBlock_(arr->block()),
       state_(nullptr),
       lastResumePoint_(nullptr),
@@ -1213,8 +1341,18 @@ bool ArrayMemoryView::initStartingState(BlockState** pState) {
   arr_->block()->insertBefore(arr_, undefinedVal_);
   arr_->block()->insertBefore(arr_, initLength);
 
+  // Reserve space in the state for the elements appended by MArrayPush.
+  if (arr_->isNewArrayObject()) {
+    arrayLength_ = arr_->toNewArrayObject()->length();
+  } else {
+    arrayLength_ = arr_->toNewArray()->length();
+  }
+  uint32_t numPushes;
+  MOZ_ALWAYS_TRUE(CountArrayPushes(arr_, arrayLength_, &numPushes));
+
   // Create a new block state and insert at it at the location of the new array.
-  BlockState* state = BlockState::New(alloc_, arr_, initLength);
+  BlockState* state =
+      BlockState::New(alloc_, arr_, initLength, arrayLength_ + numPushes);
   if (!state) {
     return false;
   }
@@ -1450,7 +1588,7 @@ void ArrayMemoryView::visitArrayLength(MArrayLength* ins) {
 
   // Replace by the value of the length.
   if (!length_) {
-    length_ = MConstant::New(alloc_, Int32Value(state_->numElements()));
+    length_ = MConstant::New(alloc_, Int32Value(arrayLength_));
     arr_->block()->insertBefore(arr_, length_);
   }
   ins->replaceAllUsesWith(length_);
@@ -1459,6 +1597,41 @@ void ArrayMemoryView::visitArrayLength(MArrayLength* ins) {
   discardInstruction(ins, elements);
 }
 
+void ArrayMemoryView::visitArrayPush(MArrayPush* ins) {
+  // Skip other array objects.
+  if (ins->object() != arr_) {
+    return;
+  }
+
+  // IsArrayEscaped only accepts pushes in the block of the allocation, which
+  // append to a fully initialized array. Thus the index of the new element is
+  // the current length of the array.
+  MOZ_ASSERT(ins->block() == startBlock_);
+  MOZ_ASSERT(arrayLength_ < state_->numElements());
+  uint32_t index = arrayLength_++;
+
+  state_ = BlockState::Copy(alloc_, state_);
+  if (!state_) {
+    oom_ = true;
+    return;
+  }
+
+  // The new length is both the initialized length of the array and the result
+  // of the push.
+  MConstant* length = MConstant::New(alloc_, Int32Value(arrayLength_));
+  ins->block()->insertBefore(ins, length);
+  ins->block()->insertBefore(ins, state_);
+  state_->setElement(index, ins->value());
+  state_->setInitializedLength(length);
+  ins->replaceAllUsesWith(length);
+
+  // Later MArrayLength are using the new length.
+  length_ = length;
+
+  // Remove original instruction.
+  ins->block()->discard(ins);
+}
+
 void ArrayMemoryView::visitPostWriteBarrier(MPostWriteBarrier* ins) {
   // Skip barriers on other objects.
   if (ins->object() != arr_) {
@@ -1559,7 +1732,8 @@ void ArrayMemoryView::visitApplyArray(MApplyArray* ins) {
     return;
   }
 
-  uint32_t numElements = state_->numElements();
+  // Elements which are not yet pushed are not part of the arguments.
+  uint32_t numElements = arrayLength_;
 
   CallInfo callInfo(alloc_, /*constructing=*/false, ins->ignoresReturnValue());
   if (!callInfo.initForApplyArray(ins->getFunction(), ins->getThis(),
@@ -1605,7 +1779,8 @@ void ArrayMemoryView::visitConstructArray(MConstructArray* ins) {
     return;
   }
 
-  uint32_t numElements = state_->numElements();
+  // Elements which are not yet pushed are not part of the arguments.
+  uint32_t numElements = arrayLength_;
 
   CallInfo callInfo(alloc_, /*constructing=*/true, ins->ignoresReturnValue());
   if (!callInfo.initForConstructArray(ins->getFunction(), ins->getThis(),
@@ -447,3 +447,65 @@ BEGIN_TEST(testArrayBuffer_ArrayBufferClone) {
   return true;
 }
 END_TEST(testArrayBuffer_ArrayBufferClone)
+
+BEGIN_TEST(testArrayBuffer_transfer) {
+  // The methods are only defined when the realm option is set.
+  JS::RootedValue v(cx);
+  EVAL(
+      "'transfer' in ArrayBuffer.prototype ||"
+      " 'detached' in ArrayBuffer.prototype",
+      &v);
+  CHECK(v.isFalse());
+
+  JS::RealmOptions options;
+  options.creationOptions().setArrayBufferTransferEnabled(true);
+  JS::RootedObject transferGlobal(
+      cx, JS_NewGlobalObject(cx, getGlobalClass(), nullptr,
+                             JS::FireOnNewGlobalHook, options));
+  CHECK(transferGlobal);
+  JSAutoRealm ar(cx, transferGlobal);
+
+  // Grow and shrink a malloced buffer, then copy an inline one.
+  EVAL(
+      "var buf = new ArrayBuffer(1024);"
+      "var view = new Uint8Array(buf);"
+      "view[0] = 1; view[1023] = 2;"
+      "var grown = buf.transfer(4096);"
+      "var g = new Uint8Array(grown);"
+      "var shrunk = grown.transferToFixedLength(2);"
+      "var s = new Uint8Array(shrunk);"
+      "var small = new ArrayBuffer(8);"
+      "new Uint8Array(small)[7] = 3;"
+      "var copied = small.transfer();"
+      "[buf.detached, view.length, grown.byteLength, g[0], g[1023], g[1024],"
+      " g[4095], grown.detached, shrunk.byteLength, s[0], s[1],"
+      " small.detached, copied.byteLength, new Uint8Array(copied)[7],"
+      " copied.detached].join()",
+      &v);
+  CHECK(v.isString());
+  CHECK(JS_LinearStringEqualsLiteral(
+      JS_ASSERT_STRING_IS_LINEAR(v.toString()),
+      "true,0,4096,1,2,0,0,true,2,1,0,true,8,3,false"));
+
+  // Detached buffers can't be transferred again.
+  EVAL(
+      "var ok = false;"
+      "try { buf.transfer(); } catch (e) { ok = e instanceof TypeError; }"
+      "ok",
+      &v);
+  CHECK(v.isTrue());
+
+  // The length is converted before the detached check.
+  EVAL(
+      "var buf2 = new ArrayBuffer(100);"
+      "var len = { valueOf() { buf2.transfer(); return 10; } };"
+      "var threw = false;"
+      "try { buf2.transfer(len); }"
+      "catch (e) { threw = e instanceof TypeError; }"
+      "threw",
+      &v);
+  CHECK(v.isTrue());
+
+  return true;
+}
+END_TEST(testArrayBuffer_transfer)
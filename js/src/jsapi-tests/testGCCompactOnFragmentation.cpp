@@ -0,0 +1,85 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gc/GCRuntime.h"
+#include "js/PropertyAndElement.h"  // JS_GetProperty, JS_SetProperty
+#include "js/RootingAPI.h"
+#include "jsapi-tests/tests.h"
+#include "vm/Runtime.h"
+
+// Check that a non-shrinking GC compacts a fragmented zone when
+// JSGC_COMPACTING_FRAGMENTATION_THRESHOLD is set, and not otherwise.
+BEGIN_TEST(testGCCompactOnFragmentation) {
+  static const size_t NumObjects = 10000;
+  static const size_t KeepEvery = 10;
+
+  CHECK(JS_GetGCParameter(cx, JSGC_COMPACTING_FRAGMENTATION_THRESHOLD) == 0);
+
+  CHECK(fragmentHeap());
+  JS::PrepareForFullGC(cx);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Normal, JS::GCReason::API);
+  CHECK(!cx->runtime()->gc.isCompactingGc());
+  CHECK(checkObjects());
+
+  JS_SetGCParameter(cx, JSGC_COMPACTING_FRAGMENTATION_THRESHOLD, 10);
+  CHECK(JS_GetGCParameter(cx, JSGC_COMPACTING_FRAGMENTATION_THRESHOLD) == 10);
+
+  CHECK(fragmentHeap());
+  JS::PrepareForFullGC(cx);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Normal, JS::GCReason::API);
+  CHECK(cx->runtime()->gc.didCompactZones());
+  CHECK(checkObjects());
+
+  JS_ResetGCParameter(cx, JSGC_COMPACTING_FRAGMENTATION_THRESHOLD);
+  return true;
+}
+
+JS::PersistentRootedObjectVector* kept = nullptr;
+
+virtual void uninit() override {
+  delete kept;
+  kept = nullptr;
+  JSAPITest::uninit();
+}
+
+// Allocate many tenured objects and keep only a small fraction of them alive,
+// leaving most arenas sparsely used after the next GC.
+bool fragmentHeap() {
+  if (!kept) {
+    kept = new JS::PersistentRootedObjectVector(cx);
+  }
+  kept->clear();
+
+  JS::RootedObjectVector all(cx);
+  for (size_t i = 0; i < NumObjects; i++) {
+    JS::RootedObject obj(cx, JS_NewPlainObject(cx));
+    CHECK(obj);
+    JS::RootedValue value(cx, JS::Int32Value(int32_t(i)));
+    CHECK(JS_SetProperty(cx, obj, "i", value));
+    CHECK(all.append(obj));
+  }
+
+  cx->minorGC(JS::GCReason::API);
+
+  for (size_t i = 0; i < NumObjects; i += KeepEvery) {
+    CHECK(kept->append(all[i]));
+  }
+
+  return true;
+}
+
+bool checkObjects() {
+  for (size_t i = 0; i < kept->length(); i++) {
+    JS::RootedObject obj(cx, (*kept)[i]);
+    JS::RootedValue value(cx);
+    CHECK(JS_GetProperty(cx, obj, "i", &value));
+    CHECK(value.isInt32(int32_t(i * KeepEvery)));
+  }
+
+  return true;
+}
+END_TEST(testGCCompactOnFragmentation)
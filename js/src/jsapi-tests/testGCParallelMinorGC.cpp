@@ -0,0 +1,68 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gc/GCRuntime.h"
+#include "js/GlobalObject.h"  // JS_NewGlobalObject
+#include "js/RootingAPI.h"
+#include "js/Wrapper.h"
+#include "jsapi-tests/tests.h"
+#include "vm/Runtime.h"
+
+// Check that cross-compartment wrapper maps in several zones are updated
+// correctly when they are swept in parallel after a minor GC.
+BEGIN_TEST(testGCParallelMinorGCSweep) {
+  static const size_t NumGlobals = 4;
+
+  JS_SetGCParameter(cx, JSGC_PARALLEL_MINOR_GC_ENABLED, true);
+  CHECK(JS_GetGCParameter(cx, JSGC_PARALLEL_MINOR_GC_ENABLED) == 1);
+
+  JS_GC(cx);
+
+  JS::RootedObject target(cx, JS_NewPlainObject(cx));
+  CHECK(target);
+
+  JS::RootedObjectVector globals(cx);
+  JS::RootedObjectVector wrappers(cx);
+  for (size_t i = 0; i < NumGlobals; i++) {
+    JS::RealmOptions options;
+    JS::RootedObject other(
+        cx, JS_NewGlobalObject(cx, basicGlobalClass(), nullptr,
+                               JS::DontFireOnNewGlobalHook, options));
+    CHECK(other);
+    CHECK(JS::GetObjectZone(other) != JS::GetObjectZone(global));
+
+    JS::RootedObject wrapper(cx, target);
+    {
+      JSAutoRealm ar(cx, other);
+      CHECK(JS_WrapObject(cx, &wrapper));
+    }
+    CHECK(js::IsCrossCompartmentWrapper(wrapper));
+
+    CHECK(globals.append(other));
+    CHECK(wrappers.append(wrapper));
+  }
+
+  cx->minorGC(JS::GCReason::API);
+
+  CHECK(!js::gc::IsInsideNursery(target));
+  for (size_t i = 0; i < NumGlobals; i++) {
+    CHECK(js::UncheckedUnwrap(wrappers[i]) == target);
+
+    // Wrapping again must find the existing entry under the target's new
+    // address.
+    JS::RootedObject rewrapped(cx, target);
+    {
+      JSAutoRealm ar(cx, globals[i]);
+      CHECK(JS_WrapObject(cx, &rewrapped));
+    }
+    CHECK(rewrapped == wrappers[i]);
+  }
+
+  JS_SetGCParameter(cx, JSGC_PARALLEL_MINOR_GC_ENABLED, false);
+  return true;
+}
+END_TEST(testGCParallelMinorGCSweep)
@@ -562,3 +562,59 @@ BEGIN_TEST(testOrderedHashSetWithoutInit) {
   return true;
 }
 END_TEST(testOrderedHashSetWithoutInit)
+
+BEGIN_TEST(testOrderedHashSetRemoveUnlinks) {
+  // Every key collides, so all entries share a single hash chain. Removed
+  // entries must be unlinked from it without disturbing the live ones.
+  struct CollidingUint32HashPolicy {
+    using Lookup = uint32_t;
+    static js::HashNumber hash(const Lookup& v,
+                               const mozilla::HashCodeScrambler& hcs) {
+      return 0;
+    }
+    static bool match(const uint32_t& k, const Lookup& l) { return k == l; }
+    static bool isEmpty(const uint32_t& v) { return v == 0; }
+    static void makeEmpty(uint32_t* v) { *v = 0; }
+  };
+
+  using OHS = js::OrderedHashSet<uint32_t, CollidingUint32HashPolicy,
+                                 js::SystemAllocPolicy>;
+
+  OHS set(js::SystemAllocPolicy(), mozilla::HashCodeScrambler(17, 42));
+  CHECK(set.init());
+
+  static const uint32_t N = 100;
+  for (uint32_t i = 1; i <= N; i++) {
+    CHECK(set.put(i));
+  }
+
+  // Remove the odd keys, including the most and least recently added.
+  bool found;
+  for (uint32_t i = 1; i <= N; i += 2) {
+    CHECK(set.remove(i, &found));
+    CHECK(found);
+    CHECK(set.remove(i, &found));
+    CHECK(!found);
+  }
+
+  CHECK(set.count() == N / 2);
+  for (uint32_t i = 1; i <= N; i++) {
+    CHECK(set.has(i) == (i % 2 == 0));
+  }
+
+  // Re-adding a removed key appends it in insertion order.
+  CHECK(set.put(1));
+  uint32_t expected = 2;
+  OHS::Range r = set.all();
+  for (; expected <= N; expected += 2, r.popFront()) {
+    CHECK(!r.empty());
+    CHECK(r.front() == expected);
+  }
+  CHECK(!r.empty());
+  CHECK(r.front() == 1);
+  r.popFront();
+  CHECK(r.empty());
+
+  return true;
+}
+END_TEST(testOrderedHashSetRemoveUnlinks)
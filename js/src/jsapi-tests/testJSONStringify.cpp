@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "js/Printf.h"  // JS_smprintf
+#include "js/String.h"  // JS_StringEqualsAscii
+#include "jsapi-tests/tests.h"
+
+// JSON.stringify reads plain object slots and dense array elements directly
+// when it can. Check that it still observes modifications made while
+// stringifying and falls back correctly for getters, holes and toJSON.
+BEGIN_TEST(testJSONStringify_fastPaths) {
+  CHECK(check("{a: 1, b: 'x', c: [1, 2, 3], d: {e: null}}",
+              "{\"a\":1,\"b\":\"x\",\"c\":[1,2,3],\"d\":{\"e\":null}}"));
+
+  // Property order, with non-enumerable and symbol-keyed properties skipped.
+  CHECK(check("(() => { var o = {z: 1, y: 2};"
+              "  Object.defineProperty(o, 'x', {value: 3, enumerable: false});"
+              "  o[Symbol()] = 4; o.w = 5; return o; })()",
+              "{\"z\":1,\"y\":2,\"w\":5}"));
+
+  // Integer keys come first.
+  CHECK(check("{b: 1, 1: 2, a: 3, 0: 4}",
+              "{\"0\":4,\"1\":2,\"b\":1,\"a\":3}"));
+
+  // Getters.
+  CHECK(check("{a: 1, get b() { return 2; }, c: 3}",
+              "{\"a\":1,\"b\":2,\"c\":3}"));
+
+  // A toJSON method that deletes and adds properties on its holder.
+  CHECK(check("(() => { var o = {a: {toJSON() { delete o.b; o.d = 4;"
+              "                                   return 1; }},"
+              "                  b: 2, c: 3}; return o; })()",
+              "{\"a\":1,\"c\":3}"));
+
+  // A toJSON method that changes a later property's value.
+  CHECK(check("(() => { var o = {a: {toJSON() { o.b = 5; return 1; }}, b: 2};"
+              "  return o; })()",
+              "{\"a\":1,\"b\":5}"));
+
+  // toJSON on the prototype.
+  CHECK(check("(() => { function C() { this.a = 1; }"
+              "  C.prototype.toJSON = () => 'c';"
+              "  return [new C(), {a: 2}]; })()",
+              "[\"c\",{\"a\":2}]"));
+
+  // Holes in arrays, filled from the prototype or as null.
+  CHECK(check("(() => { Array.prototype[1] = 'p'; var a = [1, , 3, , ];"
+              "  a.length = 5; return a; })()",
+              "[1,\"p\",3,null,null]"));
+  EXEC("delete Array.prototype[1];");
+
+  // A toJSON method that shrinks the array being stringified.
+  CHECK(check("(() => { var a = [{toJSON() { a.length = 1; return 0; }}, 1, 2];"
+              "  return a; })()",
+              "[0,null,null]"));
+
+  return true;
+}
+
+bool check(const char* expr, const char* expected) {
+  JS::UniqueChars source = JS_smprintf("JSON.stringify(%s)", expr);
+  CHECK(source);
+
+  JS::RootedValue v(cx);
+  EVAL(source.get(), &v);
+  CHECK(v.isString());
+
+  bool match;
+  CHECK(JS_StringEqualsAscii(cx, v.toString(), expected, &match));
+  CHECK(match);
+  return true;
+}
+END_TEST(testJSONStringify_fastPaths)
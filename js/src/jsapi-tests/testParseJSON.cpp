@@ -8,14 +8,18 @@
 #include <limits>
 #include <string.h>
 
+#include "jsfriendapi.h"  // js::RunJobs
+
 #include "js/Array.h"  // JS::IsArrayObject
 #include "js/Exception.h"
 #include "js/friend/ErrorMessages.h"  // JSMSG_*
 #include "js/JSON.h"
 #include "js/MemoryFunctions.h"
 #include "js/Printf.h"
-#include "js/PropertyAndElement.h"  // JS_GetProperty
+#include "js/Promise.h"
+#include "js/PropertyAndElement.h"  // JS_GetElement, JS_{Get,Set}Property
 #include "jsapi-tests/tests.h"
+#include "vm/JSObject.h"
 
 using namespace js;
 
@@ -355,3 +359,132 @@ inline bool TryParse(JSContext* cx, const char (&input)[N],
   return true;
 }
 END_TEST(testParseJSON_reviver)
+
+BEGIN_TEST(testParseJSON_records) {
+  // Objects with the same keys at the same depth should share a shape, and
+  // objects with different, duplicate or reordered keys must still be
+  // created correctly.
+  AutoInflatedString str(cx);
+  str =
+      "[{\"a\":1,\"b\":{\"c\":2}},{\"a\":3,\"b\":{\"c\":4}},{\"a\":5,\"a\":6},"
+      "{\"b\":7,\"a\":8},{\"a\":9,\"b\":{\"c\":10}}]";
+
+  JS::RootedValue v(cx);
+  CHECK(JS_ParseJSON(cx, str.chars(), str.length(), &v));
+  CHECK(v.isObject());
+  JS::RootedObject array(cx, &v.toObject());
+
+  JS::RootedObject record0(cx);
+  CHECK(getRecord(array, 0, &record0));
+  JS::RootedObject record1(cx);
+  CHECK(getRecord(array, 1, &record1));
+  JS::RootedObject record2(cx);
+  CHECK(getRecord(array, 2, &record2));
+  JS::RootedObject record3(cx);
+  CHECK(getRecord(array, 3, &record3));
+  JS::RootedObject record4(cx);
+  CHECK(getRecord(array, 4, &record4));
+
+  CHECK(record0->shape() == record1->shape());
+  CHECK(record0->shape() == record4->shape());
+  CHECK(record0->shape() != record2->shape());
+  CHECK(record0->shape() != record3->shape());
+
+  CHECK(checkInt(record0, "a", 1));
+  CHECK(checkInt(record1, "a", 3));
+  CHECK(checkInt(record2, "a", 6));
+  CHECK(checkInt(record3, "a", 8));
+  CHECK(checkInt(record3, "b", 7));
+  CHECK(checkInt(record4, "a", 9));
+
+  JS::RootedValue inner(cx);
+  CHECK(JS_GetProperty(cx, record1, "b", &inner));
+  CHECK(inner.isObject());
+  JS::RootedObject innerObj(cx, &inner.toObject());
+  CHECK(checkInt(innerObj, "c", 4));
+
+  return true;
+}
+
+bool getRecord(JS::HandleObject array, uint32_t index,
+               JS::MutableHandleObject result) {
+  JS::RootedValue v(cx);
+  CHECK(JS_GetElement(cx, array, index, &v));
+  CHECK(v.isObject());
+  result.set(&v.toObject());
+  return true;
+}
+
+bool checkInt(JS::HandleObject obj, const char* name, int32_t expected) {
+  JS::RootedValue v(cx);
+  CHECK(JS_GetProperty(cx, obj, name, &v));
+  CHECK(v.isInt32(expected));
+  return true;
+}
+END_TEST(testParseJSON_records)
+
+BEGIN_TEST(testParseJSON_offThread) {
+  CHECK(checkOffThread("[]"));
+  CHECK(checkOffThread("  123456789012345678901  "));
+  CHECK(checkOffThread(
+      "{\"a\":[1,-2.5e3,\"x\\ny\",true,false,null],\"b\":{},"
+      "\"0\":\"\\u00e9\\u0100\",\"c\\td\":0.1}"));
+  CHECK(checkOffThread("[[[[{\"a\":{\"a\":1,\"a\":2},\"b\":[{}]}]]]]"));
+
+  CHECK(checkOffThreadError(""));
+  CHECK(checkOffThreadError("[1,]"));
+  CHECK(checkOffThreadError("{\"a\" 1}"));
+  CHECK(checkOffThreadError("\"\\x\""));
+  CHECK(checkOffThreadError("[1] 2"));
+
+  return true;
+}
+
+JSObject* parseOffThread(const char* input) {
+  AutoInflatedString str(cx);
+  str = input;
+
+  JS::RootedObject promise(
+      cx, JS::ParseJSONOffThread(cx, str.chars(), str.length()));
+  if (!promise) {
+    return nullptr;
+  }
+
+  // Wait for the helper thread and resolve the promise.
+  js::RunJobs(cx);
+  return promise;
+}
+
+bool checkOffThread(const char* input) {
+  JS::RootedObject promise(cx, parseOffThread(input));
+  CHECK(promise);
+  CHECK(JS::GetPromiseState(promise) == JS::PromiseState::Fulfilled);
+  JS::RootedValue actual(cx, JS::GetPromiseResult(promise));
+
+  AutoInflatedString str(cx);
+  str = input;
+  JS::RootedValue expected(cx);
+  CHECK(JS_ParseJSON(cx, str.chars(), str.length(), &expected));
+
+  CHECK(JS_SetProperty(cx, global, "actual", actual));
+  CHECK(JS_SetProperty(cx, global, "expected", expected));
+  JS::RootedValue same(cx);
+  EVAL("JSON.stringify(actual) === JSON.stringify(expected)", &same);
+  CHECK(same.isTrue());
+  return true;
+}
+
+bool checkOffThreadError(const char* input) {
+  JS::RootedObject promise(cx, parseOffThread(input));
+  CHECK(promise);
+  CHECK(JS::GetPromiseState(promise) == JS::PromiseState::Rejected);
+
+  JS::RootedValue error(cx, JS::GetPromiseResult(promise));
+  CHECK(error.isObject());
+  JS::RootedObject errorObj(cx, &error.toObject());
+  JSErrorReport* report = JS_ErrorFromException(cx, errorObj);
+  CHECK(report);
+  CHECK(report->errorNumber == JSMSG_JSON_BAD_PARSE);
+  return true;
+}
+END_TEST(testParseJSON_offThread)
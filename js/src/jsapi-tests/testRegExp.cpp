@@ -2,6 +2,10 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "mozilla/ScopeExit.h"
+
+#include "irregexp/RegExpAPI.h"
+#include "js/GCAPI.h"
 #include "js/RegExp.h"
 #include "js/RegExpFlags.h"
 #include "jsapi-tests/tests.h"
@@ -63,3 +67,87 @@ BEGIN_TEST(testGetRegExpSource) {
   return true;
 }
 END_TEST(testGetRegExpSource)
+
+BEGIN_TEST(testRegExpLiteralPrefix) {
+  JS::RootedValue val(cx);
+
+  // Matches that start with a literal prefix, including ones that need
+  // lookbehind into the text before the prefix.
+  EVAL(
+      "var s = 'x'.repeat(10000) + 'abcd' + 'y'.repeat(100) + 'abcq';"
+      "[/abc(d|q)/.exec(s).index, /(abc)q/.exec(s).index,"
+      " /abc(?=q)/g[Symbol.replace](s, '').length, s.split(/abcd/).length,"
+      " /abc(?<=xabc)/.exec(s).index, /abcz/.exec(s)].join()",
+      &val);
+  CHECK(val.isString());
+  CHECK(JS_LinearStringEqualsLiteral(
+      JS_ASSERT_STRING_IS_LINEAR(val.toString()), "10000,10104,10105,2,10000,"));
+
+  return true;
+}
+END_TEST(testRegExpLiteralPrefix)
+
+BEGIN_TEST(testRegExpBytecodeCache) {
+  // Bytecode is only generated, and so only cached, when native regexps are
+  // disabled.
+  uint32_t nativeRegExp;
+  CHECK(JS_GetGlobalJitCompilerOption(cx, JSJITCOMPILER_NATIVE_REGEXP_ENABLE,
+                                      &nativeRegExp));
+  JS_SetGlobalJitCompilerOption(cx, JSJITCOMPILER_NATIVE_REGEXP_ENABLE, 0);
+  auto restore = mozilla::MakeScopeExit([&] {
+    JS_SetGlobalJitCompilerOption(cx, JSJITCOMPILER_NATIVE_REGEXP_ENABLE,
+                                  nativeRegExp);
+  });
+
+  // A shrinking GC empties the cache.
+  JS::PrepareForFullGC(cx);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Shrink, JS::GCReason::API);
+  CHECK_EQUAL(js::irregexp::BytecodeCacheEntryCountForTesting(), 0u);
+
+  // The first compilation fills the cache, and compiling the same regexp in
+  // another zone reuses the cached bytecode.
+  const char* code = "/a+b\\d/.exec('xaab1').index";
+  CHECK(execInNewGlobal(code, 1));
+  CHECK_EQUAL(js::irregexp::BytecodeCacheEntryCountForTesting(), 1u);
+  uint64_t hits = js::irregexp::BytecodeCacheHitCountForTesting();
+  CHECK(execInNewGlobal(code, 1));
+  CHECK_EQUAL(js::irregexp::BytecodeCacheHitCountForTesting(), hits + 1);
+
+  // Many distinct patterns don't grow the cache past its fixed size, and the
+  // most recently compiled one is still there.
+  CHECK(execInNewGlobal(
+      "var n = 0;"
+      "for (var i = 0; i < 1000; i++) {"
+      "  n += new RegExp('a+b' + i).exec('aab' + i).index;"
+      "}"
+      "n",
+      0));
+  size_t count = js::irregexp::BytecodeCacheEntryCountForTesting();
+  CHECK(count > 1);
+  CHECK(count <= 256);
+  hits = js::irregexp::BytecodeCacheHitCountForTesting();
+  CHECK(execInNewGlobal("new RegExp('a+b999').exec('xaab999').index", 1));
+  CHECK_EQUAL(js::irregexp::BytecodeCacheHitCountForTesting(), hits + 1);
+
+  JS::PrepareForFullGC(cx);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Shrink, JS::GCReason::API);
+  CHECK_EQUAL(js::irregexp::BytecodeCacheEntryCountForTesting(), 0u);
+
+  return true;
+}
+
+// Evaluate |code| in a fresh global, and so in a fresh zone with its own
+// RegExpShared table, and check that it returns |expected|.
+bool execInNewGlobal(const char* code, int32_t expected) {
+  JS::RootedObject newGlobal(
+      cx, JS_NewGlobalObject(cx, getGlobalClass(), nullptr,
+                             JS::FireOnNewGlobalHook, JS::RealmOptions()));
+  CHECK(newGlobal);
+  JSAutoRealm ar(cx, newGlobal);
+  JS::RootedValue val(cx);
+  EVAL(code, &val);
+  CHECK(val.isInt32());
+  CHECK_EQUAL(val.toInt32(), expected);
+  return true;
+}
+END_TEST(testRegExpBytecodeCache)
@@ -0,0 +1,62 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/tests.h"
+#include "vm/StringType.h"
+
+// Check that searching a rope gives the same results as searching the
+// flattened string, and that the rope is not flattened by searches which only
+// need to look at its leaves.
+BEGIN_TEST(testRopeSearch) {
+  JS::RootedValue v(cx);
+  EXEC(
+      "var left = 'a'.repeat(100) + 'needle';"
+      "var rope = left + 'b'.repeat(100) + 'c'.repeat(100);");
+  EVAL("rope", &v);
+  CHECK(v.toString()->isRope());
+
+  EVAL("rope.indexOf('needle')", &v);
+  CHECK(v.isInt32(100));
+  EVAL("rope.indexOf('eb')", &v);
+  CHECK(v.isInt32(105));
+  EVAL("rope.indexOf('bc')", &v);
+  CHECK(v.isInt32(205));
+  EVAL("rope.indexOf('cb')", &v);
+  CHECK(v.isInt32(-1));
+  EVAL("rope.includes('needlebbb')", &v);
+  CHECK(v.isTrue());
+  EVAL("rope.includes('needles')", &v);
+  CHECK(v.isFalse());
+
+  EVAL("rope", &v);
+  CHECK(v.toString()->isRope());
+
+  EVAL("rope.startsWith('aaa')", &v);
+  CHECK(v.isTrue());
+  EVAL("rope.startsWith('needle', 100)", &v);
+  CHECK(v.isTrue());
+  EVAL("rope.startsWith('needleb', 100)", &v);
+  CHECK(v.isTrue());
+  EVAL("rope.startsWith('b', 100)", &v);
+  CHECK(v.isFalse());
+  EVAL("rope.endsWith('ccc')", &v);
+  CHECK(v.isTrue());
+  EVAL("rope.endsWith('bc', 207)", &v);
+  CHECK(v.isTrue());
+  EVAL("rope.charCodeAt(102) === 'e'.charCodeAt(0)", &v);
+  CHECK(v.isTrue());
+  EVAL("rope.charAt(305)", &v);
+  CHECK(JS_LinearStringEqualsLiteral(JS_ASSERT_STRING_IS_LINEAR(v.toString()),
+                                     "c"));
+
+  // The outermost rope is still not flattened.
+  EVAL("rope", &v);
+  CHECK(v.toString()->isRope());
+
+  return true;
+}
+END_TEST(testRopeSearch)
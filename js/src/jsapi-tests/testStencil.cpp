@@ -5,11 +5,13 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
 #include <string.h>
 
 #include "jsapi.h"
 
 #include "frontend/CompilationStencil.h"
+#include "jit/JitOptions.h"
 #include "js/CompilationAndEvaluation.h"
 #include "js/experimental/JSStencil.h"
 #include "js/Modules.h"
@@ -18,7 +20,10 @@
 #include "js/Transcoding.h"
 #include "jsapi-tests/tests.h"
 #include "vm/HelperThreads.h"  // js::RunPendingSourceCompressions
-#include "vm/Monitor.h"        // js::Monitor, js::AutoLockMonitor
+#include "vm/JSFunction.h"
+#include "vm/Monitor.h"  // js::Monitor, js::AutoLockMonitor
+
+#include "vm/JSScript-inl.h"
 
 BEGIN_TEST(testStencil_Basic) {
   const char* chars =
@@ -272,6 +277,87 @@ static bool TestGetBuildId(JS::BuildIdCharVector* buildId) {
 }
 END_TEST(testStencil_Transcode)
 
+BEGIN_TEST(testStencil_TranscodeWarmUpHints) {
+  JS::SetProcessBuildIdOp(TestGetBuildId);
+
+  // |hot| only runs when |warm| is defined, which is only the case in the
+  // session that encodes the script.
+  const char* chars =
+      "function hot() { return 1; }"
+      "if (typeof warm !== 'undefined') {"
+      "  for (var i = 0; i < 50; i++) { hot(); }"
+      "}";
+
+  JS::TranscodeBuffer buffer;
+
+  {
+    JS::SourceText<mozilla::Utf8Unit> srcBuf;
+    CHECK(srcBuf.init(cx, chars, strlen(chars), JS::SourceOwnership::Borrowed));
+
+    JS::RootedValue warm(cx, JS::TrueValue());
+    CHECK(JS_SetProperty(cx, global, "warm", warm));
+
+    JS::CompileOptions options(cx);
+    JS::RootedScript script(
+        cx, JS::CompileAndStartIncrementalEncoding(cx, options, srcBuf));
+    CHECK(script);
+    JS::RootedValue rval(cx);
+    CHECK(JS_ExecuteScript(cx, script, &rval));
+    CHECK(getWarmUpCount("hot") >= 50);
+
+    CHECK(JS::FinishIncrementalEncoding(cx, script, buffer));
+  }
+
+  CHECK(createGlobal());
+  JSAutoRealm ar(cx, global);
+
+  {
+    RefPtr<JS::Stencil> stencil;
+    JS::DecodeOptions decodeOptions;
+    JS::TranscodeRange range(buffer.begin(), buffer.length());
+    JS::TranscodeResult res =
+        JS::DecodeStencil(cx, decodeOptions, range, getter_AddRefs(stencil));
+    CHECK(res == JS::TranscodeResult::Ok);
+
+    JS::InstantiateOptions instantiateOptions;
+    JS::RootedScript script(
+        cx, JS::InstantiateGlobalStencil(cx, instantiateOptions, stencil));
+    CHECK(script);
+    JS::RootedValue rval(cx);
+    CHECK(JS_ExecuteScript(cx, script, &rval));
+  }
+
+  // The decoded |hot| starts warmed up, one short of the Baseline JIT
+  // threshold.
+  uint32_t threshold = js::jit::JitOptions.baselineJitWarmUpThreshold;
+  if (threshold > 0) {
+    uint32_t count = getWarmUpCount("hot");
+    CHECK(count >= std::min(uint32_t(50), threshold - 1));
+    CHECK(count < threshold);
+  }
+
+  return true;
+}
+
+uint32_t getWarmUpCount(const char* name) {
+  JS::RootedValue v(cx);
+  if (!JS_GetProperty(cx, global, name, &v) || !v.isObject() ||
+      !v.toObject().is<JSFunction>()) {
+    return 0;
+  }
+  JSFunction* fun = &v.toObject().as<JSFunction>();
+  if (!fun->hasBytecode()) {
+    return 0;
+  }
+  return fun->nonLazyScript()->getWarmUpCount();
+}
+
+static bool TestGetBuildId(JS::BuildIdCharVector* buildId) {
+  const char buildid[] = "testXDR";
+  return buildId->append(buildid, sizeof(buildid));
+}
+END_TEST(testStencil_TranscodeWarmUpHints)
+
 BEGIN_TEST(testStencil_TranscodeBorrowing) {
   JS::SetProcessBuildIdOp(TestGetBuildId);
 
@@ -101,6 +101,59 @@ BEGIN_TEST(testStructuredClone_string) {
 }
 END_TEST(testStructuredClone_string)
 
+BEGIN_TEST(testStructuredClone_records) {
+  // Records sharing a shape, and arrays of primitives, are written without
+  // per-property keys. Mix them with objects that take the generic path.
+  JS::RootedValue v1(cx);
+  EVAL(
+      "var records = [];"
+      "for (var i = 0; i < 10; i++) {"
+      "  records.push({id: i, name: 'r' + i, score: i / 2, ok: i % 2 == 0,"
+      "                big: BigInt(i), none: null, undef: undefined});"
+      "}"
+      "records.push({id: 10, nested: {x: 1}});"
+      "records.push({id: 11, nested: null});"
+      "records.push(records[0]);"
+      "var sparse = [1, , 3];"
+      "var extra = [1, 2]; extra.foo = 'bar';"
+      "var extra2 = [1, 2]; extra2.foo = 'bar'; extra2.baz = 'qux';"
+      "({records, packed: [1, 'two', 3.5, false, null, undefined, 5n],"
+      "  sparse, extra, extra2, empty: [], emptyObj: {}})",
+      &v1);
+
+  JS::RootedValue v2(cx);
+  CHECK(JS_StructuredClone(cx, v1, &v2, nullptr, nullptr));
+  CHECK(v2.isObject());
+  CHECK(&v2.toObject() != &v1.toObject());
+
+  CHECK(JS_SetProperty(cx, global, "clone", v2));
+  JS::RootedValue result(cx);
+  EVAL(
+      "var r = clone.records;"
+      "var ok = r.length == 13 && r[12] === r[0] && r[10].nested.x === 1 &&"
+      "         r[11].nested === null;"
+      "for (var i = 0; i < 10; i++) {"
+      "  ok = ok && r[i].id === i && r[i].name === 'r' + i &&"
+      "       r[i].score === i / 2 && r[i].ok === (i % 2 == 0) &&"
+      "       r[i].big === BigInt(i) && r[i].none === null &&"
+      "       'undef' in r[i] && r[i].undef === undefined &&"
+      "       Object.keys(r[i]).join() == 'id,name,score,ok,big,none,undef';"
+      "}"
+      "var p = clone.packed;"
+      "ok && p.length == 7 && p[0] === 1 && p[1] === 'two' && p[2] === 3.5 &&"
+      "  p[3] === false && p[4] === null && 5 in p && p[6] === 5n &&"
+      "  clone.sparse.length == 3 && !(1 in clone.sparse) &&"
+      "  clone.sparse[2] === 3 && clone.extra.foo === 'bar' &&"
+      "  clone.extra2.length === 2 && clone.extra2[1] === 2 &&"
+      "  clone.extra2.foo === 'bar' && clone.extra2.baz === 'qux' &&"
+      "  clone.empty.length === 0 && Object.keys(clone.emptyObj).length === 0",
+      &result);
+  CHECK(result.isTrue());
+
+  return true;
+}
+END_TEST(testStructuredClone_records)
+
 BEGIN_TEST(testStructuredClone_externalArrayBuffer) {
   ExternalData data("One two three four");
   JS::RootedObject g1(cx, createGlobal());
@@ -276,3 +276,29 @@ bool TestArrayFromBuffer(JSContext* cx) {
 }
 
 END_TEST(testTypedArrays)
+
+// indexOf and includes search typed arrays natively. Check the cases where the
+// search isn't a plain bitwise comparison.
+BEGIN_TEST(testTypedArraySearch) {
+  JS::RootedValue val(cx);
+  EVAL(
+      "var f64 = new Float64Array(1000);"
+      "f64[500] = -0; f64[0] = 1; f64[998] = NaN; f64[999] = 0.1;"
+      "var f32 = new Float32Array([0.1, 2, Infinity]);"
+      "var i8 = new Int8Array(100); i8[99] = -1;"
+      "var u8c = new Uint8ClampedArray(70); u8c[69] = 255;"
+      "var i64 = new BigInt64Array(40); i64[39] = -1n;"
+      "[f64.indexOf(0), f64.indexOf(-0, 2), f64.indexOf(NaN),"
+      " f64.includes(NaN), f64.indexOf(0.1), f64.indexOf(1, 1),"
+      " f32.indexOf(0.1), f32.indexOf(Math.fround(0.1)), f32.indexOf(1e300),"
+      " f32.indexOf(Infinity), i8.indexOf(-1), i8.indexOf(255),"
+      " i8.indexOf(-1.5), u8c.indexOf(255), u8c.includes(256), i64.indexOf(-1n), i64.indexOf(-1),"
+      " i64.includes(2n ** 64n - 1n), f64.indexOf(1, -1000)].join()",
+      &val);
+  CHECK(val.isString());
+  CHECK(JS_LinearStringEqualsLiteral(
+      JS_ASSERT_STRING_IS_LINEAR(val.toString()),
+      "1,2,-1,true,999,-1,-1,0,-1,2,99,-1,-1,69,false,39,-1,false,0"));
+  return true;
+}
+END_TEST(testTypedArraySearch)
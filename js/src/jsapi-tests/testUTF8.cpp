@@ -45,3 +45,107 @@ BEGIN_TEST(testUTF8_badSurrogate) {
   return true;
 }
 END_TEST(testUTF8_badSurrogate)
+
+BEGIN_TEST(testUTF8_inflateASCII) {
+  static const char ascii[] = "hello, world";
+  size_t len = strlen(ascii);
+
+  size_t outlen;
+  JS::UniqueTwoByteChars twoByte(
+      JS::UTF8CharsToNewTwoByteCharsZ(cx, JS::UTF8Chars(ascii, len), &outlen,
+                                      js::MallocArena)
+          .get());
+  CHECK(twoByte);
+  CHECK(outlen == len);
+  for (size_t i = 0; i < len; i++) {
+    CHECK(twoByte[i] == char16_t(ascii[i]));
+  }
+  CHECK(twoByte[len] == 0);
+
+  JS::UniqueLatin1Chars latin1(
+      JS::UTF8CharsToNewLatin1CharsZ(cx, JS::UTF8Chars(ascii, len), &outlen,
+                                     js::MallocArena)
+          .get());
+  CHECK(latin1);
+  CHECK(outlen == len);
+  CHECK(memcmp(latin1.get(), ascii, len + 1) == 0);
+  return true;
+}
+END_TEST(testUTF8_inflateASCII)
+
+BEGIN_TEST(testUTF8_inflateNonLatin1) {
+  // "é€x": U+00E9 fits in Latin-1, U+20AC doesn't.
+  static const char utf8[] = "\xC3\xA9\xE2\x82\xACx";
+  size_t len = strlen(utf8);
+
+  size_t outlen;
+  JS::UniqueTwoByteChars twoByte(
+      JS::UTF8CharsToNewTwoByteCharsZ(cx, JS::UTF8Chars(utf8, len), &outlen,
+                                      js::MallocArena)
+          .get());
+  CHECK(twoByte);
+  CHECK(outlen == 3);
+  CHECK(twoByte[0] == 0x00E9);
+  CHECK(twoByte[1] == 0x20AC);
+  CHECK(twoByte[2] == 'x');
+  CHECK(twoByte[3] == 0);
+
+  // Must not be narrowed to Latin-1.
+  JS::Latin1CharsZ latin1 = JS::UTF8CharsToNewLatin1CharsZ(
+      cx, JS::UTF8Chars(utf8, len), &outlen, js::MallocArena);
+  CHECK(!latin1);
+  CHECK(JS_IsExceptionPending(cx));
+  JS_ClearPendingException(cx);
+
+  JS::UniqueLatin1Chars lossy(
+      JS::LossyUTF8CharsToNewLatin1CharsZ(cx, JS::UTF8Chars(utf8, len),
+                                          &outlen, js::MallocArena)
+          .get());
+  CHECK(lossy);
+  CHECK(outlen == 3);
+  CHECK(lossy[0] == 0xE9);
+  CHECK(lossy[1] == '?');
+  CHECK(lossy[2] == 'x');
+
+  // Input which only has Latin-1 code points is narrowed.
+  static const char latin1UTF8[] = "caf\xC3\xA9";
+  JS::UniqueLatin1Chars narrowed(
+      JS::UTF8CharsToNewLatin1CharsZ(
+          cx, JS::UTF8Chars(latin1UTF8, strlen(latin1UTF8)), &outlen,
+          js::MallocArena)
+          .get());
+  CHECK(narrowed);
+  CHECK(outlen == 4);
+  CHECK(narrowed[3] == 0xE9);
+  CHECK(narrowed[4] == 0);
+  return true;
+}
+END_TEST(testUTF8_inflateNonLatin1)
+
+BEGIN_TEST(testUTF8_inflateInvalid) {
+  // A truncated three-byte sequence in the middle of ASCII.
+  static const char invalid[] = "ab\xE2\x82" "cd";
+  size_t len = strlen(invalid);
+
+  size_t outlen;
+  JS::TwoByteCharsZ strict = JS::UTF8CharsToNewTwoByteCharsZ(
+      cx, JS::UTF8Chars(invalid, len), &outlen, js::MallocArena);
+  CHECK(!strict);
+  CHECK(JS_IsExceptionPending(cx));
+  JS_ClearPendingException(cx);
+
+  JS::UniqueTwoByteChars lossy(
+      JS::LossyUTF8CharsToNewTwoByteCharsZ(cx, JS::UTF8Chars(invalid, len),
+                                           &outlen, js::MallocArena)
+          .get());
+  CHECK(lossy);
+  CHECK(outlen == 5);
+  CHECK(lossy[0] == 'a');
+  CHECK(lossy[1] == 'b');
+  CHECK(lossy[2] == 0xFFFD);
+  CHECK(lossy[3] == 'c');
+  CHECK(lossy[4] == 'd');
+  CHECK(lossy[5] == 0);
+  return true;
+}
+END_TEST(testUTF8_inflateInvalid)
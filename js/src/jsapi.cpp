@@ -3511,6 +3511,30 @@ JS_PUBLIC_API bool JS_ParseJSONWithReviver(JSContext* cx, HandleString str,
                                     vp);
 }
 
+JS_PUBLIC_API JSObject* JS::ParseJSONOffThread(JSContext* cx,
+                                              const char16_t* chars,
+                                              size_t len) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  return js::ParseJSONOffThread(cx, mozilla::Range<const char16_t>(chars, len));
+}
+
+JS_PUBLIC_API JSObject* JS::ParseJSONOffThread(JSContext* cx,
+                                              HandleString str) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  cx->check(str);
+
+  AutoStableStringChars stableChars(cx);
+  if (!stableChars.init(cx, str)) {
+    return nullptr;
+  }
+
+  return stableChars.isLatin1()
+             ? js::ParseJSONOffThread(cx, stableChars.latin1Range())
+             : js::ParseJSONOffThread(cx, stableChars.twoByteRange());
+}
+
 /************************************************************************/
 
 JS_PUBLIC_API void JS_ReportErrorASCII(JSContext* cx, const char* format, ...) {
@@ -4527,7 +4551,7 @@ JS_PUBLIC_API bool JS::FinishIncrementalEncoding(JSContext* cx,
   if (!script) {
     return false;
   }
-  if (!script->scriptSource()->xdrFinalizeEncoder(cx, buffer)) {
+  if (!script->scriptSource()->xdrFinalizeEncoder(cx, buffer, script)) {
     return false;
   }
   return true;
@@ -4536,10 +4560,9 @@ JS_PUBLIC_API bool JS::FinishIncrementalEncoding(JSContext* cx,
 JS_PUBLIC_API bool JS::FinishIncrementalEncoding(JSContext* cx,
                                                  JS::Handle<JSObject*> module,
                                                  TranscodeBuffer& buffer) {
-  if (!module->as<ModuleObject>()
-           .scriptSourceObject()
-           ->source()
-           ->xdrFinalizeEncoder(cx, buffer)) {
+  ModuleObject& moduleObj = module->as<ModuleObject>();
+  if (!moduleObj.scriptSourceObject()->source()->xdrFinalizeEncoder(
+          cx, buffer, moduleObj.maybeScript())) {
     return false;
   }
   return true;
@@ -135,6 +135,7 @@ extern bool enableToSource;
 extern bool enablePropertyErrorMessageFix;
 extern bool enableIteratorHelpers;
 extern bool enableShadowRealms;
+extern bool enableArrayBufferTransfer;
 extern bool enableArrayGrouping;
 extern bool enablePrivateClassFields;
 extern bool enablePrivateClassMethods;
@@ -43,6 +43,7 @@
 #include "js/experimental/TypedData.h"  // JS_IsArrayBufferViewObject
 #include "js/friend/ErrorMessages.h"    // js::GetErrorMessage, JSMSG_*
 #include "js/MemoryMetrics.h"
+#include "js/PropertyAndElement.h"  // JS_DefineProperties
 #include "js/PropertySpec.h"
 #include "js/SharedArrayBuffer.h"
 #include "js/Wrapper.h"
@@ -247,6 +248,30 @@ bool js::CommitBufferMemory(void* dataEnd, size_t delta) {
   return true;
 }
 
+// Committed size above which wasm memories are backed by huge pages where
+// available. Smaller memories would not use enough of each huge page.
+static const size_t HugeBufferMemoryThreshold = size_t(1) << 30;
+
+void js::MaybeAdviseHugeBufferMemory(void* dataStart, size_t mappedSize,
+                                     size_t oldCommittedSize,
+                                     size_t newCommittedSize) {
+  MOZ_ASSERT(uintptr_t(dataStart) % gc::SystemPageSize() == 0);
+  MOZ_ASSERT(oldCommittedSize <= newCommittedSize);
+  MOZ_ASSERT(newCommittedSize <= mappedSize);
+
+  if (oldCommittedSize >= HugeBufferMemoryThreshold ||
+      newCommittedSize < HugeBufferMemoryThreshold) {
+    return;
+  }
+
+#if defined(XP_LINUX) && defined(MADV_HUGEPAGE)
+  // Advise the whole mapping, such that the flag is carried over to the pages
+  // committed by later grows. This is only a hint, and fails harmlessly when
+  // transparent huge pages are disabled.
+  (void)madvise(dataStart, mappedSize, MADV_HUGEPAGE);
+#endif
+}
+
 bool js::ExtendBufferMapping(void* dataPointer, size_t mappedSize,
                              size_t newMappedSize) {
   MOZ_ASSERT(mappedSize % gc::SystemPageSize() == 0);
@@ -340,6 +365,30 @@ static const JSPropertySpec arraybuffer_proto_properties[] = {
     JS_PSG("byteLength", ArrayBufferObject::byteLengthGetter, 0),
     JS_STRING_SYM_PS(toStringTag, "ArrayBuffer", JSPROP_READONLY), JS_PS_END};
 
+static const JSFunctionSpec arraybuffer_transfer_proto_functions[] = {
+    JS_FN("transfer", ArrayBufferObject::transfer, 0, 0),
+    JS_FN("transferToFixedLength", ArrayBufferObject::transfer, 0, 0),
+    JS_FS_END};
+
+static const JSPropertySpec arraybuffer_transfer_proto_properties[] = {
+    JS_PSG("detached", ArrayBufferObject::detachedGetter, 0), JS_PS_END};
+
+static bool ArrayBufferProtoFinish(JSContext* cx, JS::HandleObject ctor,
+                                   JS::HandleObject proto) {
+  // The ArrayBuffer transfer proposal is behind a pref.
+  if (cx->realm()->creationOptions().getArrayBufferTransferEnabled()) {
+    if (!js::DefineFunctions(cx, proto,
+                             arraybuffer_transfer_proto_functions)) {
+      return false;
+    }
+    if (!JS_DefineProperties(cx, proto,
+                             arraybuffer_transfer_proto_properties)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static const ClassSpec ArrayBufferObjectClassSpec = {
     GenericCreateConstructor<ArrayBufferObject::class_constructor, 1,
                              gc::AllocKind::FUNCTION>,
@@ -347,7 +396,8 @@ static const ClassSpec ArrayBufferObjectClassSpec = {
     arraybuffer_functions,
     arraybuffer_properties,
     arraybuffer_proto_functions,
-    arraybuffer_proto_properties};
+    arraybuffer_proto_properties,
+    ArrayBufferProtoFinish};
 
 static const ClassExtension ArrayBufferObjectClassExtension = {
     ArrayBufferObject::objectMoved,  // objectMovedOp
@@ -384,6 +434,21 @@ bool ArrayBufferObject::byteLengthGetter(JSContext* cx, unsigned argc,
   return CallNonGenericMethod<IsArrayBuffer, byteLengthGetterImpl>(cx, args);
 }
 
+MOZ_ALWAYS_INLINE bool ArrayBufferObject::detachedGetterImpl(
+    JSContext* cx, const CallArgs& args) {
+  MOZ_ASSERT(IsArrayBuffer(args.thisv()));
+  auto* buffer = &args.thisv().toObject().as<ArrayBufferObject>();
+  args.rval().setBoolean(buffer->isDetached());
+  return true;
+}
+
+// ArrayBuffer.prototype.transfer proposal, get ArrayBuffer.prototype.detached
+bool ArrayBufferObject::detachedGetter(JSContext* cx, unsigned argc,
+                                       Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  return CallNonGenericMethod<IsArrayBuffer, detachedGetterImpl>(cx, args);
+}
+
 /*
  * ArrayBuffer.isView(obj); ES6 (Dec 2013 draft) 24.1.3.1
  */
@@ -394,6 +459,64 @@ bool ArrayBufferObject::fun_isView(JSContext* cx, unsigned argc, Value* vp) {
   return true;
 }
 
+// ArrayBuffer.prototype.transfer proposal, ArrayBufferCopyAndDetach
+bool ArrayBufferObject::transferImpl(JSContext* cx, const CallArgs& args) {
+  MOZ_ASSERT(IsArrayBuffer(args.thisv()));
+
+  // Steps 1-2 (performed by CallNonGenericMethod).
+  Rooted<ArrayBufferObject*> buffer(
+      cx, &args.thisv().toObject().as<ArrayBufferObject>());
+
+  // Steps 3-4.
+  uint64_t newByteLength;
+  if (args.get(0).isUndefined()) {
+    newByteLength = buffer->byteLength();
+  } else if (!ToIndex(cx, args.get(0), &newByteLength)) {
+    return false;
+  }
+
+  // Step 5.
+  if (buffer->isDetached()) {
+    JS_ReportErrorNumberASCII(cx, GetErrorMessage, nullptr,
+                              JSMSG_TYPED_ARRAY_DETACHED);
+    return false;
+  }
+
+  // Steps 6-7. Resizable buffers aren't supported, so the result is always a
+  // fixed-length buffer.
+
+  // Step 8. Buffers used as wasm memory have a detach key.
+  if (buffer->isWasm() || buffer->isPreparedForAsmJS()) {
+    JS_ReportErrorNumberASCII(cx, GetErrorMessage, nullptr,
+                              JSMSG_WASM_NO_TRANSFER);
+    return false;
+  }
+
+  // Step 9 (Inlined 6.2.6.1 CreateByteDataBlock, step 2).
+  if (!CheckArrayBufferTooLarge(cx, newByteLength)) {
+    return false;
+  }
+
+  // Steps 9-14.
+  ArrayBufferObject* newBuffer =
+      transferContents(cx, buffer, size_t(newByteLength));
+  if (!newBuffer) {
+    return false;
+  }
+
+  // Step 15.
+  args.rval().setObject(*newBuffer);
+  return true;
+}
+
+// ArrayBuffer.prototype.transfer proposal
+// ArrayBuffer.prototype.transfer ( [ newLength ] )
+// ArrayBuffer.prototype.transferToFixedLength ( [ newLength ] )
+bool ArrayBufferObject::transfer(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  return CallNonGenericMethod<IsArrayBuffer, transferImpl>(cx, args);
+}
+
 // ES2017 draft 24.1.2.1
 bool ArrayBufferObject::class_constructor(JSContext* cx, unsigned argc,
                                           Value* vp) {
@@ -638,6 +761,7 @@ void ArrayBufferObject::detach(JSContext* cx,
     return false;
   }
 
+  MaybeAdviseHugeBufferMemory(dataPointer(), mappedSize(), oldSize, newSize);
   length_ = newSize;
 
   return true;
@@ -710,6 +834,8 @@ WasmArrayRawBuffer* WasmArrayRawBuffer::AllocateWasm(
   uint8_t* base = reinterpret_cast<uint8_t*>(data) + gc::SystemPageSize();
   uint8_t* header = base - sizeof(WasmArrayRawBuffer);
 
+  MaybeAdviseHugeBufferMemory(base, mappedSize, 0, numBytes);
+
   auto rawBuf = new (header) WasmArrayRawBuffer(
       indexType, base, clampedMaxPages, sourceMaxPages, mappedSize, numBytes);
   return rawBuf;
@@ -1181,8 +1307,20 @@ bool ArrayBufferObject::wasmMovingGrowToPages(
 
   Pages clampedMaxPages =
       wasm::ClampedMaxPages(t, newPages, Nothing(), /* hugeMemory */ false);
+
+  // Reserve address space for the memory to grow by half of its new size
+  // without moving again, such that a series of grows does not copy the whole
+  // memory each time. Only the new size is committed.
+  Maybe<size_t> mappedSize;
+#ifdef JS_64BIT
+  Pages reservedPages =
+      std::min(Pages(newPages.value() + newPages.value() / 2), clampedMaxPages);
+  mappedSize = Some(wasm::ComputeMappedSize(reservedPages));
+#endif
+
   WasmArrayRawBuffer* newRawBuf = WasmArrayRawBuffer::AllocateWasm(
-      oldBuf->wasmIndexType(), newPages, clampedMaxPages, Nothing(), Nothing());
+      oldBuf->wasmIndexType(), newPages, clampedMaxPages, Nothing(),
+      mappedSize);
   if (!newRawBuf) {
     return false;
   }
@@ -1508,6 +1646,82 @@ ArrayBufferObject* ArrayBufferObject::createFromNewRawBuffer(
   return nullptr;
 }
 
+/* static */ ArrayBufferObject* ArrayBufferObject::transferContents(
+    JSContext* cx, Handle<ArrayBufferObject*> buffer, size_t newByteLength) {
+  CheckStealPreconditions(buffer, cx);
+  MOZ_ASSERT(newByteLength <= maxBufferByteLength());
+
+  size_t oldByteLength = buffer->byteLength();
+
+  // Large malloced contents are moved into the new buffer. The allocator can
+  // usually grow or shrink them in place, or remap the pages, instead of
+  // copying. As when growing wasm memory, the new buffer is created first so
+  // that |buffer| is left unmodified if anything fails.
+  if (buffer->isMalloced() && newByteLength > MaxInlineBytes) {
+    Rooted<ArrayBufferObject*> newBuffer(cx, createEmpty(cx));
+    if (!newBuffer) {
+      return nullptr;
+    }
+
+    uint8_t* data = buffer->dataPointer();
+    if (newByteLength != oldByteLength) {
+      data = cx->pod_arena_realloc<uint8_t>(js::ArrayBufferContentsArena, data,
+                                            oldByteLength, newByteLength);
+      if (!data) {
+        return nullptr;
+      }
+      if (newByteLength > oldByteLength) {
+        memset(data + oldByteLength, 0, newByteLength - oldByteLength);
+      }
+    }
+
+    // Nothing can fail from here on. Overwrite |buffer|'s possibly stale data
+    // pointer *without* releasing the data, then detach it.
+    buffer->setDataPointer(BufferContents::createNoData());
+    RemoveCellMemory(buffer, oldByteLength, MemoryUse::ArrayBufferContents);
+    ArrayBufferObject::detach(cx, buffer);
+
+    newBuffer->initialize(newByteLength, BufferContents::createMalloced(data));
+    AddCellMemory(newBuffer, newByteLength, MemoryUse::ArrayBufferContents);
+    return newBuffer;
+  }
+
+  // Mapped contents can be handed over as long as the length doesn't change.
+  if (buffer->isMapped() && newByteLength == oldByteLength) {
+    Rooted<ArrayBufferObject*> newBuffer(cx, createEmpty(cx));
+    if (!newBuffer) {
+      return nullptr;
+    }
+
+    BufferContents contents = buffer->contents();
+    size_t nAllocated = buffer->associatedBytes();
+    buffer->setDataPointer(BufferContents::createNoData());
+    RemoveCellMemory(buffer, nAllocated, MemoryUse::ArrayBufferContents);
+    ArrayBufferObject::detach(cx, buffer);
+
+    newBuffer->initialize(newByteLength, contents);
+    AddCellMemory(newBuffer, nAllocated, MemoryUse::ArrayBufferContents);
+    return newBuffer;
+  }
+
+  // Everything else is copied.
+  AutoSetNewObjectMetadata metadata(cx);
+  auto [newBuffer, toFill] = createBufferAndData<FillContents::Uninitialized>(
+      cx, newByteLength, metadata, nullptr);
+  if (!newBuffer) {
+    return nullptr;
+  }
+
+  size_t count = std::min(oldByteLength, newByteLength);
+  std::uninitialized_copy_n(buffer->dataPointer(), count, toFill);
+  if (newByteLength > count) {
+    memset(toFill + count, 0, newByteLength - count);
+  }
+
+  ArrayBufferObject::detach(cx, buffer);
+  return newBuffer;
+}
+
 /* static */ ArrayBufferObject::BufferContents
 ArrayBufferObject::extractStructuredCloneContents(
     JSContext* cx, Handle<ArrayBufferObject*> buffer) {
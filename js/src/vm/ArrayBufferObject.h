@@ -43,6 +43,15 @@ void* MapBufferMemory(wasm::IndexType, size_t mappedSize,
 // size.  Returns false on failure.
 bool CommitBufferMemory(void* dataEnd, size_t delta);
 
+// Hint the system to back an existing mapping with huge pages, if its committed
+// area grows from `oldCommittedSize` to `newCommittedSize` bytes across the
+// threshold above which TLB pressure dominates.  `dataStart` must be the
+// page-aligned start of the mapping and `mappedSize` its size.  Pages are
+// still only committed as they are touched.
+void MaybeAdviseHugeBufferMemory(void* dataStart, size_t mappedSize,
+                                 size_t oldCommittedSize,
+                                 size_t newCommittedSize);
+
 // Extend an existing mapping by adding uncommited pages to it.  `dataStart`
 // must be the pointer to the start of the existing mapping, `mappedSize` the
 // size of the existing mapping, and `newMappedSize` the size of the extended
@@ -166,6 +175,8 @@ using MutableHandleArrayBufferObjectMaybeShared =
  */
 class ArrayBufferObject : public ArrayBufferObjectMaybeShared {
   static bool byteLengthGetterImpl(JSContext* cx, const CallArgs& args);
+  static bool detachedGetterImpl(JSContext* cx, const CallArgs& args);
+  static bool transferImpl(JSContext* cx, const CallArgs& args);
 
  public:
   static const uint8_t DATA_SLOT = 0;
@@ -338,8 +349,12 @@ class ArrayBufferObject : public ArrayBufferObjectMaybeShared {
 
   static bool byteLengthGetter(JSContext* cx, unsigned argc, Value* vp);
 
+  static bool detachedGetter(JSContext* cx, unsigned argc, Value* vp);
+
   static bool fun_isView(JSContext* cx, unsigned argc, Value* vp);
 
+  static bool transfer(JSContext* cx, unsigned argc, Value* vp);
+
   static bool class_constructor(JSContext* cx, unsigned argc, Value* vp);
 
   static bool isOriginalByteLengthGetter(Native native) {
@@ -372,6 +387,13 @@ class ArrayBufferObject : public ArrayBufferObjectMaybeShared {
 
   static size_t objectMoved(JSObject* obj, JSObject* old);
 
+  // Detach |buffer| and return a new buffer of |newByteLength| bytes holding
+  // its contents. Malloced contents are moved with realloc and mapped
+  // contents of unchanged length are handed over, so neither is copied.
+  static ArrayBufferObject* transferContents(JSContext* cx,
+                                             Handle<ArrayBufferObject*> buffer,
+                                             size_t newByteLength);
+
   static uint8_t* stealMallocedContents(JSContext* cx,
                                         Handle<ArrayBufferObject*> buffer);
 
@@ -8,6 +8,7 @@
 #define vm_Caches_h
 
 #include "mozilla/Array.h"
+#include "mozilla/MathAlgorithms.h"
 
 #include <iterator>
 #include <new>
@@ -221,15 +222,36 @@ class StringToAtomCache {
                       SystemAllocPolicy>;
   Map map_;
 
+  // Shorter strings are cached in a small direct-mapped table indexed by the
+  // address of the string. Code using a computed property key repeatedly then
+  // finds the atom without hashing the characters. Colliding strings simply
+  // replace each other.
+  struct RecentEntry {
+    JSLinearString* string = nullptr;
+    JSAtom* atom = nullptr;
+  };
+  static constexpr size_t NumRecentEntries = 64;
+  static_assert(mozilla::IsPowerOfTwo(NumRecentEntries));
+  mozilla::Array<RecentEntry, NumRecentEntries> recent_;
+
+  static size_t recentIndex(JSLinearString* s) {
+    return (uintptr_t(s) >> gc::CellAlignShift) & (NumRecentEntries - 1);
+  }
+
  public:
-  // Don't use the cache for short strings. Hashing them is less expensive.
+  // Don't use the hash map for short strings. Hashing them is less expensive.
   static constexpr size_t MinStringLength = 30;
 
   JSAtom* lookup(JSLinearString* s) {
     MOZ_ASSERT(!s->isAtom());
     if (!s->inStringToAtomCache()) {
       MOZ_ASSERT(!map_.lookup(s));
-      return nullptr;
+      const RecentEntry& entry = recent_[recentIndex(s)];
+      if (entry.string != s) {
+        return nullptr;
+      }
+      MOZ_ASSERT(EqualStrings(s, entry.atom));
+      return entry.atom;
     }
 
     MOZ_ASSERT(s->length() >= MinStringLength);
@@ -243,6 +265,9 @@ class StringToAtomCache {
   void maybePut(JSLinearString* s, JSAtom* atom) {
     MOZ_ASSERT(!s->isAtom());
     if (s->length() < MinStringLength) {
+      RecentEntry& entry = recent_[recentIndex(s)];
+      entry.string = s;
+      entry.atom = atom;
       return;
     }
     if (!map_.putNew(s, atom)) {
@@ -251,7 +276,12 @@ class StringToAtomCache {
     s->setInStringToAtomCache();
   }
 
-  void purge() { map_.clearAndCompact(); }
+  void purge() {
+    map_.clearAndCompact();
+    for (RecentEntry& entry : recent_) {
+      entry = RecentEntry();
+    }
+  }
 };
 
 class RuntimeCaches {
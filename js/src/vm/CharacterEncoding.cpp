@@ -24,15 +24,19 @@
 using mozilla::AsChars;
 using mozilla::AsciiValidUpTo;
 using mozilla::AsWritableChars;
+using mozilla::ConvertLatin1toUtf16;
 using mozilla::ConvertLatin1toUtf8Partial;
 using mozilla::ConvertUtf16toUtf8Partial;
+using mozilla::ConvertUtf8toUtf16;
 using mozilla::IsAscii;
 using mozilla::IsUtf8Latin1;
 using mozilla::LossyConvertUtf16toLatin1;
+using mozilla::LossyConvertUtf8toLatin1;
 using mozilla::Span;
 using mozilla::Tie;
 using mozilla::Tuple;
 using mozilla::Utf8Unit;
+using mozilla::Utf8ValidUpTo;
 
 using JS::Latin1CharsZ;
 using JS::TwoByteCharsZ;
@@ -364,6 +368,65 @@ static void CopyAndInflateUTF8IntoBuffer(JSContext* cx, const UTF8Chars src,
   dst[outlen] = CharT('\0');  // NUL char
 }
 
+// Convert valid UTF-8 input with the SIMD-accelerated converters of
+// encoding_rs. Returns false only on OOM. If |src| has to go through the
+// slower InflateUTF8ToUTF16, because it is invalid UTF-8 or because it does
+// not fit in CharT, returns true without allocating and leaves |*dst|
+// untouched.
+template <typename CharT>
+static bool TryInflateValidUTF8(JSContext* cx, Span<const char> src,
+                                arena_id_t destArenaId, CharT** dst,
+                                size_t* outlen) {
+  size_t srclen = src.Length();
+  bool allASCII = IsAscii(src);
+  bool fitsInCharT;
+  if constexpr (std::is_same_v<CharT, Latin1Char>) {
+    fitsInCharT = allASCII || IsUtf8Latin1(src);
+  } else {
+    fitsInCharT = allASCII || Utf8ValidUpTo(src) == srclen;
+  }
+  if (!fitsInCharT) {
+    return true;
+  }
+
+  // UTF-8 input never has fewer code units than its Latin-1 or UTF-16
+  // conversion. The two-byte converter needs an extra slot in |dst|, which is
+  // used for the NUL char.
+  CharT* chars = cx->pod_arena_malloc<CharT>(destArenaId, srclen + 1);
+  if (!chars) {
+    return false;
+  }
+
+  size_t len;
+  if (allASCII) {
+    if constexpr (std::is_same_v<CharT, Latin1Char>) {
+      memcpy(chars, src.Elements(), srclen);
+    } else {
+      ConvertLatin1toUtf16(src, Span(chars, srclen));
+    }
+    len = srclen;
+  } else if constexpr (std::is_same_v<CharT, Latin1Char>) {
+    len = LossyConvertUtf8toLatin1(src, AsWritableChars(Span(chars, srclen)));
+  } else {
+    len = ConvertUtf8toUtf16(src, Span(chars, srclen + 1));
+  }
+  MOZ_ASSERT(len <= srclen);
+
+  // Return the unused part of the buffer when the conversion shrank a lot. If
+  // shrinking fails, keep the larger buffer.
+  if (len < srclen / 2) {
+    if (CharT* shrunk = cx->maybe_pod_arena_realloc<CharT>(
+            destArenaId, chars, srclen + 1, len + 1)) {
+      chars = shrunk;
+    }
+  }
+
+  chars[len] = CharT('\0');  // NUL char
+  *dst = chars;
+  *outlen = len;
+  return true;
+}
+
 template <OnUTF8Error ErrorAction, typename CharsT>
 static CharsT InflateUTF8StringHelper(JSContext* cx, const UTF8Chars src,
                                       size_t* outlen, arena_id_t destArenaId) {
@@ -374,6 +437,19 @@ static CharsT InflateUTF8StringHelper(JSContext* cx, const UTF8Chars src,
 
   *outlen = 0;
 
+  // Valid input does not depend on ErrorAction and takes the fast path.
+  {
+    Span<unsigned char> unsignedSpan = src;
+    CharT* dst = nullptr;
+    if (!TryInflateValidUTF8(cx, AsChars(unsignedSpan), destArenaId, &dst,
+                             outlen)) {
+      return CharsT();
+    }
+    if (dst) {
+      return CharsT(dst, *outlen);
+    }
+  }
+
   size_t len = 0;
   bool allASCII = true;
   auto count = [&len, &allASCII](char16_t c) -> LoopDisposition {
@@ -630,6 +630,23 @@ struct DelazifyStrategy {
   [[nodiscard]] bool add(JSContext* cx,
                          const frontend::CompilationStencil& stencil,
                          ScriptIndex index);
+
+  // Same as `add` for the top-level script, except that only one out of every
+  // `partitionCount` functions found is queued, starting with the
+  // `partitionIndex`-th one. Functions are counted in the order in which `add`
+  // visits them, such that DelazifyTasks created for the same stencil with
+  // distinct partition indexes cover disjoint sets of functions. Functions
+  // nested in a queued function are added unconditionally once their parent is
+  // delazified.
+  [[nodiscard]] bool addPartition(JSContext* cx,
+                                  const frontend::CompilationStencil& stencil,
+                                  ScriptIndex topLevel, size_t partitionIndex,
+                                  size_t partitionCount);
+
+ private:
+  size_t partitionIndex_ = 0;
+  size_t partitionCount_ = 1;
+  size_t partitionVisited_ = 0;
 };
 
 // Delazify all functions using a Depth First traversal of the function-tree
@@ -698,18 +715,22 @@ struct DelazifyTask : public mozilla::LinkedListElement<DelazifyTask>,
   // Record any errors happening while parsing or generating bytecode.
   OffThreadFrontendErrors errors_;
 
-  // Create a new DelazifyTask and initialize it.
+  // Create a new DelazifyTask and initialize it, such that it only delazifies
+  // the `partitionIndex`-th partition of the functions of the stencil. See
+  // DelazifyStrategy::addPartition.
   static UniquePtr<DelazifyTask> Create(
       JSContext* cx, JSRuntime* runtime,
       const JS::ContextOptions& contextOptions,
       const JS::ReadOnlyCompileOptions& options,
-      const frontend::CompilationStencil& stencil);
+      const frontend::CompilationStencil& stencil, size_t partitionIndex = 0,
+      size_t partitionCount = 1);
 
   DelazifyTask(JSRuntime* runtime, const JS::ContextOptions& options);
 
   [[nodiscard]] bool init(
       JSContext* cx, const JS::ReadOnlyCompileOptions& options,
-      UniquePtr<frontend::ExtensibleCompilationStencil>&& initial);
+      UniquePtr<frontend::ExtensibleCompilationStencil>&& initial,
+      size_t partitionIndex, size_t partitionCount);
 
   // This function is called by delazify task thread to know whether the task
   // should be interrupted.
@@ -19,7 +19,9 @@
 #include "frontend/BytecodeCompiler.h"  // frontend::ParseModuleToExtensibleStencil
 #include "frontend/CompilationStencil.h"  // frontend::{CompilationStencil, ExtensibleCompilationStencil, CompilationInput, BorrowingCompilationStencil, ScriptStencilRef}
 #include "jit/IonCompileTask.h"
+#include "jit/JitOptions.h"
 #include "jit/JitRuntime.h"
+#include "jit/JitSpewer.h"
 #include "js/CompileOptions.h"  // JS::CompileOptions, JS::DecodeOptions, JS::ReadOnlyCompileOptions
 #include "js/ContextOptions.h"  // JS::ContextOptions
 #include "js/experimental/JSStencil.h"
@@ -634,6 +636,56 @@ void ParseTask::runTask(AutoLockHelperThreadState& lock) {
   cx->frontendCollectionPool().purge();
 }
 
+// Upper bound on the number of DelazifyTasks sharing the functions of a single
+// stencil. Each task owns a copy of the stencil, extended with every function
+// it delazifies, so this also bounds the memory used for large scripts.
+static const size_t MaxDelazifyPartitions = 4;
+
+using DelazifyTaskVector =
+    Vector<UniquePtr<DelazifyTask>, MaxDelazifyPartitions, SystemAllocPolicy>;
+
+static size_t DelazifyPartitionCount(const ReadOnlyCompileOptions& options) {
+  // Checking the concurrent delazification against the on-demand one does not
+  // benefit from using more threads.
+  if (options.eagerDelazificationStrategy() ==
+      JS::DelazificationOption::CheckConcurrentWithOnDemand) {
+    return 1;
+  }
+
+  // Use up to half of the parse threads, such that parse tasks and the main
+  // thread's own delazifications are not starved.
+  size_t threads = HelperThreadState().maxParseThreads() / 2;
+  return std::clamp(threads, size_t(1), MaxDelazifyPartitions);
+}
+
+// Create the DelazifyTasks which split the functions of |stencil| between
+// them, keeping only the tasks which have any function to delazify. Return
+// false if the first task, which starts caching delazifications for the
+// source, cannot be created. Functions of any other partition which failed to
+// be created are delazified on demand.
+static bool CreateDelazifyTasks(JSContext* cx, JSRuntime* runtime,
+                                const JS::ContextOptions& contextOptions,
+                                const ReadOnlyCompileOptions& options,
+                                const frontend::CompilationStencil& stencil,
+                                DelazifyTaskVector& tasks) {
+  size_t count = DelazifyPartitionCount(options);
+  for (size_t i = 0; i < count; i++) {
+    UniquePtr<DelazifyTask> task = DelazifyTask::Create(
+        cx, runtime, contextOptions, options, stencil, i, count);
+    if (!task) {
+      return i != 0;
+    }
+    if (task->strategy->done()) {
+      continue;
+    }
+    if (!tasks.append(std::move(task))) {
+      return i != 0;
+    }
+  }
+
+  return true;
+}
+
 void ParseTask::scheduleDelazifyTask(AutoLockHelperThreadState& lock) {
   if (!stencil_) {
     return;
@@ -646,22 +698,21 @@ void ParseTask::scheduleDelazifyTask(AutoLockHelperThreadState& lock) {
     return;
   }
 
-  UniquePtr<DelazifyTask> task;
+  DelazifyTaskVector tasks;
   {
     AutoSetHelperThreadContext usesContext(contextOptions, lock);
     AutoUnlockHelperThreadState unlock(lock);
     JSContext* cx = TlsContext.get();
     AutoSetContextRuntime ascr(runtime);
 
-    task =
-        DelazifyTask::Create(cx, runtime, contextOptions, options, *stencil_);
-    if (!task) {
+    if (!CreateDelazifyTasks(cx, runtime, contextOptions, options, *stencil_,
+                             tasks)) {
       return;
     }
   }
 
-  // Schedule delazification task if there is any function to delazify.
-  if (!task->strategy->done()) {
+  // Schedule the delazification tasks which have any function to delazify.
+  for (UniquePtr<DelazifyTask>& task : tasks) {
     HelperThreadState().submitTask(task.release(), lock);
   }
 }
@@ -857,16 +908,18 @@ bool js::StartOffThreadDelazification(
   }
 
   JSRuntime* runtime = cx->runtime();
-  UniquePtr<DelazifyTask> task;
-  task = DelazifyTask::Create(cx, runtime, cx->options(), options, stencil);
-  if (!task) {
+  DelazifyTaskVector tasks;
+  if (!CreateDelazifyTasks(cx, runtime, cx->options(), options, stencil,
+                           tasks)) {
     return false;
   }
 
-  // Schedule delazification task if there is any function to delazify.
-  if (!task->strategy->done()) {
+  // Schedule the delazification tasks which have any function to delazify.
+  if (!tasks.empty()) {
     AutoLockHelperThreadState lock;
-    HelperThreadState().submitTask(task.release(), lock);
+    for (UniquePtr<DelazifyTask>& task : tasks) {
+      HelperThreadState().submitTask(task.release(), lock);
+    }
   }
 
   return true;
@@ -908,6 +961,12 @@ bool DelazifyStrategy::add(JSContext* cx,
       continue;
     }
 
+    // Skip functions which belong to the partition of another DelazifyTask.
+    if (partitionCount_ > 1 &&
+        partitionVisited_++ % partitionCount_ != partitionIndex_) {
+      continue;
+    }
+
     // Maybe insert the new script index in the queue of functions to delazify.
     if (!insert(innerScriptIndex, innerScriptRef)) {
       ReportOutOfMemory(cx);
@@ -918,6 +977,23 @@ bool DelazifyStrategy::add(JSContext* cx,
   return true;
 }
 
+bool DelazifyStrategy::addPartition(JSContext* cx,
+                                    const frontend::CompilationStencil& stencil,
+                                    ScriptIndex topLevel,
+                                    size_t partitionIndex,
+                                    size_t partitionCount) {
+  MOZ_ASSERT(partitionIndex < partitionCount);
+  partitionIndex_ = partitionIndex;
+  partitionCount_ = partitionCount;
+  partitionVisited_ = 0;
+
+  bool ok = add(cx, stencil, topLevel);
+
+  // Inner functions of delazified functions are no longer partitioned.
+  partitionCount_ = 1;
+  return ok;
+}
+
 DelazifyStrategy::ScriptIndex LargeFirstDelazification::next() {
   std::swap(heap.back(), heap[0]);
   ScriptIndex result = heap.popCopy().second;
@@ -990,7 +1066,8 @@ bool LargeFirstDelazification::insert(ScriptIndex index,
 UniquePtr<DelazifyTask> DelazifyTask::Create(
     JSContext* cx, JSRuntime* runtime, const JS::ContextOptions& contextOptions,
     const JS::ReadOnlyCompileOptions& options,
-    const frontend::CompilationStencil& stencil) {
+    const frontend::CompilationStencil& stencil, size_t partitionIndex,
+    size_t partitionCount) {
   // DelazifyTask are capturing errors. This is created here to capture errors
   // as-if they were part of the to-be constructed DelazifyTask. This is also
   // the reason why we move this structure to the DelazifyTask once created.
@@ -1008,11 +1085,15 @@ UniquePtr<DelazifyTask> DelazifyTask::Create(
     return nullptr;
   }
 
-  RefPtr<ScriptSource> source(stencil.source);
-  StencilCache& cache = runtime->caches().delazificationCache;
-  if (!cache.startCaching(std::move(source))) {
-    ReportOutOfMemory(cx);
-    return nullptr;
+  // The tasks of all partitions share the same cache entries, only the first
+  // one registers the source.
+  if (partitionIndex == 0) {
+    RefPtr<ScriptSource> source(stencil.source);
+    StencilCache& cache = runtime->caches().delazificationCache;
+    if (!cache.startCaching(std::move(source))) {
+      ReportOutOfMemory(cx);
+      return nullptr;
+    }
   }
 
   // Clone the extensible stencil to be used for eager delazification.
@@ -1023,7 +1104,8 @@ UniquePtr<DelazifyTask> DelazifyTask::Create(
     return nullptr;
   }
 
-  if (!task->init(cx, options, std::move(initial))) {
+  if (!task->init(cx, options, std::move(initial), partitionIndex,
+                  partitionCount)) {
     // In case of errors, skip this and delazify on-demand.
     return nullptr;
   }
@@ -1040,7 +1122,8 @@ DelazifyTask::DelazifyTask(JSRuntime* runtime,
 
 bool DelazifyTask::init(
     JSContext* cx, const JS::ReadOnlyCompileOptions& options,
-    UniquePtr<frontend::ExtensibleCompilationStencil>&& initial) {
+    UniquePtr<frontend::ExtensibleCompilationStencil>&& initial,
+    size_t partitionIndex, size_t partitionCount) {
   using namespace js::frontend;
   if (!merger.setInitial(cx, std::move(initial))) {
     return false;
@@ -1077,7 +1160,8 @@ bool DelazifyTask::init(
   // Queue functions from the top-level to be delazify.
   BorrowingCompilationStencil borrow(merger.getResult());
   ScriptIndex topLevel{0};
-  return strategy->add(cx, borrow, topLevel);
+  return strategy->addPartition(cx, borrow, topLevel, partitionIndex,
+                                partitionCount);
 }
 
 size_t DelazifyTask::sizeOfExcludingThis(
@@ -2072,20 +2156,47 @@ bool GlobalHelperThreadState::canStartPromiseHelperTask(
                               /*isMaster=*/true, lock);
 }
 
+// The rate at which a script gains warm-up counts while its compilation waits
+// in the worklist, relative to its length like the warm-up density below.
+static double IonCompileTaskWarmUpVelocity(jit::IonCompileTask* task,
+                                           TimeStamp now) {
+  double waitMs = (now - task->creationTime()).ToMilliseconds();
+  return double(task->warmUpCountSinceCreation()) /
+         double(task->script()->length()) / (waitMs + 1.0);
+}
+
 static bool IonCompileTaskHasHigherPriority(jit::IonCompileTask* first,
-                                            jit::IonCompileTask* second) {
+                                            jit::IonCompileTask* second,
+                                            TimeStamp now) {
   // Return true if priority(first) > priority(second).
   //
   // This method can return whatever it wants, though it really ought to be a
   // total order. The ordering is allowed to race (change on the fly), however.
 
-  // A higher warm-up counter indicates a higher priority.
+  // Prefer scripts which are still warming up quickly: scripts which have
+  // gone cold since their compilation was requested can wait.
+  double firstVelocity = IonCompileTaskWarmUpVelocity(first, now);
+  double secondVelocity = IonCompileTaskWarmUpVelocity(second, now);
+  if (firstVelocity != secondVelocity) {
+    return firstVelocity > secondVelocity;
+  }
+
+  // Otherwise a higher warm-up counter indicates a higher priority.
   jit::JitScript* firstJitScript = first->script()->jitScript();
   jit::JitScript* secondJitScript = second->script()->jitScript();
   return firstJitScript->warmUpCount() / first->script()->length() >
          secondJitScript->warmUpCount() / second->script()->length();
 }
 
+// Whether |task| has waited for a long time while the main thread runs JS, but
+// its script has not run at all since the compilation was requested.
+static bool IsStaleIonCompileTask(jit::IonCompileTask* task, TimeStamp now) {
+  uint32_t timeoutMs = jit::JitOptions.staleIonCompileTimeoutMs;
+  return timeoutMs && task->isMainThreadRunningJS() &&
+         task->warmUpCountSinceCreation() == 0 &&
+         (now - task->creationTime()).ToMilliseconds() >= double(timeoutMs);
+}
+
 HelperThreadTask* GlobalHelperThreadState::maybeGetIonCompileTask(
     const AutoLockHelperThreadState& lock) {
   if (!canStartIonCompileTask(lock)) {
@@ -2134,6 +2245,30 @@ jit::IonCompileTask* GlobalHelperThreadState::highestPriorityPendingIonCompile(
   auto& worklist = ionWorklist(lock);
   MOZ_ASSERT(!worklist.empty());
 
+  TimeStamp now = TimeStamp::Now();
+
+  // Cancel compilations whose scripts have gone cold while they were waiting.
+  // Like other cancelled tasks, these are cleaned up by the main thread.
+  for (size_t i = 0; i < worklist.length(); i++) {
+    jit::IonCompileTask* task = worklist[i];
+    if (!IsStaleIonCompileTask(task, now)) {
+      continue;
+    }
+
+    jit::JitSpew(jit::JitSpew_IonAbort,
+                 "Cancelling stale off-thread compilation of %s:%u:%u",
+                 task->script()->filename(), task->script()->lineno(),
+                 task->script()->column());
+
+    task->alloc().lifoAlloc()->setReadWrite();
+    FinishOffThreadIonCompile(task, lock);
+    remove(worklist, &i);
+
+    JSRuntime* rt = task->script()->runtimeFromAnyThread();
+    rt->mainContextFromAnyThread()->requestInterrupt(
+        InterruptReason::AttachIonCompilations);
+  }
+
   // Get the highest priority IonCompileTask which has not started compilation
   // yet.
   size_t index = worklist.length();
@@ -2142,7 +2277,7 @@ jit::IonCompileTask* GlobalHelperThreadState::highestPriorityPendingIonCompile(
       continue;
     }
     if (i < index ||
-        IonCompileTaskHasHigherPriority(worklist[i], worklist[index])) {
+        IonCompileTaskHasHigherPriority(worklist[i], worklist[index], now)) {
       index = i;
     }
   }
@@ -19,6 +19,7 @@
 #include "builtin/AtomicsObject.h"
 #include "builtin/TestingFunctions.h"
 #include "gc/Statistics.h"
+#include "irregexp/RegExpAPI.h"
 #include "jit/Assembler.h"
 #include "jit/AtomicOperations.h"
 #include "jit/Ion.h"
@@ -178,6 +179,8 @@ JS_PUBLIC_API const char* JS::detail::InitWithFailureDiagnostic(
 
   RETURN_IF_FAIL(js::InitDateTimeState());
 
+  RETURN_IF_FAIL(js::irregexp::InitBytecodeCache());
+
 #ifdef MOZ_VTUNE
   RETURN_IF_FAIL(js::vtune::Initialize());
 #endif
@@ -287,6 +290,8 @@ JS_PUBLIC_API void JS_ShutDown(void) {
 
   js::FinishDateTimeState();
 
+  js::irregexp::FinishBytecodeCache();
+
   js::jit::ShutdownJit();
 
   MOZ_ASSERT_IF(!JSRuntime::hasLiveRuntimes(), !js::LiveMappedBufferCount());
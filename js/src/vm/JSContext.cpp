@@ -33,6 +33,7 @@
 #include "jspubtd.h"
 #include "jstypes.h"
 
+#include "builtin/Promise.h"  // js::IsPromiseReactionRecord
 #include "gc/GCContext.h"
 #include "gc/Marking.h"
 #include "gc/PublicIterators.h"
@@ -844,9 +845,12 @@ void InternalJobQueue::runJobs(JSContext* cx) {
         JS::JobQueueIsEmpty(cx);
       }
 
-      AutoRealm ar(cx, &job->as<JSFunction>());
+      AutoRealm ar(cx, job);
       {
-        if (!JS::Call(cx, UndefinedHandleValue, job, args, &rval)) {
+        bool ok = IsPromiseReactionRecord(job)
+                      ? RunPromiseReactionRecordJob(cx, job)
+                      : JS::Call(cx, UndefinedHandleValue, job, args, &rval);
+        if (!ok) {
           // Nothing we can do about uncatchable exceptions.
           if (!cx->isExceptionPending()) {
             continue;
@@ -8,12 +8,14 @@
 
 #include "mozilla/Range.h"
 #include "mozilla/RangedPtr.h"
+#include "mozilla/SIMD.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/TextUtils.h"
 
 #include "jsnum.h"
 
 #include "builtin/Array.h"
+#include "gc/Tracer.h"
 #include "js/friend/ErrorMessages.h"  // js::GetErrorMessage, JSMSG_*
 #include "util/StringBuffer.h"
 #include "vm/PlainObject.h"  // js::NewPlainObjectWithProperties
@@ -27,6 +29,7 @@ using mozilla::AsciiAlphanumericToNumber;
 using mozilla::IsAsciiDigit;
 using mozilla::IsAsciiHexDigit;
 using mozilla::RangedPtr;
+using mozilla::SIMD;
 
 JSONParserBase::~JSONParserBase() {
   for (size_t i = 0; i < stack.length(); i++) {
@@ -54,6 +57,10 @@ void JSONParserBase::trace(JSTracer* trc) {
       elem.properties().trace(trc);
     }
   }
+
+  for (auto& shape : lastObjectShapes) {
+    TraceNullableRoot(trc, &shape, "JSONParser last object shape");
+  }
 }
 
 template <typename CharT>
@@ -99,6 +106,23 @@ bool JSONParserBase::errorReturn() {
   return parseType == ParseType::AttemptForEval;
 }
 
+// Return a pointer to the first character in [ptr, end) that ends a run of
+// unescaped string characters: a quote, a backslash or a control character.
+// Returns |end| if there is no such character.
+static inline const Latin1Char* FindStringSpecialChar(const Latin1Char* ptr,
+                                                      const Latin1Char* end) {
+  const char* result = SIMD::memchrAny2OrLessThan8(
+      reinterpret_cast<const char*>(ptr), '"', '\\', 0x20, end - ptr);
+  return result ? reinterpret_cast<const Latin1Char*>(result) : end;
+}
+
+static inline const char16_t* FindStringSpecialChar(const char16_t* ptr,
+                                                    const char16_t* end) {
+  const char16_t* result =
+      SIMD::memchrAny2OrLessThan16(ptr, '"', '\\', 0x20, end - ptr);
+  return result ? result : end;
+}
+
 template <typename CharT>
 template <JSONParserBase::StringType ST>
 JSONParserBase::Token JSONParser<CharT>::readString() {
@@ -120,7 +144,8 @@ JSONParserBase::Token JSONParser<CharT>::readString() {
    * string directly from the source text.
    */
   CharPtr start = current;
-  for (; current < end; current++) {
+  current += FindStringSpecialChar(current.get(), end.get()) - current.get();
+  if (current < end) {
     if (*current == '"') {
       size_t length = current - start;
       current++;
@@ -134,14 +159,12 @@ JSONParserBase::Token JSONParser<CharT>::readString() {
       return stringToken(str);
     }
 
-    if (*current == '\\') {
-      break;
-    }
-
     if (*current <= 0x001F) {
       error("bad control character in string literal");
       return token(Error);
     }
+
+    MOZ_ASSERT(*current == '\\');
   }
 
   /*
@@ -244,11 +267,7 @@ JSONParserBase::Token JSONParser<CharT>::readString() {
     }
 
     start = current;
-    for (; current < end; current++) {
-      if (*current == '"' || *current == '\\' || *current <= 0x001F) {
-        break;
-      }
-    }
+    current += FindStringSpecialChar(current.get(), end.get()) - current.get();
   } while (current < end);
 
   error("unterminated string");
@@ -578,12 +597,28 @@ inline bool JSONParserBase::finishObject(MutableHandleValue vp,
                                          PropertyVector& properties) {
   MOZ_ASSERT(&properties == &stack.back().properties());
 
-  JSObject* obj = NewPlainObjectWithMaybeDuplicateKeys(cx, properties.begin(),
-                                                       properties.length());
+  size_t depth = stack.length() - 1;
+  Shape* shapeHint =
+      depth < lastObjectShapes.length() ? lastObjectShapes[depth] : nullptr;
+
+  PlainObject* obj = NewPlainObjectWithMaybeDuplicateKeys(
+      cx, properties.begin(), properties.length(), shapeHint);
   if (!obj) {
     return false;
   }
 
+  // Remember the shape if it describes exactly these keys, which is not the
+  // case for dictionary objects or if there were duplicate or index keys.
+  if (properties.length() > 0 && !obj->inDictionaryMode() &&
+      obj->slotSpan() == properties.length() &&
+      obj->getDenseInitializedLength() == 0) {
+    if (depth >= lastObjectShapes.length() &&
+        !lastObjectShapes.resize(depth + 1)) {
+      return false;
+    }
+    lastObjectShapes[depth] = obj->shape();
+  }
+
   vp.setObject(*obj);
   if (!freeProperties.append(&properties)) {
     return false;
@@ -811,5 +846,417 @@ bool JSONParser<CharT>::parse(MutableHandleValue vp) {
   return true;
 }
 
+template <typename CharT>
+static inline const CharT* SkipJSONWhitespace(const CharT* current,
+                                              const CharT* end) {
+  while (current < end && IsJSONWhitespace(*current)) {
+    current++;
+  }
+  return current;
+}
+
+template <typename CharT>
+typename JSONTape<CharT>::Result JSONTape<CharT>::readString(
+    Kind kind, const CharT*& current) {
+  const CharT* end = source.end().get();
+  MOZ_ASSERT(current < end);
+  MOZ_ASSERT(*current == '"');
+
+  const CharT* start = ++current;
+  current = FindStringSpecialChar(current, end);
+  if (current < end && *current == '"') {
+    if (!append(kind)) {
+      return Result::OOM;
+    }
+    Entry& entry = entries.back();
+    entry.length = current - start;
+    entry.offset = start - source.begin().get();
+    current++;
+    return Result::Ok;
+  }
+
+  // The string contains escapes, so unescape it into |escapedChars|. See
+  // JSONParser::readString for the grammar.
+  size_t escapedStart = escapedChars.length();
+  while (true) {
+    if (!escapedChars.append(start, current)) {
+      return Result::OOM;
+    }
+    if (current == end) {
+      return Result::SyntaxError;
+    }
+
+    CharT c = *current++;
+    if (c == '"') {
+      break;
+    }
+    if (c != '\\' || current == end) {
+      return Result::SyntaxError;
+    }
+
+    char16_t unescaped;
+    switch (*current++) {
+      case '"':
+        unescaped = '"';
+        break;
+      case '/':
+        unescaped = '/';
+        break;
+      case '\\':
+        unescaped = '\\';
+        break;
+      case 'b':
+        unescaped = '\b';
+        break;
+      case 'f':
+        unescaped = '\f';
+        break;
+      case 'n':
+        unescaped = '\n';
+        break;
+      case 'r':
+        unescaped = '\r';
+        break;
+      case 't':
+        unescaped = '\t';
+        break;
+      case 'u':
+        if (end - current < 4 ||
+            !(IsAsciiHexDigit(current[0]) && IsAsciiHexDigit(current[1]) &&
+              IsAsciiHexDigit(current[2]) && IsAsciiHexDigit(current[3]))) {
+          return Result::SyntaxError;
+        }
+        unescaped = (AsciiAlphanumericToNumber(current[0]) << 12) |
+                    (AsciiAlphanumericToNumber(current[1]) << 8) |
+                    (AsciiAlphanumericToNumber(current[2]) << 4) |
+                    (AsciiAlphanumericToNumber(current[3]));
+        current += 4;
+        break;
+      default:
+        return Result::SyntaxError;
+    }
+    if (!escapedChars.append(unescaped)) {
+      return Result::OOM;
+    }
+
+    start = current;
+    current = FindStringSpecialChar(current, end);
+  }
+
+  if (!append(kind)) {
+    return Result::OOM;
+  }
+  Entry& entry = entries.back();
+  entry.escaped = true;
+  entry.length = escapedChars.length() - escapedStart;
+  entry.offset = escapedStart;
+  return Result::Ok;
+}
+
+template <typename CharT>
+typename JSONTape<CharT>::Result JSONTape<CharT>::readNumber(
+    const CharT*& current) {
+  const CharT* end = source.end().get();
+  MOZ_ASSERT(current < end);
+  MOZ_ASSERT(IsAsciiDigit(*current) || *current == '-');
+
+  // See JSONParser::readNumber for the grammar.
+  bool negative = *current == '-';
+  if (negative && ++current == end) {
+    return Result::SyntaxError;
+  }
+
+  const CharT* digitStart = current;
+  if (!IsAsciiDigit(*current)) {
+    return Result::SyntaxError;
+  }
+  if (*current++ != '0') {
+    while (current < end && IsAsciiDigit(*current)) {
+      current++;
+    }
+  }
+
+  double d;
+  if ((current == end ||
+       (*current != '.' && *current != 'e' && *current != 'E')) &&
+      size_t(current - digitStart) < strlen("9007199254740992")) {
+    d = ParseDecimalNumber(
+        mozilla::Range<const CharT>(digitStart, current - digitStart));
+  } else {
+    if (current < end && *current == '.') {
+      if (++current == end || !IsAsciiDigit(*current)) {
+        return Result::SyntaxError;
+      }
+      do {
+        current++;
+      } while (current < end && IsAsciiDigit(*current));
+    }
+
+    if (current < end && (*current == 'e' || *current == 'E')) {
+      if (++current == end) {
+        return Result::SyntaxError;
+      }
+      if ((*current == '+' || *current == '-') && ++current == end) {
+        return Result::SyntaxError;
+      }
+      if (!IsAsciiDigit(*current)) {
+        return Result::SyntaxError;
+      }
+      do {
+        current++;
+      } while (current < end && IsAsciiDigit(*current));
+    }
+
+    d = FullStringToDouble(digitStart, current);
+  }
+
+  if (!append(Kind::Number)) {
+    return Result::OOM;
+  }
+  entries.back().number = negative ? -d : d;
+  return Result::Ok;
+}
+
+template <typename CharT>
+typename JSONTape<CharT>::Result JSONTape<CharT>::readLiteral(
+    const char* literal, Kind kind, const CharT*& current) {
+  size_t length = strlen(literal);
+  if (size_t(source.end().get() - current) < length) {
+    return Result::SyntaxError;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if (current[i] != CharT(literal[i])) {
+      return Result::SyntaxError;
+    }
+  }
+  current += length;
+  return append(kind) ? Result::Ok : Result::OOM;
+}
+
+template <typename CharT>
+typename JSONTape<CharT>::Result JSONTape<CharT>::build() {
+  MOZ_ASSERT(entries.empty());
+
+  const CharT* current = source.begin().get();
+  const CharT* end = source.end().get();
+
+  // The kinds of the currently open containers, ArrayStart or ObjectStart.
+  Vector<Kind, 10, SystemAllocPolicy> containers;
+
+  // Read a property name and the following colon, leaving |current| at the
+  // start of the property's value.
+  auto readPropertyName = [&]() {
+    current = SkipJSONWhitespace(current, end);
+    if (current == end || *current != '"') {
+      return Result::SyntaxError;
+    }
+    Result result = readString(Kind::PropertyName, current);
+    if (result != Result::Ok) {
+      return result;
+    }
+    current = SkipJSONWhitespace(current, end);
+    if (current == end || *current != ':') {
+      return Result::SyntaxError;
+    }
+    current++;
+    return Result::Ok;
+  };
+
+  while (true) {
+    // Read a value, or open a container and start reading its contents.
+    current = SkipJSONWhitespace(current, end);
+    if (current == end) {
+      return Result::SyntaxError;
+    }
+
+    Result result;
+    switch (*current) {
+      case '[':
+        current++;
+        if (!append(Kind::ArrayStart) || !containers.append(Kind::ArrayStart)) {
+          return Result::OOM;
+        }
+        current = SkipJSONWhitespace(current, end);
+        if (current == end || *current != ']') {
+          continue;
+        }
+        current++;
+        containers.popBack();
+        result = append(Kind::ArrayEnd) ? Result::Ok : Result::OOM;
+        break;
+      case '{':
+        current++;
+        if (!append(Kind::ObjectStart) ||
+            !containers.append(Kind::ObjectStart)) {
+          return Result::OOM;
+        }
+        current = SkipJSONWhitespace(current, end);
+        if (current == end || *current != '}') {
+          result = readPropertyName();
+          if (result != Result::Ok) {
+            return result;
+          }
+          continue;
+        }
+        current++;
+        containers.popBack();
+        result = append(Kind::ObjectEnd) ? Result::Ok : Result::OOM;
+        break;
+      case '"':
+        result = readString(Kind::String, current);
+        break;
+      case 't':
+        result = readLiteral("true", Kind::True, current);
+        break;
+      case 'f':
+        result = readLiteral("false", Kind::False, current);
+        break;
+      case 'n':
+        result = readLiteral("null", Kind::Null, current);
+        break;
+      default:
+        if (*current != '-' && !IsAsciiDigit(*current)) {
+          return Result::SyntaxError;
+        }
+        result = readNumber(current);
+        break;
+    }
+    if (result != Result::Ok) {
+      return result;
+    }
+
+    // After a value, close any finished containers and move on to the next
+    // element or property.
+    while (true) {
+      current = SkipJSONWhitespace(current, end);
+      if (containers.empty()) {
+        return current == end ? Result::Ok : Result::SyntaxError;
+      }
+      if (current == end) {
+        return Result::SyntaxError;
+      }
+
+      bool inArray = containers.back() == Kind::ArrayStart;
+      CharT c = *current++;
+      if (c == ',') {
+        if (!inArray) {
+          result = readPropertyName();
+          if (result != Result::Ok) {
+            return result;
+          }
+        }
+        break;
+      }
+      if (c != (inArray ? ']' : '}')) {
+        return Result::SyntaxError;
+      }
+      containers.popBack();
+      if (!append(inArray ? Kind::ArrayEnd : Kind::ObjectEnd)) {
+        return Result::OOM;
+      }
+    }
+  }
+}
+
+template <typename CharT>
+bool JSONTape<CharT>::materialize(JSContext* cx, MutableHandleValue vp) const {
+  MOZ_ASSERT(!entries.empty());
+
+  // Values of the open containers. Objects keep their property names (as
+  // atoms) and values interleaved.
+  RootedValueVector values(cx);
+
+  // For each open container, the index of its first value in |values|.
+  Vector<size_t, 10> containerStarts(cx);
+
+  Rooted<IdValueVector> properties(cx, IdValueVector(cx));
+
+  auto newString = [&](const Entry& entry) -> JSLinearString* {
+    if (entry.escaped) {
+      const char16_t* chars = escapedChars.begin() + entry.offset;
+      return entry.kind == Kind::PropertyName
+                 ? AtomizeChars(cx, chars, entry.length)
+                 : NewStringCopyN<CanGC>(cx, chars, entry.length);
+    }
+    const CharT* chars = source.begin().get() + entry.offset;
+    return entry.kind == Kind::PropertyName
+               ? AtomizeChars(cx, chars, entry.length)
+               : NewStringCopyN<CanGC>(cx, chars, entry.length);
+  };
+
+  for (const Entry& entry : entries) {
+    Value value;
+    switch (entry.kind) {
+      case Kind::Null:
+        value = NullValue();
+        break;
+      case Kind::True:
+        value = BooleanValue(true);
+        break;
+      case Kind::False:
+        value = BooleanValue(false);
+        break;
+      case Kind::Number:
+        value = NumberValue(entry.number);
+        break;
+      case Kind::String:
+      case Kind::PropertyName: {
+        JSLinearString* str = newString(entry);
+        if (!str) {
+          return false;
+        }
+        value = StringValue(str);
+        break;
+      }
+      case Kind::ArrayStart:
+      case Kind::ObjectStart:
+        if (!containerStarts.append(values.length())) {
+          return false;
+        }
+        continue;
+      case Kind::ArrayEnd: {
+        size_t start = containerStarts.popCopy();
+        ArrayObject* arr = NewDenseCopiedArray(cx, values.length() - start,
+                                               values.begin() + start);
+        if (!arr) {
+          return false;
+        }
+        values.erase(values.begin() + start, values.end());
+        value = ObjectValue(*arr);
+        break;
+      }
+      case Kind::ObjectEnd: {
+        size_t start = containerStarts.popCopy();
+        MOZ_ASSERT((values.length() - start) % 2 == 0);
+        properties.clear();
+        for (size_t i = start; i < values.length(); i += 2) {
+          jsid id = AtomToId(&values[i].toString()->asAtom());
+          if (!properties.emplaceBack(id, values[i + 1])) {
+            return false;
+          }
+        }
+        PlainObject* obj = NewPlainObjectWithMaybeDuplicateKeys(
+            cx, properties.begin(), properties.length());
+        if (!obj) {
+          return false;
+        }
+        values.erase(values.begin() + start, values.end());
+        value = ObjectValue(*obj);
+        break;
+      }
+    }
+    if (!values.append(value)) {
+      return false;
+    }
+  }
+
+  MOZ_ASSERT(containerStarts.empty());
+  MOZ_ASSERT(values.length() == 1);
+  vp.set(values[0]);
+  return true;
+}
+
 template class js::JSONParser<Latin1Char>;
 template class js::JSONParser<char16_t>;
+template class js::JSONTape<Latin1Char>;
+template class js::JSONTape<char16_t>;
@@ -13,6 +13,8 @@
 #include "jspubtd.h"
 
 #include "ds/IdValuePair.h"
+#include "js/AllocPolicy.h"
+#include "js/Vector.h"
 #include "vm/StringType.h"
 
 namespace js {
@@ -117,6 +119,11 @@ class MOZ_STACK_CLASS JSONParserBase {
   Vector<ElementVector*, 5> freeElements;
   Vector<PropertyVector*, 5> freeProperties;
 
+  // Shape of the most recent object finished at each nesting depth. Arrays of
+  // records usually repeat the same keys, so this lets us create the next
+  // object at that depth with the same shape without looking up its keys.
+  Vector<Shape*, 10> lastObjectShapes;
+
 #ifdef DEBUG
   Token lastToken;
 #endif
@@ -126,7 +133,8 @@ class MOZ_STACK_CLASS JSONParserBase {
         parseType(parseType),
         stack(cx),
         freeElements(cx),
-        freeProperties(cx)
+        freeProperties(cx),
+        lastObjectShapes(cx)
 #ifdef DEBUG
         ,
         lastToken(Error)
@@ -142,7 +150,8 @@ class MOZ_STACK_CLASS JSONParserBase {
         parseType(other.parseType),
         stack(std::move(other.stack)),
         freeElements(std::move(other.freeElements)),
-        freeProperties(std::move(other.freeProperties))
+        freeProperties(std::move(other.freeProperties)),
+        lastObjectShapes(std::move(other.lastObjectShapes))
 #ifdef DEBUG
         ,
         lastToken(std::move(other.lastToken))
@@ -279,6 +288,72 @@ class MutableWrappedPtrOperations<JSONParser<CharT>, Wrapper>
   }
 };
 
+// JSONTape checks JSON text and records its values without a JSContext or any
+// access to the GC heap, so that the expensive part of parsing can happen on a
+// helper thread. Values are recorded in document order, with arrays and
+// objects delimited by start and end entries; strings without escapes refer
+// back to the source text. The text must stay alive and unchanged until the
+// tape is materialized.
+//
+// materialize() then creates the JS value described by the tape on the main
+// thread. On a syntax error no position or message is recorded: the caller is
+// expected to run the normal JSONParser on the same text to report it.
+template <typename CharT>
+class JSONTape {
+ public:
+  enum class Result { Ok, SyntaxError, OOM };
+
+ private:
+  enum class Kind : uint8_t {
+    Null,
+    True,
+    False,
+    Number,
+    String,
+    PropertyName,
+    ArrayStart,
+    ArrayEnd,
+    ObjectStart,
+    ObjectEnd
+  };
+
+  struct Entry {
+    Kind kind;
+
+    // For String and PropertyName entries, whether the characters are in
+    // |escapedChars| rather than the source text.
+    bool escaped = false;
+
+    size_t length = 0;
+    union {
+      double number;
+      size_t offset;
+    };
+
+    explicit Entry(Kind kind) : kind(kind), offset(0) {}
+  };
+
+  const mozilla::Range<const CharT> source;
+  Vector<Entry, 0, SystemAllocPolicy> entries;
+  Vector<char16_t, 0, SystemAllocPolicy> escapedChars;
+
+  [[nodiscard]] bool append(Kind kind) { return entries.emplaceBack(kind); }
+
+  Result readString(Kind kind, const CharT*& current);
+  Result readNumber(const CharT*& current);
+  Result readLiteral(const char* literal, Kind kind, const CharT*& current);
+
+ public:
+  explicit JSONTape(const mozilla::Range<const CharT> source)
+      : source(source) {}
+
+  // May be called on any thread.
+  Result build();
+
+  // Must be called on the main thread after build() returned Result::Ok.
+  bool materialize(JSContext* cx, MutableHandleValue vp) const;
+};
+
 } /* namespace js */
 
 #endif /* vm_JSONParser_h */
@@ -1784,8 +1784,56 @@ bool ScriptSource::addDelazificationToIncrementalEncoding(
   return true;
 }
 
+// Record in |stencil| how far each script compiled from it has warmed up, so
+// that these scripts can skip part of their warm-up when the encoded stencil
+// is instantiated again. Scripts are matched to their stencils by source
+// extent. This is only a hint, so it is silently skipped on OOM.
+static void RecordWarmUpHints(JSScript* topLevel,
+                              frontend::ExtensibleCompilationStencil& stencil) {
+  JS::AutoCheckCannotGC nogc;
+
+  auto extentKey = [](const SourceExtent& extent) {
+    return (uint64_t(extent.sourceStart) << 32) | extent.sourceEnd;
+  };
+
+  HashMap<uint64_t, uint32_t, DefaultHasher<uint64_t>, SystemAllocPolicy>
+      warmUpCounts;
+  Vector<JSScript*, 8, SystemAllocPolicy> worklist;
+  if (!worklist.append(topLevel)) {
+    return;
+  }
+
+  while (!worklist.empty()) {
+    JSScript* script = worklist.popCopy();
+    if (uint32_t count = script->getWarmUpCount()) {
+      if (!warmUpCounts.put(extentKey(script->extent()), count)) {
+        return;
+      }
+    }
+
+    // Lazy functions have not run, and neither have their inner functions.
+    for (JS::GCCellPtr gcThing : script->gcthings()) {
+      if (!gcThing.is<JSObject>() || !gcThing.as<JSObject>().is<JSFunction>()) {
+        continue;
+      }
+      JSFunction* fun = &gcThing.as<JSObject>().as<JSFunction>();
+      if (fun->hasBytecode() && !worklist.append(fun->nonLazyScript())) {
+        return;
+      }
+    }
+  }
+
+  for (frontend::ScriptStencilExtra& scriptExtra : stencil.scriptExtra) {
+    if (auto p = warmUpCounts.lookup(extentKey(scriptExtra.extent))) {
+      scriptExtra.warmUpHint =
+          uint16_t(std::min(p->value(), uint32_t(UINT16_MAX)));
+    }
+  }
+}
+
 bool ScriptSource::xdrFinalizeEncoder(JSContext* cx,
-                                      JS::TranscodeBuffer& buffer) {
+                                      JS::TranscodeBuffer& buffer,
+                                      JSScript* topLevel) {
   if (!hasEncoder()) {
     JS_ReportErrorASCII(cx, "XDR encoding failure");
     return false;
@@ -1795,6 +1843,10 @@ bool ScriptSource::xdrFinalizeEncoder(JSContext* cx,
 
   XDRStencilEncoder encoder(cx, buffer);
 
+  if (topLevel) {
+    RecordWarmUpHints(topLevel, xdrEncoder_.merger_->getResult());
+  }
+
   frontend::BorrowingCompilationStencil borrowingStencil(
       xdrEncoder_.merger_->getResult());
   XDRResult res = encoder.codeStencil(this, borrowingStencil);
@@ -2160,6 +2212,7 @@ bool SharedImmutableScriptData::shareScriptData(
 
   // Calculate the hash before taking the lock. Because the data is reference
   // counted, it also will be freed after releasing the lock if necessary.
+  data->hash();
   SharedImmutableScriptData::Hasher::Lookup lookup(data);
 
   AutoLockScriptData lock(cx->runtime());
@@ -2428,6 +2481,17 @@ bool JSScript::fullyInitFromStencil(
 
   script->initSharedData(scriptData);
 
+  // Scripts that ran hot in the session that encoded this stencil start out
+  // partially warmed up. Stop one short of the Baseline JIT threshold: Warp
+  // relies on the ICs attached while the script runs in Baseline.
+  if (stencil.isInitialStencil()) {
+    uint32_t hint = stencil.scriptExtra[scriptIndex].warmUpHint;
+    uint32_t limit = jit::JitOptions.baselineJitWarmUpThreshold;
+    if (hint && limit > 0) {
+      script->warmUpData_.resetWarmUpCount(std::min(hint, limit - 1));
+    }
+  }
+
   // NOTE: JSScript is now constructed and should be linked in.
   rollbackGuard.release();
 
@@ -3223,8 +3287,8 @@ void JSScript::resetWarmUpCounterToDelayIonCompilation() {
   }
 }
 
-gc::AllocSite* JSScript::createAllocSite() {
-  return jitScript()->createAllocSite(this);
+gc::AllocSite* JSScript::createAllocSite(uint32_t pcOffset) {
+  return jitScript()->createAllocSite(this, pcOffset);
 }
 
 void JSScript::AutoDelazify::holdScript(JS::HandleFunction fun) {
@@ -1052,8 +1052,10 @@ class ScriptSource {
 
   // Linearize the encoded content in the |buffer| provided as argument to
   // |xdrEncodeTopLevel|, and free the XDR encoder.  In case of errors, the
-  // |buffer| is considered undefined.
-  bool xdrFinalizeEncoder(JSContext* cx, JS::TranscodeBuffer& buffer);
+  // |buffer| is considered undefined.  If |topLevel| is non-null, the warm-up
+  // counts of it and its inner scripts are recorded as hints in the encoding.
+  bool xdrFinalizeEncoder(JSContext* cx, JS::TranscodeBuffer& buffer,
+                          JSScript* topLevel);
 };
 
 // [SMDOC] ScriptSourceObject
@@ -2081,8 +2083,9 @@ class JSScript : public js::BaseScript {
   inline bool isDebuggee() const;
 
   // Create an allocation site associated with this script/JitScript to track
-  // nursery allocations.
-  js::gc::AllocSite* createAllocSite();
+  // nursery allocations. |pcOffset| is the offset of the allocating op in this
+  // script, or AllocSite::InvalidPCOffset if the op is in an inlined script.
+  js::gc::AllocSite* createAllocSite(uint32_t pcOffset);
 
   // A helper class to prevent relazification of the given function's script
   // while it's holding on to it.  This class automatically roots the script.
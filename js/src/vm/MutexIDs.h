@@ -46,6 +46,7 @@
   _(BufferStreamState, 500)           \
   _(SharedArrayGrow, 500)             \
   _(SharedImmutableScriptData, 500)   \
+  _(RegExpBytecodeCache, 500)         \
   _(WasmFuncTypeIdSet, 500)           \
   _(WasmCodeProfilingLabels, 500)     \
   _(WasmCodeBytesEnd, 500)            \
@@ -239,12 +239,19 @@ enum class KeysKind { UniqueNames, Unknown };
 template <KeysKind Kind>
 static PlainObject* NewPlainObjectWithProperties(JSContext* cx,
                                                  IdValuePair* properties,
-                                                 size_t nproperties) {
+                                                 size_t nproperties,
+                                                 Shape* shapeHint = nullptr) {
   auto& cache = cx->realm()->newPlainObjectWithPropsCache;
 
-  // If we recently created an object with these properties, we can use that
-  // Shape directly.
-  if (Shape* shape = cache.lookup(properties, nproperties)) {
+  // If the caller's hint or a recently created object has these properties, we
+  // can use that Shape directly.
+  Shape* shape = nullptr;
+  if (shapeHint && ShapeMatches(properties, nproperties, shapeHint)) {
+    shape = shapeHint;
+  } else {
+    shape = cache.lookup(properties, nproperties);
+  }
+  if (shape) {
     Rooted<Shape*> shapeRoot(cx, shape);
     PlainObject* obj = PlainObject::createWithShape(cx, shapeRoot);
     if (!obj) {
@@ -330,3 +337,11 @@ PlainObject* js::NewPlainObjectWithMaybeDuplicateKeys(JSContext* cx,
   return NewPlainObjectWithProperties<KeysKind::Unknown>(cx, properties,
                                                          nproperties);
 }
+
+PlainObject* js::NewPlainObjectWithMaybeDuplicateKeys(JSContext* cx,
+                                                      IdValuePair* properties,
+                                                      size_t nproperties,
+                                                      Shape* shapeHint) {
+  return NewPlainObjectWithProperties<KeysKind::Unknown>(
+      cx, properties, nproperties, shapeHint);
+}
@@ -107,6 +107,12 @@ extern PlainObject* NewPlainObjectWithUniqueNames(JSContext* cx,
 extern PlainObject* NewPlainObjectWithMaybeDuplicateKeys(
     JSContext* cx, IdValuePair* properties, size_t nproperties);
 
+// As above, but try |shapeHint| before the realm's cache of recently used
+// shapes. The hint is used only if it has exactly the given keys in order.
+extern PlainObject* NewPlainObjectWithMaybeDuplicateKeys(
+    JSContext* cx, IdValuePair* properties, size_t nproperties,
+    Shape* shapeHint);
+
 }  // namespace js
 
 #endif  // vm_PlainObject_h
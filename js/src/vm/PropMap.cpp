@@ -748,8 +748,16 @@ void DictionaryPropMap::maybeCompact(JSContext* cx,
   }
 
   // Heuristic: only compact if the number of holes >= the number of (non-hole)
-  // entries.
-  if (map->holeCount_ < table->entryCount()) {
+  // entries. Large maps used as hash tables, with properties added and removed
+  // repeatedly, are also compacted once the holes take up a whole map and at
+  // least a fifth of all entries. This bounds the memory wasted by holes, and
+  // the cost of compacting stays amortized over the removals since the last
+  // compaction.
+  uint32_t entryCount = table->entryCount();
+  bool manyHoles = map->holeCount_ >= entryCount;
+  bool manyHolesInLargeMap = map->holeCount_ >= PropMap::Capacity &&
+                             map->holeCount_ * 4 >= entryCount;
+  if (!manyHoles && !manyHolesInLargeMap) {
     return;
   }
 
@@ -200,8 +200,9 @@
 // new shape for the object).
 //
 // Unlike shared maps, dictionary maps can have holes between two property keys
-// after removing a property. When there are more holes than properties, the
-// map is compacted. See DictionaryPropMap::maybeCompact.
+// after removing a property. When there are more holes than properties, or
+// when the holes of a large map use more than a fifth of its entries, the map
+// is compacted. See DictionaryPropMap::maybeCompact.
 
 namespace js {
 
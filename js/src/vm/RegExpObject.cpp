@@ -559,6 +559,7 @@ void RegExpShared::traceChildren(JSTracer* trc) {
       TraceNullableEdge(trc, &comp.jitCode, "RegExpShared code");
     }
     TraceNullableEdge(trc, &groupsTemplate_, "RegExpShared groups template");
+    TraceNullableEdge(trc, &prefixAtom_, "RegExpShared prefix atom");
   }
 }
 
@@ -656,6 +657,17 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
     return RegExpRunStatus_Error;
   }
 
+  // A match must begin with the literal prefix, if there is one, so skip
+  // ahead to its first occurrence using a (vectorized) string search instead
+  // of trying the matcher at every position before it.
+  if (JSAtom* prefix = re->prefixAtom()) {
+    int found = StringFindPattern(input, prefix, start);
+    if (found < 0) {
+      return RegExpRunStatus_Success_NotFound;
+    }
+    start = size_t(found);
+  }
+
   uint32_t interruptRetries = 0;
   const uint32_t maxInterruptRetries = 4;
   do {
@@ -116,6 +116,9 @@ class RegExpShared
 
   RegExpShared::Kind kind_ = Kind::Unparsed;
   GCPtr<JSAtom*> patternAtom_;
+
+  // For Kind::RegExp, a literal string that every match must begin with.
+  GCPtr<JSAtom*> prefixAtom_ = {};
   uint32_t maxRegisters_ = 0;
   uint32_t ticks_ = 0;
 
@@ -205,6 +208,13 @@ class RegExpShared
 
   JSAtom* patternAtom() const { return patternAtom_; }
 
+  JSAtom* prefixAtom() const { return prefixAtom_; }
+  void setPrefixAtom(JSAtom* prefix) {
+    MOZ_ASSERT(kind() == Kind::Unparsed);
+    MOZ_ASSERT(!sticky());
+    prefixAtom_ = prefix;
+  }
+
   JS::RegExpFlags getFlags() const { return flags; }
 
   bool hasIndices() const { return flags.hasIndices(); }
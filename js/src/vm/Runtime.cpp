@@ -30,6 +30,7 @@
 
 #include "frontend/CompilationStencil.h"
 #include "gc/PublicIterators.h"
+#include "irregexp/RegExpAPI.h"
 #include "jit/IonCompileTask.h"
 #include "jit/JitRuntime.h"
 #include "jit/Simulator.h"
@@ -346,6 +347,11 @@ void JSRuntime::addSizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf,
         selfHostStencilInput_->sizeOfIncludingThis(mallocSizeOf) +
         selfHostStencil_->sizeOfIncludingThis(mallocSizeOf) +
         selfHostScriptMap.ref().shallowSizeOfExcludingThis(mallocSizeOf);
+
+    // The bytecode cache is shared by every runtime in the process, so only
+    // the top-level runtime reports it.
+    rtSizes->regExpBytecodeCache +=
+        irregexp::SizeOfBytecodeCache(mallocSizeOf);
   }
 
   JSContext* cx = mainContextFromAnyThread();
@@ -9,12 +9,17 @@
 #include "mozilla/BinarySearch.h"
 #include "mozilla/Casting.h"
 #include "mozilla/DebugOnly.h"
+#include "mozilla/IntegerTypeTraits.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/Maybe.h"
+#include "mozilla/SIMD.h"
 #include "mozilla/ScopeExit.h"  // mozilla::MakeScopeExit
 #include "mozilla/Utf8.h"       // mozilla::Utf8Unit
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <limits>
 
 #include "jsdate.h"
 #include "jsfriendapi.h"
@@ -1408,6 +1413,251 @@ static bool intrinsic_TypedArrayInitFromPackedArray(JSContext* cx,
   return true;
 }
 
+template <typename T>
+static void TypedArrayFillRange(TypedArrayObject* obj, const Value& value,
+                                size_t start, size_t end) {
+  T native = ElementSpecific<T, UnsharedOps>::infallibleValueToNative(value);
+  SharedMem<T*> data = obj->dataPointerEither().cast<T*>() + start;
+  size_t count = end - start;
+
+  if (obj->isSharedMemory()) {
+    for (size_t i = 0; i < count; i++) {
+      SharedOps::store(data + i, native);
+    }
+  } else {
+    // Let the compiler emit a vectorized loop, or a memset for single byte
+    // and zero values.
+    std::fill_n(data.unwrapUnshared(), count, native);
+  }
+}
+
+static bool intrinsic_TypedArrayNativeFill(JSContext* cx, unsigned argc,
+                                           Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  MOZ_ASSERT(args.length() == 4);
+  MOZ_ASSERT(args[0].isObject());
+  AssertNonNegativeInteger(args[2]);
+  AssertNonNegativeInteger(args[3]);
+
+  TypedArrayObject* obj = &args[0].toObject().as<TypedArrayObject>();
+  MOZ_ASSERT(!obj->hasDetachedBuffer());
+
+  size_t start = size_t(args[2].toNumber());
+  size_t end = size_t(args[3].toNumber());
+  MOZ_ASSERT(start < end);
+  MOZ_ASSERT(end <= obj->length());
+
+  // The value has already been converted with ToNumber or ToBigInt.
+  const Value& value = args[1];
+  MOZ_ASSERT_IF(Scalar::isBigIntType(obj->type()), value.isBigInt());
+  MOZ_ASSERT_IF(!Scalar::isBigIntType(obj->type()), value.isNumber());
+
+  switch (obj->type()) {
+#define FILL_TYPED_ARRAY(_, T, N)                    \
+  case Scalar::N:                                    \
+    TypedArrayFillRange<T>(obj, value, start, end); \
+    break;
+    JS_FOR_EACH_TYPED_ARRAY(FILL_TYPED_ARRAY)
+#undef FILL_TYPED_ARRAY
+
+    default:
+      MOZ_CRASH("TypedArrayNativeFill with a typed array with bogus type");
+  }
+
+  args.rval().setUndefined();
+  return true;
+}
+
+// How elements of a typed array can be compared against a search value.
+enum class TypedArraySearchKind {
+  // No element can match.
+  None,
+
+  // Only elements with the same bit pattern as the needle match.
+  Bitwise,
+
+  // Elements must be compared numerically with the needle, or checked for
+  // NaN if the needle is NaN.
+  Numeric,
+};
+
+// Convert |value| to the native element type T for a search with either
+// strict equality (indexOf) or SameValueZero (includes).
+template <typename T>
+static TypedArraySearchKind TypedArraySearchNeedle(const Value& value,
+                                                   bool sameValueZero,
+                                                   T* needle) {
+  if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>) {
+    if (!value.isBigInt()) {
+      return TypedArraySearchKind::None;
+    }
+    bool fits;
+    if constexpr (std::is_same_v<T, int64_t>) {
+      fits = BigInt::isInt64(value.toBigInt(), needle);
+    } else {
+      fits = BigInt::isUint64(value.toBigInt(), needle);
+    }
+    return fits ? TypedArraySearchKind::Bitwise : TypedArraySearchKind::None;
+  } else {
+    if (!value.isNumber()) {
+      return TypedArraySearchKind::None;
+    }
+    double d = value.toNumber();
+
+    if constexpr (std::is_floating_point_v<T>) {
+      // NaN is only found by SameValueZero, and +0 and -0 are equal but have
+      // different bit patterns.
+      if (std::isnan(d)) {
+        *needle = T(d);
+        return sameValueZero ? TypedArraySearchKind::Numeric
+                             : TypedArraySearchKind::None;
+      }
+      if (d == 0) {
+        *needle = 0;
+        return TypedArraySearchKind::Numeric;
+      }
+      if (std::isfinite(d) &&
+          mozilla::Abs(d) > double(std::numeric_limits<T>::max())) {
+        return TypedArraySearchKind::None;
+      }
+    } else {
+      if (!(d >= double(std::numeric_limits<T>::min()) &&
+            d <= double(std::numeric_limits<T>::max()))) {
+        return TypedArraySearchKind::None;
+      }
+    }
+
+    T native = T(d);
+    if (double(native) != d) {
+      return TypedArraySearchKind::None;
+    }
+    *needle = native;
+    return TypedArraySearchKind::Bitwise;
+  }
+}
+
+// Search the elements of |obj| in [start, length) for |needle|, using the
+// vectorized mozilla::SIMD searches for bitwise matches in unshared memory.
+template <typename T>
+static mozilla::Maybe<size_t> TypedArraySearchRange(
+    TypedArrayObject* obj, T needle, TypedArraySearchKind kind, size_t start) {
+  MOZ_ASSERT(kind != TypedArraySearchKind::None);
+
+  size_t length = obj->length();
+  if (start >= length) {
+    return mozilla::Nothing();
+  }
+
+  SharedMem<T*> data = obj->dataPointerEither().cast<T*>();
+
+  if (kind == TypedArraySearchKind::Bitwise && !obj->isSharedMemory()) {
+    using UnsignedT =
+        typename mozilla::UnsignedStdintTypeForSize<sizeof(T)>::Type;
+    auto bits = mozilla::BitwiseCast<UnsignedT>(needle);
+    const UnsignedT* base =
+        reinterpret_cast<const UnsignedT*>(data.unwrapUnshared());
+    const UnsignedT* begin = base + start;
+    size_t count = length - start;
+
+    const UnsignedT* found;
+    if constexpr (sizeof(T) == 1) {
+      found = reinterpret_cast<const UnsignedT*>(mozilla::SIMD::memchr8(
+          reinterpret_cast<const char*>(begin), char(bits), count));
+    } else if constexpr (sizeof(T) == 2) {
+      found = reinterpret_cast<const UnsignedT*>(mozilla::SIMD::memchr16(
+          reinterpret_cast<const char16_t*>(begin), char16_t(bits), count));
+    } else if constexpr (sizeof(T) == 4) {
+      found = mozilla::SIMD::memchr32(begin, bits, count);
+    } else {
+      found = mozilla::SIMD::memchr64(begin, bits, count);
+    }
+    if (!found) {
+      return mozilla::Nothing();
+    }
+    return mozilla::Some(size_t(found - base));
+  }
+
+  // Shared memory may be modified concurrently, so use racy loads instead.
+  bool findNaN = false;
+  if constexpr (std::is_floating_point_v<T>) {
+    findNaN = std::isnan(needle);
+  }
+  for (size_t i = start; i < length; i++) {
+    T element = SharedOps::load(data + i);
+    bool matches;
+    if constexpr (std::is_floating_point_v<T>) {
+      matches = findNaN ? std::isnan(element) : element == needle;
+    } else {
+      matches = element == needle;
+    }
+    if (matches) {
+      return mozilla::Some(i);
+    }
+  }
+  return mozilla::Nothing();
+}
+
+static mozilla::Maybe<size_t> TypedArraySearch(TypedArrayObject* obj,
+                                               const Value& value,
+                                               size_t start,
+                                               bool sameValueZero) {
+  switch (obj->type()) {
+#define SEARCH_TYPED_ARRAY(ExternalT, NativeT, N)                           \
+  case Scalar::N: {                                                         \
+    ExternalT needle;                                                       \
+    auto kind = TypedArraySearchNeedle<ExternalT>(value, sameValueZero,     \
+                                                  &needle);                 \
+    if (kind == TypedArraySearchKind::None) {                               \
+      return mozilla::Nothing();                                            \
+    }                                                                       \
+    return TypedArraySearchRange<ExternalT>(obj, needle, kind, start);      \
+  }
+    JS_FOR_EACH_TYPED_ARRAY(SEARCH_TYPED_ARRAY)
+#undef SEARCH_TYPED_ARRAY
+
+    default:
+      MOZ_CRASH("TypedArraySearch with a typed array with bogus type");
+  }
+}
+
+// TypedArrayNativeIndexOf(typedArray, searchElement, fromIndex)
+//
+// Steps 11-12 of %TypedArray%.prototype.indexOf.
+static bool intrinsic_TypedArrayNativeIndexOf(JSContext* cx, unsigned argc,
+                                              Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  MOZ_ASSERT(args.length() == 3);
+  MOZ_ASSERT(args[0].isObject());
+  AssertNonNegativeInteger(args[2]);
+
+  TypedArrayObject* obj = &args[0].toObject().as<TypedArrayObject>();
+  size_t start = size_t(args[2].toNumber());
+
+  mozilla::Maybe<size_t> index =
+      TypedArraySearch(obj, args[1], start, /* sameValueZero = */ false);
+  args.rval().setNumber(index ? double(*index) : -1.0);
+  return true;
+}
+
+// TypedArrayNativeIncludes(typedArray, searchElement, fromIndex)
+//
+// Steps 11-12 of %TypedArray%.prototype.includes.
+static bool intrinsic_TypedArrayNativeIncludes(JSContext* cx, unsigned argc,
+                                               Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  MOZ_ASSERT(args.length() == 3);
+  MOZ_ASSERT(args[0].isObject());
+  AssertNonNegativeInteger(args[2]);
+
+  TypedArrayObject* obj = &args[0].toObject().as<TypedArrayObject>();
+  size_t start = size_t(args[2].toNumber());
+
+  mozilla::Maybe<size_t> index =
+      TypedArraySearch(obj, args[1], start, /* sameValueZero = */ true);
+  args.rval().setBoolean(index.isSome());
+  return true;
+}
+
 static bool intrinsic_RegExpCreate(JSContext* cx, unsigned argc, Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
 
@@ -2144,6 +2394,10 @@ static const JSFunctionSpec intrinsic_functions[] = {
                     0, IntrinsicTypedArrayByteOffset),
     JS_INLINABLE_FN("TypedArrayElementSize", intrinsic_TypedArrayElementSize, 1,
                     0, IntrinsicTypedArrayElementSize),
+    JS_FN("TypedArrayNativeFill", intrinsic_TypedArrayNativeFill, 4, 0),
+    JS_FN("TypedArrayNativeIncludes", intrinsic_TypedArrayNativeIncludes, 3,
+          0),
+    JS_FN("TypedArrayNativeIndexOf", intrinsic_TypedArrayNativeIndexOf, 3, 0),
     JS_FN("TypedArrayInitFromPackedArray",
           intrinsic_TypedArrayInitFromPackedArray, 2, 0),
     JS_INLINABLE_FN("TypedArrayLength", intrinsic_TypedArrayLength, 1, 0,
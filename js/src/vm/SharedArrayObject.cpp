@@ -104,6 +104,8 @@ WasmSharedArrayRawBuffer* WasmSharedArrayRawBuffer::AllocateWasm(
 
   uint8_t* buffer = reinterpret_cast<uint8_t*>(p) + gc::SystemPageSize();
   uint8_t* base = buffer - sizeof(WasmSharedArrayRawBuffer);
+
+  MaybeAdviseHugeBufferMemory(buffer, computedMappedSize, 0, accessibleSize);
   auto* rawbuf = new (base) WasmSharedArrayRawBuffer(
       buffer, length, indexType, clampedMaxPages,
       sourceMaxPages.valueOr(Pages(0)), computedMappedSize);
@@ -165,6 +167,9 @@ bool WasmSharedArrayRawBuffer::wasmGrowToPagesInPlace(const Lock&,
     return false;
   }
 
+  MaybeAdviseHugeBufferMemory(dataPointerShared().unwrap(/* for madvise */),
+                              mappedSize_, length_, newLength);
+
   // We rely on CommitBufferMemory (and therefore memmap/VirtualAlloc) to only
   // return once it has committed memory for all threads. We only update with a
   // new length once this has occurred.
@@ -642,6 +642,12 @@ class SharedImmutableScriptData {
  private:
   ImmutableScriptData* isd_ = nullptr;
 
+  // Hash of the immutable data, used to share identical data across scripts.
+  // It is either computed when the data is first shared, or decoded along with
+  // the data such that decoding does not have to read all of it. Zero if not
+  // known yet.
+  mozilla::HashNumber hash_ = 0;
+
   // End of fields.
 
   friend class ::JSScript;
@@ -703,6 +709,17 @@ class SharedImmutableScriptData {
   size_t immutableDataLength() const { return isd_->immutableData().Length(); }
   uint32_t nfixed() const { return isd_->nfixed; }
 
+  // Compute the hash of the immutable data, unless it is already known. This
+  // should only be called while no other thread can access this data, i.e.
+  // before it gets shared.
+  mozilla::HashNumber hash() {
+    if (!hash_) {
+      mozilla::Span<const uint8_t> immutableData = isd_->immutableData();
+      hash_ = mozilla::HashBytes(immutableData.data(), immutableData.size());
+    }
+    return hash_;
+  }
+
   ImmutableScriptData* get() { return isd_; }
 
   void setOwn(js::UniquePtr<ImmutableScriptData>&& isd) {
@@ -723,10 +740,7 @@ class SharedImmutableScriptData {
 struct SharedImmutableScriptData::Hasher {
   using Lookup = RefPtr<SharedImmutableScriptData>;
 
-  static mozilla::HashNumber hash(const Lookup& l) {
-    mozilla::Span<const uint8_t> immutableData = l->isd_->immutableData();
-    return mozilla::HashBytes(immutableData.data(), immutableData.size());
-  }
+  static mozilla::HashNumber hash(const Lookup& l) { return l->hash(); }
 
   static bool match(SharedImmutableScriptData* entry, const Lookup& lookup) {
     return (entry->isd_->immutableData() == lookup->isd_->immutableData());
@@ -447,6 +447,12 @@ class JSString : public js::gc::CellWithLengthAndFlags {
 
   inline bool getChar(JSContext* cx, size_t index, char16_t* code);
 
+  // Return the smallest node of this string, at most a few rope levels deep,
+  // which contains the characters [*start, *start + length). |start| is
+  // updated to be relative to the returned node. Flattening the returned node
+  // is cheaper than flattening the whole rope.
+  inline JSString* ropeNodeContaining(size_t* start, size_t length);
+
   /* Strings have either Latin1 or TwoByte chars. */
   bool hasLatin1Chars() const { return flags() & LATIN1_CHARS_BIT; }
   bool hasTwoByteChars() const { return !(flags() & LATIN1_CHARS_BIT); }
@@ -1626,31 +1632,44 @@ inline bool ValueToStringBuffer(JSContext* cx, const Value& v,
 
 } /* namespace js */
 
+inline JSString* JSString::ropeNodeContaining(size_t* start, size_t length) {
+  MOZ_ASSERT(*start + length <= this->length());
+
+  // Bound the descent, such that repeated accesses to a deep rope, for example
+  // one built by appending in a loop, flatten a sub-rope once instead of
+  // walking down the full depth of the rope each time.
+  static constexpr size_t MaxDepth = 8;
+
+  JSString* str = this;
+  for (size_t depth = 0; depth < MaxDepth && str->isRope(); depth++) {
+    JSRope* rope = &str->asRope();
+    size_t leftLength = rope->leftChild()->length();
+    if (*start + length <= leftLength) {
+      str = rope->leftChild();
+    } else if (*start >= leftLength) {
+      str = rope->rightChild();
+      *start -= leftLength;
+    } else {
+      break;
+    }
+  }
+  return str;
+}
+
 MOZ_ALWAYS_INLINE bool JSString::getChar(JSContext* cx, size_t index,
                                          char16_t* code) {
   MOZ_ASSERT(index < length());
 
   /*
-   * Optimization for one level deep ropes.
-   * This is common for the following pattern:
+   * Avoid flattening the whole rope, only flatten the node which holds the
+   * character. This is common for the following pattern:
    *
    * while() {
    *   text = text.substr(0, x) + "bla" + text.substr(x)
    *   test.charCodeAt(x + 1)
    * }
    */
-  JSString* str;
-  if (isRope()) {
-    JSRope* rope = &asRope();
-    if (uint32_t(index) < rope->leftChild()->length()) {
-      str = rope->leftChild();
-    } else {
-      str = rope->rightChild();
-      index -= rope->leftChild()->length();
-    }
-  } else {
-    str = this;
-  }
+  JSString* str = ropeNodeContaining(&index, 1);
 
   if (!str->ensureLinear(cx)) {
     return false;
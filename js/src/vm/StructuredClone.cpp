@@ -44,6 +44,7 @@
 
 #include "builtin/DataViewObject.h"
 #include "builtin/MapObject.h"
+#include "ds/IdValuePair.h"  // js::IdValuePair, js::IdValueVector
 #include "js/Array.h"        // JS::GetArrayLength, JS::IsArrayObject
 #include "js/ArrayBuffer.h"  // JS::{ArrayBufferHasData,DetachArrayBuffer,IsArrayBufferObject,New{,Mapped}ArrayBufferWithContents,ReleaseMappedArrayBufferContents}
 #include "js/Date.h"
@@ -142,6 +143,9 @@ enum StructuredDataType : uint32_t {
 
   SCTAG_ERROR_OBJECT,
 
+  SCTAG_TEMPLATED_OBJECT,
+  SCTAG_PACKED_ARRAY_OBJECT,
+
   SCTAG_TYPED_ARRAY_V1_MIN = 0xFFFF0100,
   SCTAG_TYPED_ARRAY_V1_INT8 = SCTAG_TYPED_ARRAY_V1_MIN + Scalar::Int8,
   SCTAG_TYPED_ARRAY_V1_UINT8 = SCTAG_TYPED_ARRAY_V1_MIN + Scalar::Uint8,
@@ -425,6 +429,9 @@ struct JSStructuredCloneReader {
         objs(in.context()),
         objState(in.context(), in.context()),
         allObjs(in.context()),
+        templateKeys(in.context()),
+        templateKeyStarts(in.context()),
+        templateShapes(in.context(), in.context()),
         numItemsRead(0),
         callbacks(cb),
         closure(cbClosure) {
@@ -482,6 +489,12 @@ struct JSStructuredCloneReader {
 
   [[nodiscard]] bool readObjectField(HandleObject obj, HandleValue key);
 
+  [[nodiscard]] bool readPrimitiveFields(uint64_t count,
+                                         MutableHandleValueVector values);
+  [[nodiscard]] bool readTemplatedObject(uint32_t index,
+                                         MutableHandleValue vp);
+  [[nodiscard]] bool readPackedArray(uint32_t length, MutableHandleValue vp);
+
   [[nodiscard]] bool startRead(MutableHandleValue vp,
                                gc::InitialHeap strHeap = gc::DefaultHeap);
 
@@ -523,6 +536,13 @@ struct JSStructuredCloneReader {
   // one `undefined` placeholder value (the readTypedArray hack).
   RootedValueVector allObjs;
 
+  // The keys of every object template read so far, in template order. The
+  // keys of template i start at templateKeyStarts[i]. templateShapes[i] is the
+  // shape of the last object created from template i, if it can be reused.
+  RootedIdVector templateKeys;
+  Vector<size_t> templateKeyStarts;
+  Rooted<GCVector<HeapPtr<Shape*>>> templateShapes;
+
   size_t numItemsRead;
 
   // The user defined callbacks that will be used for cloning.
@@ -561,6 +581,7 @@ struct JSStructuredCloneWriter {
         objectEntries(cx),
         otherEntries(cx),
         memory(cx),
+        shapeTemplates(cx),
         transferable(cx, tVal),
         transferableObjects(cx, TransferableObjectsList(cx)),
         cloneDataPolicy(cloneDataPolicy) {
@@ -600,6 +621,8 @@ struct JSStructuredCloneWriter {
   bool startObject(HandleObject obj, bool* backref);
   bool writePrimitive(HandleValue v);
   bool startWrite(HandleValue v);
+  bool writeTemplatedObject(HandleObject obj, bool* written);
+  bool writePackedArray(HandleObject obj, bool* written);
   bool traverseObject(HandleObject obj, ESClass cls);
   bool traverseMap(HandleObject obj);
   bool traverseSet(HandleObject obj);
@@ -650,6 +673,11 @@ struct JSStructuredCloneWriter {
                 SystemAllocPolicy>;
   Rooted<CloneMemory> memory;
 
+  // The template index of each shape written by writeTemplatedObject.
+  using ShapeTemplateMap =
+      GCHashMap<Shape*, uint32_t, MovableCellHasher<Shape*>, SystemAllocPolicy>;
+  Rooted<ShapeTemplateMap> shapeTemplates;
+
   // Set of transferable objects
   RootedValue transferable;
   using TransferableObjectsList = GCVector<JSObject*>;
@@ -1548,6 +1576,144 @@ static bool TryAppendNativeProperties(JSContext* cx, HandleObject obj,
   return true;
 }
 
+// Plain objects whose own properties are all enumerable, string-keyed data
+// properties holding primitives are written in one go, as a reference to the
+// key list of their shape followed by the property values in order. The key
+// list is only written the first time a shape is seen, so an array of records
+// with the same shape stores each key once:
+//
+//     <SCTAG_TEMPLATED_OBJECT, template index>
+//       <key count> <key>...     (only when the template index is new)
+//       <value>...
+//
+// The values are primitives, so no script can run and change the object
+// between reading its shape and writing its values.
+bool JSStructuredCloneWriter::writeTemplatedObject(HandleObject obj,
+                                                   bool* written) {
+  *written = false;
+
+  if (!obj->is<PlainObject>()) {
+    return true;
+  }
+
+  Handle<PlainObject*> nobj = obj.as<PlainObject>();
+  if (nobj->inDictionaryMode() || nobj->isIndexed() ||
+      nobj->getDenseInitializedLength() != 0) {
+    return true;
+  }
+
+  // The slots of a non-dictionary object are allocated in property order, so
+  // they can be written in slot order.
+  uint32_t count = nobj->slotSpan();
+  if (count == 0) {
+    return true;
+  }
+
+  RootedIdVector keys(context());
+  if (!keys.resize(count)) {
+    return false;
+  }
+  for (ShapePropertyIter<NoGC> iter(nobj->shape()); !iter.done(); iter++) {
+    if (!iter->isDataProperty() || !iter->enumerable() ||
+        iter->key().isSymbol()) {
+      return true;
+    }
+
+    const Value& v = nobj->getSlot(iter->slot());
+    if (v.isObject() || v.isSymbol()) {
+      return true;
+    }
+
+    MOZ_ASSERT(iter->slot() < count);
+    keys[iter->slot()].set(iter->key());
+  }
+
+  ShapeTemplateMap::AddPtr p = shapeTemplates.lookupForAdd(nobj->shape());
+  if (p) {
+    if (!out.writePair(SCTAG_TEMPLATED_OBJECT, p->value())) {
+      return false;
+    }
+  } else {
+    uint32_t index = shapeTemplates.count();
+    if (!shapeTemplates.add(p, nobj->shape(), index)) {
+      ReportOutOfMemory(context());
+      return false;
+    }
+
+    if (!out.writePair(SCTAG_TEMPLATED_OBJECT, index) || !out.write(count)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      if (!writeString(SCTAG_STRING, keys[i].get().toString())) {
+        return false;
+      }
+    }
+  }
+
+  RootedValue val(context());
+  for (size_t i = 0; i < count; i++) {
+    val = nobj->getSlot(i);
+    if (!writePrimitive(val)) {
+      return false;
+    }
+  }
+
+  *written = true;
+  return true;
+}
+
+// Packed arrays of primitives without any other own properties are written as
+// their length followed by the elements, leaving out the index keys:
+//
+//     <SCTAG_PACKED_ARRAY_OBJECT, length>
+//       <value>...
+bool JSStructuredCloneWriter::writePackedArray(HandleObject obj,
+                                               bool* written) {
+  *written = false;
+
+  if (!obj->is<ArrayObject>()) {
+    return true;
+  }
+
+  Handle<ArrayObject*> arr = obj.as<ArrayObject>();
+  uint32_t length = arr->length();
+  if (arr->isIndexed() || arr->getDenseInitializedLength() != length) {
+    return true;
+  }
+
+  // The only own property must be |length|. Anything else goes through the
+  // generic path. ShapePropertyIter starts at the most recently added
+  // property, so check them all rather than just the first.
+  for (ShapePropertyIter<NoGC> iter(arr->shape()); !iter.done(); iter++) {
+    if (iter->key() != NameToId(context()->names().length)) {
+      return true;
+    }
+  }
+
+  for (uint32_t i = 0; i < length; i++) {
+    const Value& v = arr->getDenseElement(i);
+    if (v.isMagic(JS_ELEMENTS_HOLE) || v.isObject() || v.isSymbol()) {
+      return true;
+    }
+  }
+
+  if (!out.writePair(SCTAG_PACKED_ARRAY_OBJECT,
+                     NativeEndian::swapToLittleEndian(length))) {
+    return false;
+  }
+
+  RootedValue val(context());
+  for (uint32_t i = 0; i < length; i++) {
+    val = arr->getDenseElement(i);
+    if (!writePrimitive(val)) {
+      return false;
+    }
+  }
+
+  *written = true;
+  return true;
+}
+
 // Objects are written as a "preorder" traversal of the object graph: object
 // "headers" (the class tag and any data needed for initial construction) are
 // visited first, then the children are recursed through (where children are
@@ -1574,6 +1740,19 @@ static bool TryAppendNativeProperties(JSContext* cx, HandleObject obj,
 // ends with its end-of-children marker) and so it can be presented indented.
 // But see traverseMap below for how this looks different for Maps.
 bool JSStructuredCloneWriter::traverseObject(HandleObject obj, ESClass cls) {
+  // Objects holding only primitives are written without a traversal.
+  bool written;
+  if (cls == ESClass::Array) {
+    if (!writePackedArray(obj, &written)) {
+      return false;
+    }
+  } else if (!writeTemplatedObject(obj, &written)) {
+    return false;
+  }
+  if (written) {
+    return true;
+  }
+
   size_t count;
   bool optimized = false;
   if (!TryAppendNativeProperties(context(), obj, &objectEntries, &count,
@@ -2964,6 +3143,18 @@ bool JSStructuredCloneReader::startRead(MutableHandleValue vp,
       break;
     }
 
+    case SCTAG_TEMPLATED_OBJECT:
+      if (!readTemplatedObject(data, vp)) {
+        return false;
+      }
+      break;
+
+    case SCTAG_PACKED_ARRAY_OBJECT:
+      if (!readPackedArray(NativeEndian::swapFromLittleEndian(data), vp)) {
+        return false;
+      }
+      break;
+
     case SCTAG_BACK_REFERENCE_OBJECT: {
       if (data >= allObjs.length() || !allObjs[data].isObject()) {
         JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
@@ -3651,6 +3842,120 @@ bool JSStructuredCloneReader::readObjectField(HandleObject obj,
   return true;
 }
 
+// Read the values of an object written by writeTemplatedObject or
+// writePackedArray. They must all be primitives.
+bool JSStructuredCloneReader::readPrimitiveFields(
+    uint64_t count, MutableHandleValueVector values) {
+  RootedValue val(context());
+  for (uint64_t i = 0; i < count; i++) {
+    if (!startRead(&val)) {
+      return false;
+    }
+    if (val.isObject()) {
+      JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                                JSMSG_SC_BAD_SERIALIZED_DATA,
+                                "primitive value expected");
+      return false;
+    }
+    if (!values.append(val)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool JSStructuredCloneReader::readTemplatedObject(uint32_t index,
+                                                  MutableHandleValue vp) {
+  if (index > templateKeyStarts.length()) {
+    JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                              JSMSG_SC_BAD_SERIALIZED_DATA,
+                              "invalid object template");
+    return false;
+  }
+
+  // A new template is followed by its keys.
+  if (index == templateKeyStarts.length()) {
+    uint64_t count;
+    if (!in.read(&count)) {
+      return false;
+    }
+    if (!templateKeyStarts.append(templateKeys.length()) ||
+        !templateShapes.append(nullptr)) {
+      return false;
+    }
+
+    RootedValue key(context());
+    RootedId id(context());
+    for (uint64_t i = 0; i < count; i++) {
+      if (!startRead(&key)) {
+        return false;
+      }
+      if (!key.isString()) {
+        JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                                  JSMSG_SC_BAD_SERIALIZED_DATA,
+                                  "property key expected");
+        return false;
+      }
+      if (!PrimitiveValueToId<CanGC>(context(), key, &id) ||
+          !templateKeys.append(id)) {
+        return false;
+      }
+    }
+  }
+
+  size_t start = templateKeyStarts[index];
+  size_t end = index + 1 < templateKeyStarts.length()
+                   ? templateKeyStarts[index + 1]
+                   : templateKeys.length();
+
+  RootedValueVector values(context());
+  if (!readPrimitiveFields(end - start, &values)) {
+    return false;
+  }
+
+  Rooted<IdValueVector> properties(context(), IdValueVector(context()));
+  if (!properties.reserve(end - start)) {
+    return false;
+  }
+  for (size_t i = start; i < end; i++) {
+    properties.infallibleAppend(
+        IdValuePair(templateKeys[i], values[i - start]));
+  }
+
+  PlainObject* obj = NewPlainObjectWithMaybeDuplicateKeys(
+      context(), properties.begin(), properties.length(),
+      templateShapes.get()[index]);
+  if (!obj) {
+    return false;
+  }
+
+  // Objects from the same template usually end up with the same shape. Keys
+  // that don't fit a shared shape (duplicates or indexes) can't be reused.
+  if (!obj->inDictionaryMode() && obj->getDenseInitializedLength() == 0 &&
+      obj->slotSpan() == properties.length()) {
+    templateShapes.get()[index] = obj->shape();
+  }
+
+  vp.setObject(*obj);
+  return true;
+}
+
+bool JSStructuredCloneReader::readPackedArray(uint32_t length,
+                                              MutableHandleValue vp) {
+  RootedValueVector values(context());
+  if (!readPrimitiveFields(length, &values)) {
+    return false;
+  }
+
+  ArrayObject* arr = NewDenseCopiedArray(context(), length, values.begin());
+  if (!arr) {
+    return false;
+  }
+
+  vp.setObject(*arr);
+  return true;
+}
+
 // Perform the whole recursive reading procedure.
 bool JSStructuredCloneReader::read(MutableHandleValue vp, size_t nbytes) {
   auto startTime = mozilla::TimeStamp::Now();
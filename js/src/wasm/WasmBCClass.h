@@ -564,10 +564,15 @@ struct BaseCompiler final {
   // sync.
   inline bool hasLocal(uint32_t slot);
 
-  // Sync the local if necessary. (This currently syncs everything if a sync is
-  // needed at all.)
+  // Sync the local if necessary, by loading the unresolved reads of the local
+  // into registers. This syncs everything if registers run out.
   inline void syncLocal(uint32_t slot);
 
+  // Load an unresolved local read on the value stack into a register, and
+  // return true. Return false, leaving the value stack unchanged, if no
+  // register is available without a sync.
+  inline bool resolveLocal(Stk& v);
+
   // Return the amount of execution stack consumed by the top numval
   // values on the value stack.
   inline size_t stackConsumed(size_t numval);
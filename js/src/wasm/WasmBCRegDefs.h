@@ -650,6 +650,17 @@ class BaseRegAlloc {
   bool isAvailableV128(RegV128 r) { return isAvailableFPU(r); }
 #endif
 
+  // Whether the corresponding need*() would allocate a register without having
+  // to sync() the value stack.
+  bool hasI32() { return hasGPR(); }
+  bool hasI64() { return hasGPR64(); }
+  bool hasRef() { return hasGPR(); }
+  bool hasF32() { return hasFPU<MIRType::Float32>(); }
+  bool hasF64() { return hasFPU<MIRType::Double>(); }
+#ifdef ENABLE_WASM_SIMD
+  bool hasV128() { return hasFPU<MIRType::Simd128>(); }
+#endif
+
   [[nodiscard]] inline RegI32 needI32();
   inline void needI32(RegI32 specific);
 
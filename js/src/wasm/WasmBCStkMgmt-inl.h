@@ -477,8 +477,87 @@ bool BaseCompiler::hasLocal(uint32_t slot) {
 }
 
 void BaseCompiler::syncLocal(uint32_t slot) {
-  if (hasLocal(slot)) {
-    sync();  // TODO / OPTIMIZE: Improve this?  (Bug 1316817)
+  if (!hasLocal(slot)) {
+    return;
+  }
+
+  // Rather than spilling the whole value stack, only load the reads of this
+  // local into registers. If registers run out, sync() everything, including
+  // the reads which were already resolved.
+  for (size_t i = stk_.length(); i > 0; i--) {
+    Stk& v = stk_[i - 1];
+    Stk::Kind kind = v.kind();
+    if (kind <= Stk::MemLast) {
+      return;
+    }
+
+    if (kind <= Stk::LocalLast && v.slot() == slot && !resolveLocal(v)) {
+      sync();
+      return;
+    }
+  }
+}
+
+bool BaseCompiler::resolveLocal(Stk& v) {
+  switch (v.kind()) {
+    case Stk::LocalI32: {
+      if (!ra.hasI32()) {
+        return false;
+      }
+      RegI32 r = needI32();
+      loadLocalI32(v, r);
+      v = Stk(r);
+      return true;
+    }
+    case Stk::LocalI64: {
+      if (!ra.hasI64()) {
+        return false;
+      }
+      RegI64 r = needI64();
+      loadLocalI64(v, r);
+      v = Stk(r);
+      return true;
+    }
+    case Stk::LocalF32: {
+      if (!ra.hasF32()) {
+        return false;
+      }
+      RegF32 r = needF32();
+      loadLocalF32(v, r);
+      v = Stk(r);
+      return true;
+    }
+    case Stk::LocalF64: {
+      if (!ra.hasF64()) {
+        return false;
+      }
+      RegF64 r = needF64();
+      loadLocalF64(v, r);
+      v = Stk(r);
+      return true;
+    }
+#ifdef ENABLE_WASM_SIMD
+    case Stk::LocalV128: {
+      if (!ra.hasV128()) {
+        return false;
+      }
+      RegV128 r = needV128();
+      loadLocalV128(v, r);
+      v = Stk(r);
+      return true;
+    }
+#endif
+    case Stk::LocalRef: {
+      if (!ra.hasRef()) {
+        return false;
+      }
+      RegRef r = needRef();
+      loadLocalRef(v, r);
+      v = Stk(r);
+      return true;
+    }
+    default:
+      MOZ_CRASH("Not a local read");
   }
 }
 
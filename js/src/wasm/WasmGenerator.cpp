@@ -100,6 +100,7 @@ ModuleGenerator::ModuleGenerator(const CompileArgs& args,
       outstanding_(0),
       currentTask_(nullptr),
       batchedBytecode_(0),
+      batchThreshold_(0),
       finishedFuncDefs_(false) {
   MOZ_ASSERT(IsCompilingWasm());
 }
@@ -414,6 +415,8 @@ bool ModuleGenerator::init(Metadata* maybeAsmJSMetadata) {
     freeTasks_.infallibleAppend(&tasks_[i]);
   }
 
+  batchThreshold_ = computeBatchThreshold(codeSectionSize);
+
   // Fill in function stubs for each import so that imported functions can be
   // used in all the places that normal function definitions can (table
   // elements, export calls, etc).
@@ -822,6 +825,50 @@ bool ModuleGenerator::finishTask(CompileTask* task) {
   return true;
 }
 
+// When compiling in parallel, aim for at least this many batches per
+// compilation thread, such that threads are kept busy until the end of the code
+// section and the last batches do not leave most threads idle.
+static const size_t MinBatchesPerThread = 64;
+
+// Upper bound on the scaling of the batch thresholds for large modules.
+static const uint32_t MaxBatchThresholdScale = 8;
+
+uint32_t ModuleGenerator::computeBatchThreshold(size_t codeSectionSize) const {
+  uint32_t threshold;
+  switch (tier()) {
+    case Tier::Baseline:
+      threshold = JitOptions.wasmBatchBaselineThreshold;
+      break;
+    case Tier::Optimized:
+      switch (compilerEnv_->optimizedBackend()) {
+        case OptimizedBackend::Ion:
+          threshold = JitOptions.wasmBatchIonThreshold;
+          break;
+        case OptimizedBackend::Cranelift:
+          threshold = JitOptions.wasmBatchCraneliftThreshold;
+          break;
+        default:
+          MOZ_CRASH("Invalid optimizedBackend value");
+      }
+      break;
+    default:
+      MOZ_CRASH("Invalid tier value");
+      break;
+  }
+
+  if (!parallel_) {
+    return threshold;
+  }
+
+  // Large modules are split in fewer, larger batches, which reduces the cost
+  // of dispatching, waiting for and recycling tasks, as long as enough batches
+  // remain to balance the work across all compilation threads.
+  size_t balanced =
+      codeSectionSize / (GetMaxWasmCompilationThreads() * MinBatchesPerThread);
+  size_t maxThreshold = size_t(threshold) * MaxBatchThresholdScale;
+  return uint32_t(std::clamp(balanced, size_t(threshold), maxThreshold));
+}
+
 bool ModuleGenerator::launchBatchCompile() {
   MOZ_ASSERT(currentTask_);
 
@@ -876,28 +923,7 @@ bool ModuleGenerator::compileFuncDef(uint32_t funcIndex,
   MOZ_ASSERT(!finishedFuncDefs_);
   MOZ_ASSERT(funcIndex < moduleEnv_->numFuncs());
 
-  uint32_t threshold;
-  switch (tier()) {
-    case Tier::Baseline:
-      threshold = JitOptions.wasmBatchBaselineThreshold;
-      break;
-    case Tier::Optimized:
-      switch (compilerEnv_->optimizedBackend()) {
-        case OptimizedBackend::Ion:
-          threshold = JitOptions.wasmBatchIonThreshold;
-          break;
-        case OptimizedBackend::Cranelift:
-          threshold = JitOptions.wasmBatchCraneliftThreshold;
-          break;
-        default:
-          MOZ_CRASH("Invalid optimizedBackend value");
-      }
-      break;
-    default:
-      MOZ_CRASH("Invalid tier value");
-      break;
-  }
-
+  uint32_t threshold = batchThreshold_;
   uint32_t funcBytecodeLength = end - begin;
 
   // Do not go over the threshold if we can avoid it: spin off the compilation
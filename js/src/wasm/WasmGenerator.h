@@ -212,6 +212,7 @@ class MOZ_STACK_CLASS ModuleGenerator {
   CompileTaskPtrVector freeTasks_;
   CompileTask* currentTask_;
   uint32_t batchedBytecode_;
+  uint32_t batchThreshold_;
 
   // Assertions
   DebugOnly<bool> finishedFuncDefs_;
@@ -226,6 +227,7 @@ class MOZ_STACK_CLASS ModuleGenerator {
   bool linkCompiledCode(CompiledCode& code);
   bool locallyCompileCurrentTask();
   bool finishTask(CompileTask* task);
+  uint32_t computeBatchThreshold(size_t codeSectionSize) const;
   bool launchBatchCompile();
   bool finishOutstandingTask();
   bool finishCodegen();
@@ -7,8 +7,15 @@
 #include "ComponentModuleLoader.h"
 
 #include "nsISupportsImpl.h"
+#include "nsJSUtils.h"
+#include "nsNetUtil.h"
 
+#include "js/Array.h"  // JS::GetArrayLength
 #include "js/loader/ModuleLoadRequest.h"
+#include "js/Modules.h"  // JS::GetModuleObject, JS::GetRequestedModules, JS::GetRequestedModuleSpecifier
+#include "js/OffThreadScriptCompilation.h"
+#include "js/PropertyAndElement.h"  // JS_GetElement
+#include "js/SourceText.h"          // JS::SourceText
 #include "mozJSModuleLoader.h"
 
 using namespace JS::loader;
@@ -43,6 +50,60 @@ nsresult ComponentScriptLoader::FillCompileOptionsForRequest(
   return NS_OK;
 }
 
+//////////////////////////////////////////////////////////////
+// OffThreadModuleCompile
+//////////////////////////////////////////////////////////////
+
+OffThreadModuleCompile::~OffThreadModuleCompile() {
+  if (mToken) {
+    JS::CancelCompileModuleToStencilOffThread(mCx, mToken);
+  }
+}
+
+bool OffThreadModuleCompile::Start(JSContext* aCx,
+                                   const JS::ReadOnlyCompileOptions& aOptions) {
+  MOZ_ASSERT(!mToken);
+
+  JS::SourceText<Utf8Unit> srcBuf;
+  if (srcBuf.init(aCx, mSource.get(), mSource.Length(),
+                  JS::SourceOwnership::Borrowed)) {
+    mToken = JS::CompileModuleToStencilOffThread(aCx, aOptions, srcBuf,
+                                                 OffThreadCallback, this);
+  }
+  if (!mToken) {
+    // The synchronous load will compile the module and report any errors.
+    JS_ClearPendingException(aCx);
+    return false;
+  }
+
+  mCx = aCx;
+  return true;
+}
+
+already_AddRefed<JS::Stencil> OffThreadModuleCompile::Finish(JSContext* aCx) {
+  MOZ_ASSERT(mToken);
+
+  {
+    MonitorAutoLock lock(mMonitor);
+    while (!mDone) {
+      lock.Wait();
+    }
+  }
+
+  return JS::FinishCompileModuleToStencilOffThread(
+      aCx, std::exchange(mToken, nullptr));
+}
+
+/* static */
+void OffThreadModuleCompile::OffThreadCallback(JS::OffThreadToken* aToken,
+                                               void* aData) {
+  auto* self = static_cast<OffThreadModuleCompile*>(aData);
+
+  MonitorAutoLock lock(self->mMonitor);
+  self->mDone = true;
+  lock.Notify();
+}
+
 //////////////////////////////////////////////////////////////
 // ComponentModuleLoader
 //////////////////////////////////////////////////////////////
@@ -102,9 +163,16 @@ nsresult ComponentModuleLoader::StartFetch(ModuleLoadRequest* aRequest) {
   }
 
   JSContext* cx = jsapi.cx();
+
+  UniquePtr<OffThreadModuleCompile> offThreadCompile;
+  nsAutoCString spec;
+  if (NS_SUCCEEDED(aRequest->mURI->GetSpec(spec))) {
+    mOffThreadCompiles.Remove(spec, &offThreadCompile);
+  }
+
   RootedScript script(cx);
-  nsresult rv =
-      mozJSModuleLoader::LoadSingleModuleScript(cx, aRequest->mURI, &script);
+  nsresult rv = mozJSModuleLoader::LoadSingleModuleScript(
+      cx, aRequest->mURI, &script, offThreadCompile.get());
   MOZ_ASSERT_IF(jsapi.HasException(), NS_FAILED(rv));
   MOZ_ASSERT(bool(script) == NS_SUCCEEDED(rv));
 
@@ -140,6 +208,8 @@ nsresult ComponentModuleLoader::StartFetch(ModuleLoadRequest* aRequest) {
   if (script) {
     context->mScript.init(cx);
     context->mScript = script;
+
+    StartOffThreadCompilesForImports(cx, aRequest, script);
   }
 
   mLoadRequests.AppendElement(aRequest);
@@ -147,6 +217,78 @@ nsresult ComponentModuleLoader::StartFetch(ModuleLoadRequest* aRequest) {
   return NS_OK;
 }
 
+// Resolve an import specifier the same way ModuleLoaderBase does when import
+// maps are disabled. This is only used to find modules worth compiling ahead
+// of time, so a mismatch just wastes an off-thread compile.
+static already_AddRefed<nsIURI> ResolveImportSpecifier(
+    const nsAString& aSpecifier, nsIURI* aBaseURL) {
+  nsCOMPtr<nsIURI> uri;
+  nsresult rv = NS_NewURI(getter_AddRefs(uri), aSpecifier);
+  if (NS_SUCCEEDED(rv)) {
+    return uri.forget();
+  }
+
+  if (rv != NS_ERROR_MALFORMED_URI ||
+      (!StringBeginsWith(aSpecifier, u"/"_ns) &&
+       !StringBeginsWith(aSpecifier, u"./"_ns) &&
+       !StringBeginsWith(aSpecifier, u"../"_ns))) {
+    return nullptr;
+  }
+
+  if (NS_FAILED(NS_NewURI(getter_AddRefs(uri), aSpecifier, nullptr,
+                          aBaseURL))) {
+    return nullptr;
+  }
+  return uri.forget();
+}
+
+void ComponentModuleLoader::StartOffThreadCompilesForImports(
+    JSContext* aCx, ModuleLoadRequest* aRequest,
+    JS::Handle<JSScript*> aScript) {
+  JS::Rooted<JSObject*> module(aCx, JS::GetModuleObject(aScript));
+  JS::Rooted<JSObject*> requestedModules(
+      aCx, JS::GetRequestedModules(aCx, module));
+  MOZ_ASSERT(requestedModules);
+
+  uint32_t length;
+  if (!JS::GetArrayLength(aCx, requestedModules, &length)) {
+    JS_ClearPendingException(aCx);
+    return;
+  }
+
+  JS::Rooted<JS::Value> requestedModule(aCx);
+  for (uint32_t i = 0; i < length; i++) {
+    if (!JS_GetElement(aCx, requestedModules, i, &requestedModule)) {
+      JS_ClearPendingException(aCx);
+      return;
+    }
+
+    JS::Rooted<JSString*> str(
+        aCx, JS::GetRequestedModuleSpecifier(aCx, requestedModule));
+    nsAutoJSString specifier;
+    if (!str || !specifier.init(aCx, str)) {
+      JS_ClearPendingException(aCx);
+      return;
+    }
+
+    nsCOMPtr<nsIURI> uri = ResolveImportSpecifier(specifier, aRequest->mURI);
+    if (!uri || !mozJSModuleLoader::IsTrustedScheme(uri) ||
+        IsModuleFetched(uri)) {
+      continue;
+    }
+
+    nsAutoCString spec;
+    if (NS_FAILED(uri->GetSpec(spec)) || mOffThreadCompiles.Contains(spec)) {
+      continue;
+    }
+
+    if (UniquePtr<OffThreadModuleCompile> compile =
+            mozJSModuleLoader::StartOffThreadModuleCompile(aCx, uri)) {
+      mOffThreadCompiles.InsertOrUpdate(spec, std::move(compile));
+    }
+  }
+}
+
 nsresult ComponentModuleLoader::CompileFetchedModule(
     JSContext* aCx, JS::Handle<JSObject*> aGlobal, JS::CompileOptions& aOptions,
     ModuleLoadRequest* aRequest, JS::MutableHandle<JSObject*> aModuleOut) {
@@ -191,10 +333,14 @@ nsresult ComponentModuleLoader::ProcessRequests() {
     nsresult rv = OnFetchComplete(request->AsModuleRequest(), NS_OK);
     if (NS_FAILED(rv)) {
       mLoadRequests.CancelRequestsAndClear();
+      mOffThreadCompiles.Clear();
       return rv;
     }
   }
 
+  // Cancel compiles for any imports that were never fetched.
+  mOffThreadCompiles.Clear();
+
   return NS_OK;
 }
 
@@ -7,8 +7,12 @@
 #ifndef mozilla_loader_ComponentModuleLoader_h
 #define mozilla_loader_ComponentModuleLoader_h
 
+#include "js/experimental/JSStencil.h"
 #include "js/loader/LoadContextBase.h"
 #include "js/loader/ModuleLoaderBase.h"
+#include "mozilla/Monitor.h"
+#include "mozilla/UniquePtr.h"
+#include "nsClassHashtable.h"
 
 class mozJSModuleLoader;
 
@@ -37,6 +41,35 @@ class ComponentScriptLoader : public JS::loader::ScriptLoaderInterface {
       JS::MutableHandle<JSScript*> aIntroductionScript) override;
 };
 
+// A module script that missed the script caches and is being compiled on a
+// helper thread, so that the stencil is ready by the time the synchronous load
+// reaches it. Created by mozJSModuleLoader::StartOffThreadModuleCompile.
+class OffThreadModuleCompile final {
+ public:
+  explicit OffThreadModuleCompile(nsCString&& aSource)
+      : mSource(std::move(aSource)),
+        mMonitor("OffThreadModuleCompile::mMonitor") {}
+  ~OffThreadModuleCompile();
+
+  bool Start(JSContext* aCx, const JS::ReadOnlyCompileOptions& aOptions);
+
+  // Wait for the compilation to complete and return the stencil. Returns null
+  // with an exception pending on aCx if compilation failed.
+  already_AddRefed<JS::Stencil> Finish(JSContext* aCx);
+
+ private:
+  static void OffThreadCallback(JS::OffThreadToken* aToken, void* aData);
+
+  // The source must outlive the off-thread task.
+  nsCString mSource;
+
+  JSContext* mCx = nullptr;
+  JS::OffThreadToken* mToken = nullptr;
+
+  Monitor mMonitor;
+  bool mDone GUARDED_BY(mMonitor) = false;
+};
+
 class ComponentModuleLoader : public JS::loader::ModuleLoaderBase {
  public:
   NS_DECL_ISUPPORTS_INHERITED
@@ -84,8 +117,19 @@ class ComponentModuleLoader : public JS::loader::ModuleLoaderBase {
 
   void OnModuleLoadComplete(ModuleLoadRequest* aRequest) override;
 
+  // Start off-thread compiles for the not yet fetched imports of a module, so
+  // they overlap with the synchronous loading of its other dependencies.
+  void StartOffThreadCompilesForImports(JSContext* aCx,
+                                        ModuleLoadRequest* aRequest,
+                                        JS::Handle<JSScript*> aScript);
+
   JS::loader::ScriptLoadRequestList mLoadRequests;
 
+  // Compiles started by StartOffThreadCompilesForImports, keyed by URI spec.
+  // Any left over when the work list is drained are cancelled.
+  nsClassHashtable<nsCStringHashKey, OffThreadModuleCompile>
+      mOffThreadCompiles;
+
   // If any of module scripts failed to load, exception is set here until it's
   // reported by MaybeReportLoadError.
   JS::PersistentRooted<JS::Value> mLoadException;
@@ -940,6 +940,11 @@ already_AddRefed<JS::Stencil> ScriptPreloader::GetCachedStencil(
   return stencil.forget();
 }
 
+bool ScriptPreloader::HasCachedStencil(const nsCString& path) {
+  return (mChildCache && mChildCache->mScripts.Get(path)) ||
+         mScripts.Get(path);
+}
+
 already_AddRefed<JS::Stencil> ScriptPreloader::GetCachedStencilInternal(
     JSContext* cx, const JS::DecodeOptions& options, const nsCString& path) {
   auto* cachedScript = mScripts.Get(path);
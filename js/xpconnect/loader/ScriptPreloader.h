@@ -112,6 +112,10 @@ class ScriptPreloader : public nsIObserver,
   already_AddRefed<JS::Stencil> GetCachedStencil(
       JSContext* cx, const JS::DecodeOptions& options, const nsCString& path);
 
+  // Returns true if a stencil with the given cache key is in the cache,
+  // without decoding it.
+  bool HasCachedStencil(const nsCString& path);
+
   // Notes the execution of a script with the given URL and cache key.
   // Depending on the stage of startup, the script may be serialized and
   // stored to the startup script cache.
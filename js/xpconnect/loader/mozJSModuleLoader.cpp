@@ -26,6 +26,7 @@
 #include "js/friend/JSMEnvironment.h"  // JS::ExecuteInJSMEnvironment, JS::GetJSMEnvironmentOfScriptedCaller, JS::NewJSMEnvironment
 #include "js/loader/ModuleLoadRequest.h"
 #include "js/Object.h"  // JS::GetCompartment
+#include "js/OffThreadScriptCompilation.h"  // JS::CanCompileOffThread
 #include "js/Printf.h"
 #include "js/PropertyAndElement.h"  // JS_DefineFunctions, JS_DefineProperty, JS_Enumerate, JS_GetElement, JS_GetProperty, JS_GetPropertyById, JS_HasOwnProperty, JS_HasOwnPropertyById, JS_SetProperty, JS_SetPropertyById
 #include "js/PropertySpec.h"
@@ -631,7 +632,8 @@ JSObject* mozJSModuleLoader::GetSharedGlobal(JSContext* aCx) {
 
 /* static */
 nsresult mozJSModuleLoader::LoadSingleModuleScript(
-    JSContext* aCx, nsIURI* aURI, MutableHandleScript aScriptOut) {
+    JSContext* aCx, nsIURI* aURI, MutableHandleScript aScriptOut,
+    OffThreadModuleCompile* aOffThreadCompile) {
   ModuleLoaderInfo info(aURI, true);
   nsresult rv = info.EnsureResolvedURI();
   NS_ENSURE_SUCCESS(rv, rv);
@@ -643,7 +645,8 @@ nsresult mozJSModuleLoader::LoadSingleModuleScript(
   bool realFile = LocationIsRealFile(aURI);
 
   RootedScript script(aCx);
-  return GetScriptForLocation(aCx, info, sourceFile, realFile, aScriptOut);
+  return GetScriptForLocation(aCx, info, sourceFile, realFile, aScriptOut,
+                              nullptr, aOffThreadCompile);
 }
 
 /* static */
@@ -760,6 +763,83 @@ static mozilla::Result<nsCString, nsresult> ReadScript(
   return std::move(str);
 }
 
+static void FillCompileOptionsForLocation(CompileOptions& aOptions,
+                                          const nsCString& aNativePath,
+                                          bool aIsModule,
+                                          bool aStoreIntoStartupCache) {
+  ScriptPreloader::FillCompileOptionsForCachedStencil(aOptions);
+  aOptions.setFileAndLine(aNativePath.get(), 1);
+  if (aIsModule) {
+    aOptions.setModule();
+    // Top level await is not supported in synchronously loaded modules.
+    aOptions.topLevelAwait = false;
+
+    // Make all top-level `vars` available in `ModuleEnvironmentObject`.
+    aOptions.deoptimizeModuleGlobalVars = true;
+  } else {
+    aOptions.setForceStrictMode();
+    aOptions.setNonSyntacticScope(true);
+  }
+
+  // If we can no longer write to caches, we should stop using lazy sources
+  // and instead let normal syntax parsing occur. This can occur in content
+  // processes after the ScriptPreloader is flushed where we can read but no
+  // longer write.
+  if (!aStoreIntoStartupCache && !ScriptPreloader::GetSingleton().Active()) {
+    aOptions.setSourceIsLazy(false);
+  }
+}
+
+/* static */
+UniquePtr<OffThreadModuleCompile>
+mozJSModuleLoader::StartOffThreadModuleCompile(JSContext* aCx, nsIURI* aURI) {
+  ModuleLoaderInfo info(aURI, true);
+  if (NS_FAILED(info.EnsureResolvedURI())) {
+    return nullptr;
+  }
+
+  nsAutoCString cachePath;
+  if (NS_FAILED(PathifyURI(JS_CACHE_PREFIX("non-syntactic", "module"),
+                           info.ResolvedURI(), cachePath))) {
+    return nullptr;
+  }
+
+  // Cached stencils are only decoded, which is cheap enough to leave to the
+  // synchronous load.
+  StartupCache* cache = StartupCache::GetSingleton();
+  if (ScriptPreloader::GetSingleton().HasCachedStencil(cachePath) ||
+      (cache && cache->HasEntry(cachePath.get()))) {
+    return nullptr;
+  }
+
+  nsAutoCString nativePath;
+  if (NS_FAILED(aURI->GetSpec(nativePath))) {
+    return nullptr;
+  }
+
+  // Errors reading the source are left for the synchronous load to report.
+  auto source = ReadScript(info);
+  if (source.isErr()) {
+    return nullptr;
+  }
+
+  CompileOptions options(aCx);
+  FillCompileOptionsForLocation(options, nativePath, /* aIsModule = */ true,
+                                /* aStoreIntoStartupCache = */ !!cache);
+
+  if (!JS::CanCompileOffThread(aCx, options, source.inspect().Length())) {
+    return nullptr;
+  }
+
+  auto compile = MakeUnique<OffThreadModuleCompile>(source.unwrap());
+  if (!compile->Start(aCx, options)) {
+    return nullptr;
+  }
+
+  LOG(("Compiling %s off main thread\n", nativePath.get()));
+  return compile;
+}
+
 nsresult mozJSModuleLoader::ObjectForLocation(
     ModuleLoaderInfo& aInfo, nsIFile* aModuleFile, MutableHandleObject aObject,
     MutableHandleScript aTableScript, char** aLocation,
@@ -838,7 +918,8 @@ nsresult mozJSModuleLoader::ObjectForLocation(
 /* static */
 nsresult mozJSModuleLoader::GetScriptForLocation(
     JSContext* aCx, ModuleLoaderInfo& aInfo, nsIFile* aModuleFile,
-    bool aUseMemMap, MutableHandleScript aScriptOut, char** aLocationOut) {
+    bool aUseMemMap, MutableHandleScript aScriptOut, char** aLocationOut,
+    OffThreadModuleCompile* aOffThreadCompile) {
   // JS compilation errors are returned via an exception on the context.
   MOZ_ASSERT(!JS_IsExceptionPending(aCx));
 
@@ -868,51 +949,46 @@ nsresult mozJSModuleLoader::GetScriptForLocation(
   }
   NS_ENSURE_SUCCESS(rv, rv);
 
-  JS::DecodeOptions decodeOptions;
-  ScriptPreloader::FillDecodeOptionsForCachedStencil(decodeOptions);
-
-  RefPtr<JS::Stencil> stencil =
-      ScriptPreloader::GetSingleton().GetCachedStencil(aCx, decodeOptions,
-                                                       cachePath);
+  RefPtr<JS::Stencil> stencil;
+  if (aOffThreadCompile) {
+    // Both caches were checked and missed when the compile was started, see
+    // StartOffThreadModuleCompile.
+    MOZ_ASSERT(aInfo.IsModule());
+    storeIntoStartupCache = !!cache;
 
-  if (!stencil && cache) {
-    ReadCachedStencil(cache, cachePath, aCx, decodeOptions,
-                      getter_AddRefs(stencil));
+    stencil = aOffThreadCompile->Finish(aCx);
     if (!stencil) {
-      JS_ClearPendingException(aCx);
+      return NS_ERROR_FAILURE;
+    }
+  } else {
+    JS::DecodeOptions decodeOptions;
+    ScriptPreloader::FillDecodeOptionsForCachedStencil(decodeOptions);
+
+    stencil = ScriptPreloader::GetSingleton().GetCachedStencil(
+        aCx, decodeOptions, cachePath);
 
-      storeIntoStartupCache = true;
+    if (!stencil && cache) {
+      ReadCachedStencil(cache, cachePath, aCx, decodeOptions,
+                        getter_AddRefs(stencil));
+      if (!stencil) {
+        JS_ClearPendingException(aCx);
+
+        storeIntoStartupCache = true;
+      }
+    }
+
+    if (stencil) {
+      LOG(("Successfully loaded %s from cache\n", nativePath.get()));
     }
   }
 
-  if (stencil) {
-    LOG(("Successfully loaded %s from cache\n", nativePath.get()));
-  } else {
+  if (!stencil) {
     // The script wasn't in the cache , so compile it now.
     LOG(("Slow loading %s\n", nativePath.get()));
 
     CompileOptions options(aCx);
-    ScriptPreloader::FillCompileOptionsForCachedStencil(options);
-    options.setFileAndLine(nativePath.get(), 1);
-    if (aInfo.IsModule()) {
-      options.setModule();
-      // Top level await is not supported in synchronously loaded modules.
-      options.topLevelAwait = false;
-
-      // Make all top-level `vars` available in `ModuleEnvironmentObject`.
-      options.deoptimizeModuleGlobalVars = true;
-    } else {
-      options.setForceStrictMode();
-      options.setNonSyntacticScope(true);
-    }
-
-    // If we can no longer write to caches, we should stop using lazy sources
-    // and instead let normal syntax parsing occur. This can occur in content
-    // processes after the ScriptPreloader is flushed where we can read but no
-    // longer write.
-    if (!storeIntoStartupCache && !ScriptPreloader::GetSingleton().Active()) {
-      options.setSourceIsLazy(false);
-    }
+    FillCompileOptionsForLocation(options, nativePath, aInfo.IsModule(),
+                                  storeIntoStartupCache);
 
     if (aUseMemMap) {
       AutoMemMap map;
@@ -12,6 +12,7 @@
 #include "mozilla/FileLocation.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/StaticPtr.h"
+#include "mozilla/UniquePtr.h"
 #include "nsIMemoryReporter.h"
 #include "nsISupports.h"
 #include "nsIURI.h"
@@ -103,8 +104,15 @@ class mozJSModuleLoader final : public nsIMemoryReporter {
 
   // Public methods for use from ComponentModuleLoader.
   static bool IsTrustedScheme(nsIURI* aURI);
-  static nsresult LoadSingleModuleScript(JSContext* aCx, nsIURI* aURI,
-                                         JS::MutableHandleScript aScriptOut);
+  static nsresult LoadSingleModuleScript(
+      JSContext* aCx, nsIURI* aURI, JS::MutableHandleScript aScriptOut,
+      mozilla::loader::OffThreadModuleCompile* aOffThreadCompile = nullptr);
+
+  // Start compiling the module at aURI on a helper thread, if it isn't in
+  // either script cache and is large enough to be worth it. Returns null
+  // otherwise, in which case the module is loaded synchronously as usual.
+  static mozilla::UniquePtr<mozilla::loader::OffThreadModuleCompile>
+  StartOffThreadModuleCompile(JSContext* aCx, nsIURI* aURI);
 
   size_t SizeOfIncludingThis(mozilla::MallocSizeOf aMallocSizeOf);
 
@@ -146,7 +154,9 @@ class mozJSModuleLoader final : public nsIMemoryReporter {
   static nsresult GetScriptForLocation(JSContext* aCx, ModuleLoaderInfo& aInfo,
                                        nsIFile* aModuleFile, bool aUseMemMap,
                                        JS::MutableHandleScript aScriptOut,
-                                       char** aLocationOut = nullptr);
+                                       char** aLocationOut = nullptr,
+                                       mozilla::loader::OffThreadModuleCompile*
+                                           aOffThreadCompile = nullptr);
 
   static already_AddRefed<JS::Stencil> CompileStencil(
       JSContext* aCx, const JS::CompileOptions& aOptions,
@@ -777,6 +777,7 @@ static mozilla::Atomic<bool> sWeakRefsEnabled(false);
 static mozilla::Atomic<bool> sWeakRefsExposeCleanupSome(false);
 static mozilla::Atomic<bool> sIteratorHelpersEnabled(false);
 static mozilla::Atomic<bool> sShadowRealmsEnabled(false);
+static mozilla::Atomic<bool> sArrayBufferTransferEnabled(false);
 #ifdef NIGHTLY_BUILD
 static mozilla::Atomic<bool> sArrayGroupingEnabled(true);
 #endif
@@ -803,6 +804,7 @@ void xpc::SetPrefableRealmOptions(JS::RealmOptions& options) {
       .setWeakRefsEnabled(GetWeakRefsEnabled())
       .setIteratorHelpersEnabled(sIteratorHelpersEnabled)
       .setShadowRealmsEnabled(sShadowRealmsEnabled)
+      .setArrayBufferTransferEnabled(sArrayBufferTransferEnabled)
 #ifdef NIGHTLY_BUILD
       .setArrayGroupingEnabled(sArrayGroupingEnabled)
 #endif
@@ -1005,6 +1007,8 @@ static void ReloadPrefsCallback(const char* pref, void* aXpccx) {
       JS_OPTIONS_DOT_STR "experimental.weakrefs.expose_cleanupSome");
   sShadowRealmsEnabled =
       Preferences::GetBool(JS_OPTIONS_DOT_STR "experimental.shadow_realms");
+  sArrayBufferTransferEnabled = Preferences::GetBool(
+      JS_OPTIONS_DOT_STR "experimental.arraybuffer_transfer");
 #ifdef NIGHTLY_BUILD
   sIteratorHelpersEnabled =
       Preferences::GetBool(JS_OPTIONS_DOT_STR "experimental.iterator_helpers");
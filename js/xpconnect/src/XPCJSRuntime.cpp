@@ -1942,6 +1942,10 @@ void ReportJSRuntimeExplicitTreeStats(const JS::RuntimeStats& rtStats,
                 rtStats.runtime.sharedIntlData,
                 "Shared internationalization data.");
 
+  RREPORT_BYTES(rtPath + "runtime/regexp-bytecode-cache"_ns, KIND_HEAP,
+                rtStats.runtime.regExpBytecodeCache,
+                "Regexp bytecode shared across all JSRuntimes.");
+
   RREPORT_BYTES(rtPath + "runtime/uncompressed-source-cache"_ns, KIND_HEAP,
                 rtStats.runtime.uncompressedSourceCache,
                 "The uncompressed source code cache.");
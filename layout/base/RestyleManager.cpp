@@ -3356,6 +3356,20 @@ void RestyleManager::TakeSnapshotForAttributeChange(Element& aElement,
     return;
   }
 
+  // Scripts often change the same attribute of an element many times between
+  // two style flushes (e.g. toggling classes). The snapshot taken for the first
+  // change already holds the old attribute values, so the later ones only need
+  // the bookkeeping below.
+  if (aElement.HasFlag(ELEMENT_HAS_SNAPSHOT) &&
+      !aElement.HasFlag(ELEMENT_HANDLED_SNAPSHOT)) {
+    ServoElementSnapshot* snapshot = mSnapshots.Get(&aElement);
+    if (snapshot && snapshot->HasRecordedAttrChange(aAttribute)) {
+      IncrementUndisplayedRestyleGeneration();
+      mHaveNonAnimationRestyles = true;
+      return;
+    }
+  }
+
   bool influencesOtherPseudoClassState;
   if (!NeedToRecordAttrChange(*StyleSet(), aElement, aNameSpaceID, aAttribute,
                               &influencesOtherPseudoClassState)) {
@@ -3503,6 +3503,18 @@ void nsLayoutUtils::PaintFrame(gfxContext* aRenderingContext, nsIFrame* aFrame,
     }
   }
 
+  // Full rebuilds of a retained display list are expensive, record why the
+  // partial update was given up on so that they can be diagnosed in profiles.
+  // Builders that don't retain their display list always report Disabled,
+  // which isn't worth a marker on every paint.
+  if (metrics->mPartialUpdateResult == PartialUpdateResult::Failed &&
+      metrics->mPartialUpdateFailReason != PartialUpdateFailReason::Disabled) {
+    PROFILER_MARKER_TEXT(
+        "DisplayListPartialUpdateFailed", GRAPHICS, {},
+        ProfilerString8View::WrapNullTerminatedString(
+            metrics->FailReasonString()));
+  }
+
 #if 0
   if (XRE_IsParentProcess()) {
     if (metrics->mPartialUpdateResult == PartialUpdateResult::Failed) {
@@ -550,7 +550,7 @@ class nsGridContainerFrame final : public nsContainerFrame {
   //   - The item's border-box BSize
   class CachedBAxisMeasurement {
    public:
-    NS_DECLARE_FRAME_PROPERTY_SMALL_VALUE(Prop, CachedBAxisMeasurement)
+    NS_DECLARE_FRAME_PROPERTY_DELETABLE(Prop, CachedBAxisMeasurement)
     CachedBAxisMeasurement(const nsIFrame* aFrame, const LogicalSize& aCBSize,
                            const nscoord aBSize)
         : mKey(aFrame, aCBSize), mBSize(aBSize) {}
@@ -562,75 +562,35 @@ class nsGridContainerFrame final : public nsContainerFrame {
         return false;
       }
 
-      if (!CanCacheMeasurement(aFrame, aCBSize)) {
-        return false;
-      }
-
       return mKey == Key(aFrame, aCBSize);
     }
 
-    static bool CanCacheMeasurement(const nsIFrame* aFrame,
-                                    const LogicalSize& aCBSize) {
-      return Key::CanHash(aFrame, aCBSize);
-    }
-
     nscoord BSize() const { return mBSize; }
 
     void Update(const nsIFrame* aFrame, const LogicalSize& aCBSize,
                 const nscoord aBSize) {
-      MOZ_ASSERT(CanCacheMeasurement(aFrame, aCBSize));
-      mKey.mHashKey = Key::GenerateHash(aFrame, aCBSize);
+      mKey = Key(aFrame, aCBSize);
       mBSize = aBSize;
     }
 
    private:
     struct Key {
-      // mHashKey is generated by combining these 2 variables together
-      //   1. The containing block size in the item's inline axis used
-      //   for measuring reflow
-      //   2. The item's baseline padding property
-      uint32_t mHashKey;
+      // The containing block size in the item's inline axis used for
+      // measuring reflow.
+      nscoord mGridAreaISize = 0;
+      // The item's baseline padding property.
+      nscoord mBBaselinePadding = 0;
 
       Key() = default;
 
-      Key(const nsIFrame* aFrame, const LogicalSize& aCBSize) {
-        MOZ_ASSERT(CanHash(aFrame, aCBSize));
-        mHashKey = GenerateHash(aFrame, aCBSize);
-      }
-
-      void UpdateHash(const nsIFrame* aFrame, const LogicalSize& aCBSize) {
-        MOZ_ASSERT(CanHash(aFrame, aCBSize));
-        mHashKey = GenerateHash(aFrame, aCBSize);
-      }
-
-      static uint32_t GenerateHash(const nsIFrame* aFrame,
-                                   const LogicalSize& aCBSize) {
-        MOZ_ASSERT(CanHash(aFrame, aCBSize));
-
-        nscoord gridAreaISize = aCBSize.ISize(aFrame->GetWritingMode());
-        nscoord bBaselinePaddingProperty =
-            abs(aFrame->GetProperty(nsIFrame::BBaselinePadProperty()));
-
-        uint_fast8_t bitsNeededForISize = mozilla::FloorLog2(gridAreaISize) + 1;
-
-        return (gridAreaISize << (32 - bitsNeededForISize)) |
-               bBaselinePaddingProperty;
-      }
-
-      static bool CanHash(const nsIFrame* aFrame, const LogicalSize& aCBSize) {
-        uint_fast8_t bitsNeededForISize =
-            mozilla::FloorLog2(aCBSize.ISize(aFrame->GetWritingMode())) + 1;
-
-        uint_fast8_t bitsNeededForBBaselinePadding =
-            mozilla::FloorLog2(
-                abs(aFrame->GetProperty(nsIFrame::BBaselinePadProperty()))) +
-            1;
-
-        return bitsNeededForISize + bitsNeededForBBaselinePadding <= 32;
-      }
+      Key(const nsIFrame* aFrame, const LogicalSize& aCBSize)
+          : mGridAreaISize(aCBSize.ISize(aFrame->GetWritingMode())),
+            mBBaselinePadding(
+                aFrame->GetProperty(nsIFrame::BBaselinePadProperty())) {}
 
       bool operator==(const Key& aOther) const {
-        return mHashKey == aOther.mHashKey;
+        return mGridAreaISize == aOther.mGridAreaISize &&
+               mBBaselinePadding == aOther.mBBaselinePadding;
       }
     };
 
@@ -1654,7 +1654,14 @@ void Loader::MarkLoadTreeFailed(SheetLoadData& aLoadData,
   } while (data);
 }
 
-RefPtr<StyleSheet> Loader::LookupInlineSheetInCache(const nsAString& aBuffer) {
+// Inline sheets outside of shadow trees are cached too once they are at least
+// this long, since parsing them synchronously is expensive and pages that
+// generate their styles at runtime tend to re-insert the same text.
+static const uint32_t kMinLengthToCacheDocumentInlineSheet = 16 * 1024;
+
+RefPtr<StyleSheet> Loader::LookupInlineSheetInCache(const nsAString& aBuffer,
+                                                    nsIPrincipal* aPrincipal,
+                                                    nsIURI* aBaseURI) {
   auto result = mInlineSheets.Lookup(aBuffer);
   if (!result) {
     return nullptr;
@@ -1665,6 +1672,14 @@ RefPtr<StyleSheet> Loader::LookupInlineSheetInCache(const nsAString& aBuffer) {
     result.Remove();
     return nullptr;
   }
+  // The text alone doesn't determine the sheet: relative URLs resolve
+  // against the base URI, and the principal decides what the sheet may load.
+  bool equal = false;
+  if (!result.Data()->Principal()->Equals(aPrincipal) || !aBaseURI ||
+      NS_FAILED(aBaseURI->Equals(result.Data()->GetBaseURI(), &equal)) ||
+      !equal) {
+    return nullptr;
+  }
   return result.Data()->Clone(nullptr, nullptr);
 }
 
@@ -1720,12 +1735,25 @@ Result<Loader::LoadSheetResult, nsresult> Loader::LoadInlineStyle(
                                 ? aInfo.mTriggeringPrincipal.get()
                                 : loadingPrincipal;
 
-  // We only cache sheets if in shadow trees, since regular document sheets are
-  // likely to be unique.
-  const bool isWorthCaching = aInfo.mContent->IsInShadowTree();
+  nsIPrincipal* sheetPrincipal = principal;
+  if (aInfo.mTriggeringPrincipal) {
+    // The triggering principal may be an expanded principal, which is safe to
+    // use for URL security checks, but not as the loader principal for a
+    // stylesheet. So treat this as principal inheritance, and downgrade if
+    // necessary.
+    sheetPrincipal =
+        BasePrincipal::Cast(aInfo.mTriggeringPrincipal)->PrincipalToInherit();
+  }
+
+  // We cache sheets in shadow trees, since the same sheet is often used by
+  // many instances of a component. Regular document sheets are likely to be
+  // unique, so those are only cached when they're big.
+  const bool isWorthCaching =
+      aInfo.mContent->IsInShadowTree() ||
+      aBuffer.Length() >= kMinLengthToCacheDocumentInlineSheet;
   RefPtr<StyleSheet> sheet;
   if (isWorthCaching) {
-    sheet = LookupInlineSheetInCache(aBuffer);
+    sheet = LookupInlineSheetInCache(aBuffer, sheetPrincipal, baseURI);
   }
   const bool sheetFromCache = !!sheet;
   if (!sheet) {
@@ -1736,16 +1764,6 @@ Result<Loader::LoadSheetResult, nsresult> Loader::LoadInlineStyle(
         ReferrerInfo::CreateForInternalCSSResources(aInfo.mContent->OwnerDoc());
     sheet->SetReferrerInfo(referrerInfo);
 
-    nsIPrincipal* sheetPrincipal = principal;
-    if (aInfo.mTriggeringPrincipal) {
-      // The triggering principal may be an expanded principal, which is safe to
-      // use for URL security checks, but not as the loader principal for a
-      // stylesheet. So treat this as principal inheritance, and downgrade if
-      // necessary.
-      sheetPrincipal =
-          BasePrincipal::Cast(aInfo.mTriggeringPrincipal)->PrincipalToInherit();
-    }
-
     // We never actually load this, so just set its principal directly
     sheet->SetPrincipal(sheetPrincipal);
   }
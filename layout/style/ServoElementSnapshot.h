@@ -64,6 +64,14 @@ class ServoElementSnapshot {
 
   bool HasAttrs() const { return HasAny(Flags::Attributes); }
 
+  /**
+   * Whether a change to aAttribute has already been recorded, in which case
+   * recording it again would be a no-op.
+   */
+  bool HasRecordedAttrChange(nsAtom* aAttribute) const {
+    return HasAttrs() && mChangedAttrNames.Contains(aAttribute);
+  }
+
   bool HasState() const { return HasAny(Flags::State); }
 
   bool HasOtherPseudoClassState() const {
@@ -196,6 +196,15 @@ using namespace mozilla;
 #  define MALLOC_DECOMMIT
 #endif
 
+// MALLOC_THREAD_CACHE enables per-thread caches of small regions (see
+// ThreadCache).  Flushing a cache when its thread exits relies on the
+// thread-local pointer to it still being readable from pthread key
+// destructors, which isn't the case with the pthread-based TLS we have to use
+// on Darwin.
+#ifndef XP_DARWIN
+#  define MALLOC_THREAD_CACHE
+#endif
+
 // When MALLOC_STATIC_PAGESIZE is defined, the page size is fixed at
 // compile-time for better performance, as opposed to determined at
 // runtime. Some platforms can have different page sizes at runtime
@@ -1115,8 +1124,10 @@ struct arena_t {
 
   void* Palloc(size_t aAlignment, size_t aSize);
 
+  // aPoison is false when the region was already poisoned, which is the case
+  // for regions returned from a thread cache.
   inline void DallocSmall(arena_chunk_t* aChunk, void* aPtr,
-                          arena_chunk_map_t* aMapElm);
+                          arena_chunk_map_t* aMapElm, bool aPoison = true);
 
   void DallocLarge(arena_chunk_t* aChunk, void* aPtr);
 
@@ -1285,6 +1296,152 @@ static const bool opt_junk = false;
 static const bool opt_zero = false;
 #endif
 static bool opt_randomize_small = true;
+#ifdef MALLOC_THREAD_CACHE
+static bool opt_thread_cache = true;
+#endif
+#if defined(XP_LINUX) && defined(MADV_HUGEPAGE)
+// Ask for chunks to be backed by transparent huge pages.  This trades some
+// RSS (the kernel has to keep a whole huge page around as long as any part of
+// it is in use) for fewer page faults and TLB misses, which is worth it for
+// large long-running processes.
+#  define MALLOC_HUGEPAGES
+static bool opt_hugepages = false;
+#endif
+
+#ifdef MALLOC_THREAD_CACHE
+// ******
+// Thread caches.
+//
+// Every thread keeps a small cache of regions of the smallest size classes of
+// the default arena.  Allocations of those sizes are served from the cache
+// without taking the arena lock; when a cache bin is empty it is refilled with
+// a batch of regions under a single lock acquisition.  Frees of such regions
+// go to the cache, and when a bin is full half of it is returned to the arena,
+// again under a single lock acquisition.  When small allocations are
+// randomized, a cache hands out a random one of its regions rather than the
+// most recently freed one.
+//
+// Regions in a cache are accounted as allocated in the arena statistics.  A
+// cache is flushed when its thread exits, and jemalloc_free_dirty_pages()
+// makes every thread flush its cache the next time it uses it.
+//
+// The arena can't tell a cached region from a live one, so the first word of
+// every cached region holds its address xor'ed with a per-process random
+// cookie.  Freeing a region that carries that mark, whichever thread's cache
+// it is in, is a double free.
+
+// Largest size class that is cached.
+static const size_t kMaxThreadCacheClass = 256;
+static_assert(kMaxThreadCacheClass <= kMaxQuantumClass,
+              "Only tiny and quantum-spaced classes can be cached");
+
+// Number of cached size classes: all the tiny classes and the quantum-spaced
+// classes up to kMaxThreadCacheClass.
+static const size_t kNumThreadCacheBins =
+    kNumTinyClasses + (kMaxThreadCacheClass - kMinQuantumClass) / kQuantum + 1;
+
+// Each bin of a cache holds at most this many bytes worth of regions, with at
+// least kMinThreadCacheBinRegions and at most kMaxThreadCacheBinRegions
+// regions.  This bounds a cache to about 8 KiB of regions.
+static const size_t kThreadCacheBinBytes = 512;
+static const uint16_t kMinThreadCacheBinRegions = 4;
+static const uint16_t kMaxThreadCacheBinRegions = 32;
+
+struct ThreadCache {
+  struct Bin {
+    uint16_t mNumRegions;
+    uint16_t mMaxRegions;
+    void* mRegions[kMaxThreadCacheBinRegions];
+  };
+
+  // The arena the cached regions belong to.
+  arena_t* mArena;
+
+  // Value of gThreadCachePurgeGeneration when the cache was last flushed.
+  uint32_t mPurgeGeneration;
+
+  // Whether to hand out cached regions in random order, following
+  // opt_randomize_small.
+  bool mRandomize;
+  mozilla::non_crypto::XorShift128PlusRNG mPRNG;
+
+  Bin mBins[kNumThreadCacheBins];
+
+  // Return the current thread's cache if it can hold regions of the given
+  // bin of aArena, creating the cache on first use.
+  static inline ThreadCache* Get(arena_t* aArena, size_t aBinIndex);
+
+  // Whether aPtr, a small region, is in some thread's cache.
+  static inline bool IsCached(void* aPtr);
+
+  inline void* Pop(size_t aBinIndex) {
+    Bin& bin = mBins[aBinIndex];
+    if (!bin.mNumRegions) {
+      return nullptr;
+    }
+    uint16_t last = --bin.mNumRegions;
+    if (mRandomize && last) {
+      std::swap(bin.mRegions[mPRNG.next() % (last + 1)], bin.mRegions[last]);
+    }
+    void* ret = bin.mRegions[last];
+    Unmark(ret);
+    return ret;
+  }
+
+  // Number of regions to add to an empty bin when refilling it.
+  inline uint16_t RefillCount(size_t aBinIndex) const {
+    return mBins[aBinIndex].mMaxRegions / 2;
+  }
+
+  // Add a region that was just allocated from mArena to refill a bin.
+  inline void Refill(size_t aBinIndex, void* aPtr) {
+    Bin& bin = mBins[aBinIndex];
+    MOZ_ASSERT(bin.mNumRegions < bin.mMaxRegions);
+    Mark(aPtr);
+    bin.mRegions[bin.mNumRegions++] = aPtr;
+  }
+
+  // Add a freed region of the given bin to the cache.
+  inline void Push(size_t aBinIndex, void* aPtr, size_t aSize);
+
+  // Return all but aKeep regions of the given bin to mArena.
+  void Flush(size_t aBinIndex, uint16_t aKeep);
+
+  void FlushAll();
+
+ private:
+  static ThreadCache* Create();
+
+  static inline uintptr_t MarkFor(void* aPtr);
+  static inline void Mark(void* aPtr) {
+    *static_cast<uintptr_t*>(aPtr) = MarkFor(aPtr);
+  }
+  static inline void Unmark(void* aPtr) {
+    memset(aPtr, kAllocPoison, sizeof(uintptr_t));
+  }
+};
+
+// Sentinel value for the thread-local cache pointer of threads that don't
+// have a cache, either because it is disabled, being created or, on thread
+// exit, already destroyed.
+static ThreadCache* const kNoThreadCache = reinterpret_cast<ThreadCache*>(1);
+
+static MOZ_THREAD_LOCAL(ThreadCache*) thread_cache;
+
+// Key used to get a destructor called on thread caches at thread exit.
+#  ifdef XP_WIN
+static DWORD gThreadCacheKey = FLS_OUT_OF_INDEXES;
+#  else
+static pthread_key_t gThreadCacheKey;
+#  endif
+
+// Bumped by jemalloc_free_dirty_pages() to make all threads flush their cache.
+static Atomic<uint32_t, Relaxed> gThreadCachePurgeGeneration;
+
+// Random value used to mark cached regions, set when the first cache is
+// created.  See ThreadCache.
+static Atomic<uintptr_t, Relaxed> gThreadCacheCookie;
+#endif
 
 // ***************************************************************************
 // Begin forward declarations.
@@ -1860,8 +2017,20 @@ static void* chunk_alloc_mmap(size_t size, size_t alignment) {
   offset = ALIGNMENT_ADDR2OFFSET(ret, alignment);
   if (offset != 0) {
     pages_unmap(ret, size);
-    return chunk_alloc_mmap_slow(size, alignment);
+    ret = chunk_alloc_mmap_slow(size, alignment);
+    if (!ret) {
+      return nullptr;
+    }
+  }
+
+#ifdef MALLOC_HUGEPAGES
+  // Chunks are smaller than huge pages, but consecutive mappings usually end
+  // up adjacent, and the kernel merges them into a single mapping that can be
+  // backed by huge pages since they all have the same advice.
+  if (opt_hugepages) {
+    madvise(ret, size, MADV_HUGEPAGE);
   }
+#endif
 
   MOZ_ASSERT(ret);
   return ret;
@@ -2621,29 +2790,41 @@ void arena_t::Purge(bool aAll) {
       if (chunk->map[i].bits & CHUNK_MAP_DIRTY) {
 #ifdef MALLOC_DECOMMIT
         const size_t free_operation = CHUNK_MAP_DECOMMITTED;
+        // Pages in this state don't count as committed, so they can be
+        // decommitted again without affecting mStats.committed.
+        const size_t purged = CHUNK_MAP_DECOMMITTED;
 #else
         const size_t free_operation = CHUNK_MAP_MADVISED;
+        const size_t purged = CHUNK_MAP_MADVISED_OR_DECOMMITTED;
 #endif
         MOZ_ASSERT((chunk->map[i].bits & CHUNK_MAP_MADVISED_OR_DECOMMITTED) ==
                    0);
         chunk->map[i].bits ^= free_operation | CHUNK_MAP_DIRTY;
-        // Find adjacent dirty run(s).
-        for (npages = 1; i > gChunkHeaderNumPages &&
-                         (chunk->map[i - 1].bits & CHUNK_MAP_DIRTY);
-             npages++) {
-          i--;
-          MOZ_ASSERT((chunk->map[i].bits & CHUNK_MAP_MADVISED_OR_DECOMMITTED) ==
-                     0);
-          chunk->map[i].bits ^= free_operation | CHUNK_MAP_DIRTY;
+        // Find adjacent dirty run(s).  Free pages that were already purged
+        // don't end the range: purging them again is harmless, and it lets a
+        // single system call cover several dirty runs.
+        size_t npurged = 1;
+        npages = 1;
+        for (size_t j = i; j > gChunkHeaderNumPages; j--) {
+          size_t bits = chunk->map[j - 1].bits;
+          if (bits & CHUNK_MAP_DIRTY) {
+            MOZ_ASSERT((bits & CHUNK_MAP_MADVISED_OR_DECOMMITTED) == 0);
+            chunk->map[j - 1].bits ^= free_operation | CHUNK_MAP_DIRTY;
+            npurged++;
+            npages = i - (j - 1) + 1;
+          } else if ((bits & CHUNK_MAP_ALLOCATED) || !(bits & purged)) {
+            break;
+          }
         }
-        chunk->ndirty -= npages;
-        mNumDirty -= npages;
+        i -= npages - 1;
+        chunk->ndirty -= npurged;
+        mNumDirty -= npurged;
 
 #ifdef MALLOC_DECOMMIT
         pages_decommit((void*)(uintptr_t(chunk) + (i << gPageSize2Pow)),
                        (npages << gPageSize2Pow));
 #endif
-        mStats.committed -= npages;
+        mStats.committed -= npurged;
 
 #ifndef MALLOC_DECOMMIT
 #  ifdef XP_SOLARIS
@@ -2977,6 +3158,12 @@ void* arena_t::MallocSmall(size_t aSize, bool aZero) {
   }
   MOZ_DIAGNOSTIC_ASSERT(aSize == bin->mSizeClass);
 
+#ifdef MALLOC_THREAD_CACHE
+  size_t binIndex = bin - mBins;
+  ThreadCache* tcache = ThreadCache::Get(this, binIndex);
+  ret = tcache ? tcache->Pop(binIndex) : nullptr;
+  if (!ret)
+#endif
   {
     // Before we lock, we determine if we need to randomize the allocation
     // because if we do, we need to create the PRNG which might require
@@ -3018,6 +3205,26 @@ void* arena_t::MallocSmall(size_t aSize, bool aZero) {
     }
 
     mStats.allocated_small += aSize;
+
+#ifdef MALLOC_THREAD_CACHE
+    // While we hold the lock, take a batch of regions for the thread cache so
+    // that the next allocations of this size don't need it.
+    if (tcache) {
+      for (uint16_t i = tcache->RefillCount(binIndex); i > 0; i--) {
+        if (run->mNumFree == 0) {
+          run = bin->mCurrentRun = GetNonFullBinRun(bin);
+          if (!run) {
+            break;
+          }
+        }
+        void* region = ArenaRunRegAlloc(run, bin);
+        MOZ_DIAGNOSTIC_ASSERT(region);
+        run->mNumFree--;
+        mStats.allocated_small += aSize;
+        tcache->Refill(binIndex, region);
+      }
+    }
+#endif
   }
 
   if (!aZero) {
@@ -3422,7 +3629,7 @@ MOZ_NEVER_INLINE jemalloc_ptr_info_t* jemalloc_ptr_info(const void* aPtr) {
 }  // namespace Debug
 
 void arena_t::DallocSmall(arena_chunk_t* aChunk, void* aPtr,
-                          arena_chunk_map_t* aMapElm) {
+                          arena_chunk_map_t* aMapElm, bool aPoison) {
   arena_run_t* run;
   arena_bin_t* bin;
   size_t size;
@@ -3434,7 +3641,9 @@ void arena_t::DallocSmall(arena_chunk_t* aChunk, void* aPtr,
   MOZ_DIAGNOSTIC_ASSERT(uintptr_t(aPtr) >=
                         uintptr_t(run) + bin->mRunFirstRegionOffset);
 
-  memset(aPtr, kAllocPoison, size);
+  if (aPoison) {
+    memset(aPtr, kAllocPoison, size);
+  }
 
   arena_run_reg_dalloc(run, bin, aPtr, size);
   run->mNumFree++;
@@ -3512,9 +3721,26 @@ static inline void arena_dalloc(void* aPtr, size_t aOffset, arena_t* aArena) {
   MOZ_DIAGNOSTIC_ASSERT(arena->mMagic == ARENA_MAGIC);
   MOZ_RELEASE_ASSERT(!aArena || arena == aArena);
 
-  MutexAutoLock lock(arena->mLock);
   size_t pageind = aOffset >> gPageSize2Pow;
   arena_chunk_map_t* mapelm = &chunk->map[pageind];
+
+#ifdef MALLOC_THREAD_CACHE
+  // The map bits of a page holding a live small allocation don't change until
+  // it is freed, so it's fine to look at them before taking the lock.
+  if ((mapelm->bits & (CHUNK_MAP_LARGE | CHUNK_MAP_DECOMMITTED)) == 0 &&
+      (mapelm->bits & CHUNK_MAP_ALLOCATED) != 0) {
+    auto run = (arena_run_t*)(mapelm->bits & ~gPageSizeMask);
+    MOZ_DIAGNOSTIC_ASSERT(run->mMagic == ARENA_RUN_MAGIC);
+    MOZ_RELEASE_ASSERT(!ThreadCache::IsCached(aPtr), "Double-free?");
+    size_t binIndex = run->mBin - arena->mBins;
+    if (ThreadCache* tcache = ThreadCache::Get(arena, binIndex)) {
+      tcache->Push(binIndex, aPtr, run->mBin->mSizeClass);
+      return;
+    }
+  }
+#endif
+
+  MutexAutoLock lock(arena->mLock);
   MOZ_RELEASE_ASSERT((mapelm->bits & CHUNK_MAP_DECOMMITTED) == 0,
                      "Freeing in decommitted page.");
   MOZ_RELEASE_ASSERT((mapelm->bits & CHUNK_MAP_ALLOCATED) != 0, "Double-free?");
@@ -3540,6 +3766,148 @@ static inline void idalloc(void* ptr, arena_t* aArena) {
   }
 }
 
+#ifdef MALLOC_THREAD_CACHE
+inline ThreadCache* ThreadCache::Get(arena_t* aArena, size_t aBinIndex) {
+  if (aBinIndex >= kNumThreadCacheBins) {
+    return nullptr;
+  }
+
+  ThreadCache* cache = thread_cache.get();
+  if (MOZ_UNLIKELY(!cache)) {
+    cache = Create();
+  }
+  if (cache == kNoThreadCache || cache->mArena != aArena) {
+    return nullptr;
+  }
+
+  if (MOZ_UNLIKELY(cache->mPurgeGeneration != gThreadCachePurgeGeneration)) {
+    cache->FlushAll();
+  }
+  return cache;
+}
+
+inline uintptr_t ThreadCache::MarkFor(void* aPtr) {
+  return gThreadCacheCookie ^ uintptr_t(aPtr);
+}
+
+inline bool ThreadCache::IsCached(void* aPtr) {
+  // Without a cookie there can't be any cache yet.
+  return gThreadCacheCookie &&
+         *static_cast<uintptr_t*>(aPtr) == MarkFor(aPtr);
+}
+
+// The caller has checked that aPtr isn't already cached.
+inline void ThreadCache::Push(size_t aBinIndex, void* aPtr, size_t aSize) {
+  Bin& bin = mBins[aBinIndex];
+  memset(aPtr, kAllocPoison, aSize);
+  Mark(aPtr);
+
+  if (bin.mNumRegions == bin.mMaxRegions) {
+    Flush(aBinIndex, bin.mMaxRegions / 2);
+  }
+  bin.mRegions[bin.mNumRegions++] = aPtr;
+}
+
+void ThreadCache::Flush(size_t aBinIndex, uint16_t aKeep) {
+  Bin& bin = mBins[aBinIndex];
+  if (bin.mNumRegions <= aKeep) {
+    return;
+  }
+
+  // Return the least recently freed regions, which are at the bottom of the
+  // stack.
+  uint16_t count = bin.mNumRegions - aKeep;
+  {
+    MutexAutoLock lock(mArena->mLock);
+    for (uint16_t i = 0; i < count; i++) {
+      void* ptr = bin.mRegions[i];
+      Unmark(ptr);
+      arena_chunk_t* chunk = GetChunkForPtr(ptr);
+      size_t pageind = (uintptr_t(ptr) - uintptr_t(chunk)) >> gPageSize2Pow;
+      mArena->DallocSmall(chunk, ptr, &chunk->map[pageind],
+                          /* aPoison = */ false);
+    }
+  }
+  memmove(&bin.mRegions[0], &bin.mRegions[count], aKeep * sizeof(void*));
+  bin.mNumRegions = aKeep;
+}
+
+void ThreadCache::FlushAll() {
+  mPurgeGeneration = gThreadCachePurgeGeneration;
+  for (size_t i = 0; i < kNumThreadCacheBins; i++) {
+    Flush(i, 0);
+  }
+}
+
+ThreadCache* ThreadCache::Create() {
+  // Allocating the cache may recurse into the allocator, so make sure that
+  // doesn't try to create another one.
+  thread_cache.set(kNoThreadCache);
+  if (!opt_thread_cache) {
+    return kNoThreadCache;
+  }
+
+  // Getting random numbers may allocate, which is fine now that this thread
+  // won't try to create a cache again.
+  if (!gThreadCacheCookie) {
+    uintptr_t cookie = uintptr_t(mozilla::RandomUint64().valueOr(0)) | 1;
+    gThreadCacheCookie.compareExchange(0, cookie);
+  }
+  mozilla::Maybe<uint64_t> prngState1 = mozilla::RandomUint64();
+  mozilla::Maybe<uint64_t> prngState2 = mozilla::RandomUint64();
+
+  arena_t* arena = gArenas.GetDefault();
+  auto cache = (ThreadCache*)arena->Malloc(sizeof(ThreadCache), true);
+  if (!cache) {
+    return kNoThreadCache;
+  }
+  cache->mArena = arena;
+  cache->mPurgeGeneration = gThreadCachePurgeGeneration;
+  // Randomized small allocations make it harder to predict which region an
+  // allocation gets, e.g. to reclaim a freed object after a use-after-free.
+  // The default arena's randomization follows opt_randomize_small; its own
+  // flag is briefly cleared while its PRNG is initialized, so don't look at it
+  // here.
+  cache->mRandomize = opt_randomize_small;
+  new (&cache->mPRNG) mozilla::non_crypto::XorShift128PlusRNG(
+      prngState1.valueOr(0), prngState2.valueOr(0));
+  for (size_t i = 0; i < kNumThreadCacheBins; i++) {
+    size_t maxRegions = kThreadCacheBinBytes / arena->mBins[i].mSizeClass;
+    maxRegions = std::max(maxRegions, size_t(kMinThreadCacheBinRegions));
+    maxRegions = std::min(maxRegions, size_t(kMaxThreadCacheBinRegions));
+    cache->mBins[i].mMaxRegions = uint16_t(maxRegions);
+  }
+
+#  ifdef XP_WIN
+  bool registered = FlsSetValue(gThreadCacheKey, cache);
+#  else
+  bool registered = pthread_setspecific(gThreadCacheKey, cache) == 0;
+#  endif
+  if (!registered) {
+    // Without a destructor, the cached regions would leak when the thread
+    // exits.
+    idalloc(cache, arena);
+    return kNoThreadCache;
+  }
+
+  thread_cache.set(cache);
+  return cache;
+}
+
+#  ifdef XP_WIN
+static void NTAPI ThreadCacheDestructor(void* aCache) {
+#  else
+static void ThreadCacheDestructor(void* aCache) {
+#  endif
+  auto cache = static_cast<ThreadCache*>(aCache);
+  // Other thread exit code may still free memory after this; make sure it
+  // neither uses the cache nor creates a new one.
+  thread_cache.set(kNoThreadCache);
+  cache->FlushAll();
+  idalloc(cache, cache->mArena);
+}
+#endif
+
 void arena_t::RallocShrinkLarge(arena_chunk_t* aChunk, void* aPtr, size_t aSize,
                                 size_t aOldSize) {
   MOZ_ASSERT(aSize < aOldSize);
@@ -4012,6 +4380,12 @@ static bool malloc_init_hard() {
     return true;
   }
 
+#ifdef MALLOC_THREAD_CACHE
+  if (!thread_cache.init()) {
+    return true;
+  }
+#endif
+
   // Get page size and number of CPUs
   result = GetKernelPageSize();
   // We assume that the page size is a power of 2.
@@ -4097,6 +4471,22 @@ static bool malloc_init_hard() {
           case 'R':
             opt_randomize_small = true;
             break;
+#ifdef MALLOC_THREAD_CACHE
+          case 't':
+            opt_thread_cache = false;
+            break;
+          case 'T':
+            opt_thread_cache = true;
+            break;
+#endif
+#ifdef MALLOC_HUGEPAGES
+          case 'h':
+            opt_hugepages = false;
+            break;
+          case 'H':
+            opt_hugepages = true;
+            break;
+#endif
           default: {
             char cbuf[2];
 
@@ -4141,6 +4531,18 @@ static bool malloc_init_hard() {
   // Assign the default arena to the initial thread.
   thread_arena.set(gArenas.GetDefault());
 
+#ifdef MALLOC_THREAD_CACHE
+  if (opt_thread_cache) {
+#  ifdef XP_WIN
+    gThreadCacheKey = FlsAlloc(ThreadCacheDestructor);
+    opt_thread_cache = gThreadCacheKey != FLS_OUT_OF_INDEXES;
+#  else
+    opt_thread_cache =
+        pthread_key_create(&gThreadCacheKey, ThreadCacheDestructor) == 0;
+#  endif
+  }
+#endif
+
   if (!gChunkRTree.Init()) {
     return false;
   }
@@ -4578,6 +4980,15 @@ inline void MozJemalloc::jemalloc_purge_freed_pages() {
 template <>
 inline void MozJemalloc::jemalloc_free_dirty_pages(void) {
   if (malloc_initialized) {
+#ifdef MALLOC_THREAD_CACHE
+    // Other threads flush their caches the next time they use them; this
+    // thread can do it right away so the regions get purged below.
+    gThreadCachePurgeGeneration++;
+    ThreadCache* cache = thread_cache.get();
+    if (cache && cache != kNoThreadCache) {
+      cache->FlushAll();
+    }
+#endif
     MutexAutoLock lock(gArenas.mLock);
     for (auto arena : gArenas.iter()) {
       MutexAutoLock arena_lock(arena->mLock);
@@ -16,6 +16,8 @@
 
 #include "gtest/gtest.h"
 
+#include <thread>
+
 #ifdef MOZ_PHC
 #  include "replace_malloc_bridge.h"
 #endif
@@ -809,3 +811,165 @@ TEST(Jemalloc, DisposeArena)
   _gdb_sleep_duration = old_gdb_sleep_duration;
 #endif
 }
+
+// Small allocations in the default arena may go through a per-thread cache,
+// depending on the allocator options. Either way, freed regions must be
+// poisoned, double frees must crash, and regions freed on other threads or
+// still cached when a thread exits must be handed out correctly again.
+TEST(Jemalloc, DefaultArenaSmall)
+{
+  // The testing UAFs aren't valid for PHC allocations.
+  AutoDisablePHCOnCurrentThread disable;
+
+#ifdef HAS_GDB_SLEEP_DURATION
+  // Avoid death tests adding some unnecessary (long) delays.
+  unsigned int old_gdb_sleep_duration = _gdb_sleep_duration;
+  _gdb_sleep_duration = 0;
+#endif
+
+  char poison_buf[256];
+  memset(poison_buf, 0xe5, sizeof(poison_buf));
+
+  for (size_t size = 1; size <= sizeof(poison_buf); size++) {
+    SCOPED_TRACE(testing::Message() << "size = " << size);
+    // Keep another region of the same size class alive, so that the run
+    // holding |buf| isn't released and purged when |buf| is freed.
+    char* keep = (char*)malloc(size);
+    char* buf = (char*)malloc(size);
+    size_t usable = moz_malloc_usable_size(buf);
+    memset(buf, 0x42, usable);
+    free(buf);
+    // We purposefully do a use-after-free here, to check that the data was
+    // poisoned. A region in a thread cache has a marker in its first word.
+    ASSERT_NO_FATAL_FAILURE(bulk_compare(buf, sizeof(uintptr_t), usable,
+                                         poison_buf, sizeof(poison_buf)));
+    // Death tests are slow, so only check a few sizes.
+    if (size % 64 == 0) {
+      ASSERT_DEATH_WRAP(free(buf), "");
+    }
+    free(keep);
+  }
+
+  // Allocate on some threads and free on another, and check that no two live
+  // regions overlap.
+  struct Alloc {
+    char* mPtr;
+    size_t mSize;
+    char mValue;
+  };
+  static const size_t kNumThreads = 4;
+  static const size_t kNumAllocs = 1000;
+  Vector<Alloc> allocs[kNumThreads];
+  for (auto& a : allocs) {
+    ASSERT_TRUE(a.reserve(kNumAllocs));
+  }
+  auto allocate = [](Vector<Alloc>& aAllocs, size_t aSeed) {
+    AutoDisablePHCOnCurrentThread disable;
+    for (size_t i = 0; i < kNumAllocs; i++) {
+      size_t size = (i * 7 + aSeed) % 256 + 1;
+      char value = char(i * kNumThreads + aSeed);
+      char* ptr = (char*)malloc(size);
+      memset(ptr, value, size);
+      aAllocs.infallibleAppend(Alloc{ptr, size, value});
+      // Free some of them on this thread, so that there are freed regions to
+      // reuse.
+      if (i % 3 == 0) {
+        free(aAllocs.popCopy().mPtr);
+      }
+    }
+  };
+  std::thread threads[kNumThreads];
+  for (size_t t = 0; t < kNumThreads; t++) {
+    threads[t] = std::thread(allocate, std::ref(allocs[t]), t);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& a : allocs) {
+    for (const Alloc& alloc : a) {
+      for (size_t i = 0; i < alloc.mSize; i++) {
+        ASSERT_EQ(alloc.mPtr[i], alloc.mValue);
+      }
+      free(alloc.mPtr);
+    }
+  }
+
+#ifdef HAS_GDB_SLEEP_DURATION
+  _gdb_sleep_duration = old_gdb_sleep_duration;
+#endif
+}
+
+// Exercise the per-thread cache of small regions of the default arena: cached
+// regions are handed out again, flushed on memory pressure and on thread exit,
+// and freeing them again from any thread crashes.
+TEST(Jemalloc, ThreadCache)
+{
+  // The testing UAFs aren't valid for PHC allocations.
+  AutoDisablePHCOnCurrentThread disable;
+
+  static const size_t kSize = 48;
+  jemalloc_ptr_info_t info;
+
+  // A freed region that is still accounted as allocated is in the cache.
+  char* ptr = (char*)malloc(kSize);
+  free(ptr);
+  jemalloc_ptr_info(ptr, &info);
+  if (info.tag != TagLiveAlloc) {
+    GTEST_SKIP() << "Thread caches are disabled";
+  }
+
+  // The region comes back within as many allocations as a bin can hold, in
+  // whatever order the cache hands them out.
+  char* allocs[32];
+  bool reused = false;
+  for (char*& alloc : allocs) {
+    alloc = (char*)malloc(kSize);
+    reused = reused || alloc == ptr;
+  }
+  EXPECT_TRUE(reused);
+  for (char* alloc : allocs) {
+    free(alloc);
+  }
+
+  // Memory pressure returns the cached regions to the arena.
+  ptr = (char*)malloc(kSize);
+  free(ptr);
+  jemalloc_ptr_info(ptr, &info);
+  EXPECT_EQ(info.tag, TagLiveAlloc);
+  jemalloc_free_dirty_pages();
+  jemalloc_ptr_info(ptr, &info);
+  EXPECT_NE(info.tag, TagLiveAlloc);
+
+  // So does thread exit.
+  char* threadPtr = nullptr;
+  PtrInfoTag threadTag = TagUnknown;
+  std::thread thread([&] {
+    AutoDisablePHCOnCurrentThread disable;
+    threadPtr = (char*)malloc(kSize);
+    free(threadPtr);
+    jemalloc_ptr_info_t threadInfo;
+    jemalloc_ptr_info(threadPtr, &threadInfo);
+    threadTag = threadInfo.tag;
+  });
+  thread.join();
+  EXPECT_EQ(threadTag, TagLiveAlloc);
+  jemalloc_ptr_info(threadPtr, &info);
+  EXPECT_NE(info.tag, TagLiveAlloc);
+
+#ifdef HAS_GDB_SLEEP_DURATION
+  // Avoid death tests adding some unnecessary (long) delays.
+  unsigned int old_gdb_sleep_duration = _gdb_sleep_duration;
+  _gdb_sleep_duration = 0;
+#endif
+
+  // Freeing a region that is in this thread's cache, or in another thread's,
+  // is a double free.
+  ptr = (char*)malloc(kSize);
+  free(ptr);
+  ASSERT_DEATH_WRAP(free(ptr), "");
+  ASSERT_DEATH_WRAP(std::thread([&] { free(ptr); }).join(), "");
+
+#ifdef HAS_GDB_SLEEP_DURATION
+  _gdb_sleep_duration = old_gdb_sleep_duration;
+#endif
+}
@@ -34,11 +34,22 @@ uintptr_t AlignUp16(uintptr_t ptr) { return AlignDown16(ptr + 0xf); }
 
 template <typename CharType>
 __m128i CmpEq128(__m128i a, __m128i b) {
-  static_assert(sizeof(CharType) == 1 || sizeof(CharType) == 2);
+  static_assert(sizeof(CharType) == 1 || sizeof(CharType) == 2 ||
+                sizeof(CharType) == 4 || sizeof(CharType) == 8);
   if (sizeof(CharType) == 1) {
     return _mm_cmpeq_epi8(a, b);
   }
-  return _mm_cmpeq_epi16(a, b);
+  if (sizeof(CharType) == 2) {
+    return _mm_cmpeq_epi16(a, b);
+  }
+  if (sizeof(CharType) == 4) {
+    return _mm_cmpeq_epi32(a, b);
+  }
+  // SSE2 has no 64-bit compare, so compare the 32-bit halves and require
+  // both halves of a lane to match.
+  __m128i cmp32 = _mm_cmpeq_epi32(a, b);
+  return _mm_and_si128(cmp32,
+                       _mm_shuffle_epi32(cmp32, _MM_SHUFFLE(2, 3, 0, 1)));
 }
 
 #  ifdef __GNUC__
@@ -203,13 +214,18 @@ const CharType* Check2x2x16Bytes(__m128i needle1, __m128i needle2, uintptr_t a,
 template <typename CharType>
 const CharType* FindInBuffer(const CharType* ptr, CharType value,
                              size_t length) {
-  static_assert(sizeof(CharType) == 1 || sizeof(CharType) == 2);
+  static_assert(sizeof(CharType) == 1 || sizeof(CharType) == 2 ||
+                sizeof(CharType) == 4 || sizeof(CharType) == 8);
   static_assert(std::is_unsigned<CharType>::value);
   uint64_t splat64;
   if (sizeof(CharType) == 1) {
     splat64 = 0x0101010101010101llu;
-  } else {
+  } else if (sizeof(CharType) == 2) {
     splat64 = 0x0001000100010001llu;
+  } else if (sizeof(CharType) == 4) {
+    splat64 = 0x0000000100000001llu;
+  } else {
+    splat64 = 1;
   }
 
   // Load our needle into a 16-byte register
@@ -420,6 +436,83 @@ const CharType* FindTwoInBuffer(const CharType* ptr, CharType v1, CharType v2,
                                     nullptr, HaystackOverlap::Overlapping);
 }
 
+template <typename CharType>
+__m128i Splat128(CharType value) {
+  static_assert(sizeof(CharType) == 1 || sizeof(CharType) == 2);
+  if (sizeof(CharType) == 1) {
+    return _mm_set1_epi8(static_cast<char>(value));
+  }
+  return _mm_set1_epi16(static_cast<short>(value));
+}
+
+// Unsigned less-than comparison. SSE2 only has signed comparisons, so flip the
+// sign bit of both operands first. `bFlipped` must already be flipped.
+template <typename CharType>
+__m128i CmpLtUnsigned128(__m128i a, __m128i signBit, __m128i bFlipped) {
+  static_assert(sizeof(CharType) == 1 || sizeof(CharType) == 2);
+  __m128i aFlipped = _mm_xor_si128(a, signBit);
+  if (sizeof(CharType) == 1) {
+    return _mm_cmplt_epi8(aFlipped, bFlipped);
+  }
+  return _mm_cmplt_epi16(aFlipped, bFlipped);
+}
+
+template <typename CharType>
+const CharType* FindAnyTwoOrLessThanInBuffer(const CharType* ptr, CharType v1,
+                                             CharType v2, CharType lessThan,
+                                             size_t length) {
+  static_assert(sizeof(CharType) == 1 || sizeof(CharType) == 2);
+  static_assert(std::is_unsigned<CharType>::value);
+
+  size_t numBytes = length * sizeof(CharType);
+  uintptr_t cur = reinterpret_cast<uintptr_t>(ptr);
+  uintptr_t end = cur + numBytes;
+
+  if (numBytes < 16) {
+    while (cur < end) {
+      CharType c = GetAs<CharType>(cur);
+      if (c == v1 || c == v2 || c < lessThan) {
+        return reinterpret_cast<const CharType*>(cur);
+      }
+      cur += sizeof(CharType);
+    }
+    return nullptr;
+  }
+
+  __m128i needle1 = Splat128<CharType>(v1);
+  __m128i needle2 = Splat128<CharType>(v2);
+  __m128i signBit =
+      Splat128<CharType>(CharType(1) << (sizeof(CharType) * 8 - 1));
+  __m128i limit = _mm_xor_si128(Splat128<CharType>(lessThan), signBit);
+
+  auto check = [&](uintptr_t p) -> int {
+    __m128i haystack = _mm_loadu_si128(Cast128(p));
+    __m128i cmp1 = CmpEq128<CharType>(needle1, haystack);
+    __m128i cmp2 = CmpEq128<CharType>(needle2, haystack);
+    __m128i cmp3 = CmpLtUnsigned128<CharType>(haystack, signBit, limit);
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(cmp1, cmp2), cmp3));
+  };
+
+  // Step through the buffer 16 bytes at a time. The final chunk is loaded so
+  // that it ends at the end of the buffer, overlapping with what we already
+  // checked, to avoid a scalar tail loop.
+  uintptr_t tailStartPtr = end - 16;
+  while (cur < tailStartPtr) {
+    int cmpMask = check(cur);
+    if (cmpMask) {
+      return reinterpret_cast<const CharType*>(cur + __builtin_ctz(cmpMask));
+    }
+    cur += 16;
+  }
+
+  int cmpMask = check(tailStartPtr);
+  if (cmpMask) {
+    return reinterpret_cast<const CharType*>(tailStartPtr +
+                                             __builtin_ctz(cmpMask));
+  }
+  return nullptr;
+}
+
 const char* SIMD::memchr8(const char* ptr, char value, size_t length) {
   // Signed chars are just really annoying to do bit logic with. Convert to
   // unsigned at the outermost scope so we don't have to worry about it.
@@ -435,6 +528,16 @@ const char16_t* SIMD::memchr16(const char16_t* ptr, char16_t value,
   return FindInBuffer<char16_t>(ptr, value, length);
 }
 
+const uint32_t* SIMD::memchr32(const uint32_t* ptr, uint32_t value,
+                               size_t length) {
+  return FindInBuffer<uint32_t>(ptr, value, length);
+}
+
+const uint64_t* SIMD::memchr64(const uint64_t* ptr, uint64_t value,
+                               size_t length) {
+  return FindInBuffer<uint64_t>(ptr, value, length);
+}
+
 const char* SIMD::memchr2x8(const char* ptr, char v1, char v2, size_t length) {
   // Signed chars are just really annoying to do bit logic with. Convert to
   // unsigned at the outermost scope so we don't have to worry about it.
@@ -451,6 +554,21 @@ const char16_t* SIMD::memchr2x16(const char16_t* ptr, char16_t v1, char16_t v2,
   return FindTwoInBuffer<char16_t>(ptr, v1, v2, length);
 }
 
+const char* SIMD::memchrAny2OrLessThan8(const char* ptr, char v1, char v2,
+                                       char lessThan, size_t length) {
+  const unsigned char* uptr = reinterpret_cast<const unsigned char*>(ptr);
+  const unsigned char* uresult = FindAnyTwoOrLessThanInBuffer<unsigned char>(
+      uptr, static_cast<unsigned char>(v1), static_cast<unsigned char>(v2),
+      static_cast<unsigned char>(lessThan), length);
+  return reinterpret_cast<const char*>(uresult);
+}
+
+const char16_t* SIMD::memchrAny2OrLessThan16(const char16_t* ptr, char16_t v1,
+                                             char16_t v2, char16_t lessThan,
+                                             size_t length) {
+  return FindAnyTwoOrLessThanInBuffer<char16_t>(ptr, v1, v2, lessThan, length);
+}
+
 #else
 
 #  include <cstring>
@@ -473,6 +591,28 @@ const char16_t* SIMD::memchr16(const char16_t* ptr, char16_t value,
   return nullptr;
 }
 
+template <typename T>
+const T* FindInBufferNaive(const T* ptr, T value, size_t length) {
+  const T* end = ptr + length;
+  while (ptr < end) {
+    if (*ptr == value) {
+      return ptr;
+    }
+    ptr++;
+  }
+  return nullptr;
+}
+
+const uint32_t* SIMD::memchr32(const uint32_t* ptr, uint32_t value,
+                               size_t length) {
+  return FindInBufferNaive(ptr, value, length);
+}
+
+const uint64_t* SIMD::memchr64(const uint64_t* ptr, uint64_t value,
+                               size_t length) {
+  return FindInBufferNaive(ptr, value, length);
+}
+
 const char* SIMD::memchr2x8(const char* ptr, char v1, char v2, size_t length) {
   const char* end = ptr + length - 1;
   while (ptr < end) {
@@ -504,6 +644,35 @@ const char16_t* SIMD::memchr2x16(const char16_t* ptr, char16_t v1, char16_t v2,
   return nullptr;
 }
 
+const char* SIMD::memchrAny2OrLessThan8(const char* ptr, char v1, char v2,
+                                       char lessThan, size_t length) {
+  const unsigned char* uptr = reinterpret_cast<const unsigned char*>(ptr);
+  const unsigned char* end = uptr + length;
+  unsigned char uv1 = static_cast<unsigned char>(v1);
+  unsigned char uv2 = static_cast<unsigned char>(v2);
+  unsigned char ulessThan = static_cast<unsigned char>(lessThan);
+  while (uptr < end) {
+    if (*uptr == uv1 || *uptr == uv2 || *uptr < ulessThan) {
+      return reinterpret_cast<const char*>(uptr);
+    }
+    uptr++;
+  }
+  return nullptr;
+}
+
+const char16_t* SIMD::memchrAny2OrLessThan16(const char16_t* ptr, char16_t v1,
+                                             char16_t v2, char16_t lessThan,
+                                             size_t length) {
+  const char16_t* end = ptr + length;
+  while (ptr < end) {
+    if (*ptr == v1 || *ptr == v2 || *ptr < lessThan) {
+      return ptr;
+    }
+    ptr++;
+  }
+  return nullptr;
+}
+
 #endif
 
 }  // namespace mozilla
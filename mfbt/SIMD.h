@@ -38,6 +38,18 @@ class SIMD {
   static MFBT_API const char16_t* memchr16(const char16_t* ptr, char16_t value,
                                            size_t length);
 
+  // Search through `ptr[0..length]` for the first occurrence of `value` and
+  // return the pointer to it, or nullptr if it cannot be found. `ptr` must be
+  // aligned to the element size.
+  static MFBT_API const uint32_t* memchr32(const uint32_t* ptr, uint32_t value,
+                                           size_t length);
+
+  // Search through `ptr[0..length]` for the first occurrence of `value` and
+  // return the pointer to it, or nullptr if it cannot be found. `ptr` must be
+  // aligned to the element size.
+  static MFBT_API const uint64_t* memchr64(const uint64_t* ptr, uint64_t value,
+                                           size_t length);
+
   // Search through `ptr[0..length]` for the first occurrence of `v1` which is
   // immediately followed by `v2` and return the pointer to the occurrence of
   // `v1`.
@@ -49,6 +61,23 @@ class SIMD {
   // `v1`.
   static MFBT_API const char16_t* memchr2x16(const char16_t* ptr, char16_t v1,
                                              char16_t v2, size_t length);
+
+  // Search through `ptr[0..length]` for the first character which is equal to
+  // `v1` or `v2`, or which is less than `lessThan` (as an unsigned value), and
+  // return the pointer to it, or nullptr if it cannot be found. This is useful
+  // for finding the end of a run of unescaped characters in a quoted string.
+  static MFBT_API const char* memchrAny2OrLessThan8(const char* ptr, char v1,
+                                                    char v2, char lessThan,
+                                                    size_t length);
+
+  // Search through `ptr[0..length]` for the first character which is equal to
+  // `v1` or `v2`, or which is less than `lessThan`, and return the pointer to
+  // it, or nullptr if it cannot be found.
+  static MFBT_API const char16_t* memchrAny2OrLessThan16(const char16_t* ptr,
+                                                         char16_t v1,
+                                                         char16_t v2,
+                                                         char16_t lessThan,
+                                                         size_t length);
 };
 
 }  // namespace mozilla
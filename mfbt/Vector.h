@@ -10,6 +10,7 @@
 #define mozilla_Vector_h
 
 #include <new>  // for placement new
+#include <type_traits>
 #include <utility>
 
 #include "mozilla/Alignment.h"
@@ -120,6 +121,19 @@ struct VectorImpl {
                                           size_t aNewCap) {
     MOZ_ASSERT(!aV.usingInlineStorage());
     MOZ_ASSERT(!CapacityHasExcessSpace<T>(aNewCap));
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      // Types that aren't IsPod but can be copied bytewise are relocated
+      // with realloc, which can often extend the buffer in place.
+      T* newbuf =
+          aV.template pod_realloc<T>(aV.mBegin, aV.mTail.mCapacity, aNewCap);
+      if (MOZ_UNLIKELY(!newbuf)) {
+        return false;
+      }
+      aV.mBegin = newbuf;
+      /* aV.mLength is unchanged. */
+      aV.mTail.mCapacity = aNewCap;
+      return true;
+    }
     T* newbuf = aV.template pod_malloc<T>(aNewCap);
     if (MOZ_UNLIKELY(!newbuf)) {
       return false;
@@ -182,6 +182,32 @@ void TestGauntlet16() {
   }
 }
 
+template <typename T, const T* (*Search)(const T*, T, size_t)>
+void TestGauntletWide() {
+  const size_t count = 67;
+  T test[count];
+  for (size_t i = 0; i < count; ++i) {
+    // Set bits in both halves of 64-bit elements so that matching only one
+    // half of an element isn't enough.
+    test[i] = T(i) | (T(i) << (sizeof(T) * 4));
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 0; j < count; ++j) {
+      for (size_t k = 0; k <= i; ++k) {
+        const T* expected = nullptr;
+        if (j >= k && j < i) {
+          expected = test + j;
+        }
+        MOZ_RELEASE_ASSERT(Search(test + k, test[j], i - k) == expected);
+      }
+    }
+  }
+
+  // A value matching only the low half of an element must not be found.
+  MOZ_RELEASE_ASSERT(Search(test, T(5), count) == nullptr);
+}
+
 void TestTinyString2x8() {
   const char* test = "012\n";
 
@@ -394,6 +420,85 @@ void TestGauntlet2x16() {
   }
 }
 
+void TestAny2OrLessThan8() {
+  const char* test = "abcdefghijklmnopqrstuvwxyz0123456789\"\\\x1f";
+
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan8(test, '"', '\\', 0x20, 36) ==
+                     nullptr);
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan8(test, '"', '\\', 0x20, 39) ==
+                     test + 36);
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan8(test, '\\', '"', 0x20, 39) ==
+                     test + 36);
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan8(test, '\\', 'z', 0x20, 39) ==
+                     test + 25);
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan8(test + 37, 'x', 'y', 0x20,
+                                                 2) == test + 38);
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan8(test, 'x', 'y', 'b', 39) ==
+                     test + 0);
+
+  // Characters with the high bit set must compare as unsigned.
+  const char* high =
+      "\x80\x90\xa0\xb0\xc0\xd0\xe0\xf0\xff\x80\x90\xa0\xb0\xc0\xd0\xe0\x01";
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan8(high, '"', '\\', 0x20, 17) ==
+                     high + 16);
+}
+
+void TestAny2OrLessThan16() {
+  const char16_t* test =
+      u"\u4e00\u4e01\u4e02\u4e03abcdefghijklmnopqrstuvwxyz\"\\\x1f";
+
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan16(test, '"', '\\', 0x20,
+                                                  30) == nullptr);
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan16(test, '"', '\\', 0x20,
+                                                  33) == test + 30);
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan16(test, '\\', 'z', 0x20,
+                                                  33) == test + 29);
+  MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan16(test + 31, 'x', 'y', 0x20,
+                                                  2) == test + 32);
+}
+
+void TestGauntletAny2OrLessThan8() {
+  const size_t count = 64;
+  char test[count];
+  for (size_t i = 0; i < count; ++i) {
+    test[i] = 'a';
+  }
+
+  for (size_t len = 0; len < count; ++len) {
+    for (size_t pos = 0; pos < count; ++pos) {
+      for (char c : {'"', '\\', '\0', '\x1f'}) {
+        char saved = test[pos];
+        test[pos] = c;
+        const char* expected = pos < len ? test + pos : nullptr;
+        MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan8(test, '"', '\\', 0x20,
+                                                       len) == expected);
+        test[pos] = saved;
+      }
+    }
+  }
+}
+
+void TestGauntletAny2OrLessThan16() {
+  const size_t count = 64;
+  char16_t test[count];
+  for (size_t i = 0; i < count; ++i) {
+    test[i] = 0x4e00 + i;
+  }
+
+  for (size_t len = 0; len < count; ++len) {
+    for (size_t pos = 0; pos < count; ++pos) {
+      for (char16_t c : {u'"', u'\\', u'\0', u'\x1f'}) {
+        char16_t saved = test[pos];
+        test[pos] = c;
+        const char16_t* expected = pos < len ? test + pos : nullptr;
+        MOZ_RELEASE_ASSERT(SIMD::memchrAny2OrLessThan16(test, '"', '\\', 0x20,
+                                                        len) == expected);
+        test[pos] = saved;
+      }
+    }
+  }
+}
+
 void TestSpecialCases() {
   // The following 4 asserts test the case where we do two overlapping checks,
   // where the first one ends with our first search character, and the second
@@ -423,6 +528,9 @@ int main(void) {
   TestLongString16();
   TestGauntlet16();
 
+  TestGauntletWide<uint32_t, SIMD::memchr32>();
+  TestGauntletWide<uint64_t, SIMD::memchr64>();
+
   TestTinyString2x8();
   TestShortString2x8();
   TestMediumString2x8();
@@ -433,6 +541,11 @@ int main(void) {
   TestMediumString2x16();
   TestLongString2x16();
 
+  TestAny2OrLessThan8();
+  TestAny2OrLessThan16();
+  TestGauntletAny2OrLessThan8();
+  TestGauntletAny2OrLessThan16();
+
   TestSpecialCases();
 
   // These are too slow to run all the time, but they should be run when making
@@ -4,6 +4,7 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <type_traits>
 #include <utility>
 
 #include "mozilla/IntegerRange.h"
@@ -28,6 +29,7 @@ struct mozilla::detail::VectorTesting {
   static void testErase();
   static void testShrinkStorageToFit();
   static void testAppend();
+  static void testGrowTriviallyCopyable();
 };
 
 void mozilla::detail::VectorTesting::testReserved() {
@@ -685,6 +687,35 @@ void mozilla::detail::VectorTesting::testAppend() {
   }
 }
 
+// Not IsPod, but trivially copyable, so growth relocates with realloc.
+struct TriviallyCopyable {
+  TriviallyCopyable() : mA(-1), mB(-1) {}
+  TriviallyCopyable(int aA, int aB) : mA(aA), mB(aB) {}
+  int mA;
+  int mB;
+};
+
+static_assert(!mozilla::IsPod<TriviallyCopyable>::value);
+static_assert(std::is_trivially_copyable_v<TriviallyCopyable>);
+
+void mozilla::detail::VectorTesting::testGrowTriviallyCopyable() {
+  Vector<TriviallyCopyable, 2> v;
+  for (const int val : IntegerRange<int>(0, 1000)) {
+    MOZ_RELEASE_ASSERT(v.emplaceBack(val, -val));
+  }
+  MOZ_RELEASE_ASSERT(!v.usingInlineStorage());
+  MOZ_RELEASE_ASSERT(v.length() == 1000);
+  for (const int val : IntegerRange<int>(0, 1000)) {
+    MOZ_RELEASE_ASSERT(v[val].mA == val);
+    MOZ_RELEASE_ASSERT(v[val].mB == -val);
+  }
+
+  MOZ_RELEASE_ASSERT(v.resize(2000));
+  MOZ_RELEASE_ASSERT(v[999].mA == 999);
+  MOZ_RELEASE_ASSERT(v[1000].mA == -1);
+  MOZ_RELEASE_ASSERT(v[1999].mB == -1);
+}
+
 // Declare but leave (permanently) incomplete.
 struct Incomplete;
 
@@ -801,5 +832,6 @@ int main() {
   VectorTesting::testErase();
   VectorTesting::testShrinkStorageToFit();
   VectorTesting::testAppend();
+  VectorTesting::testGrowTriviallyCopyable();
   TestVectorBeginNonNull();
 }
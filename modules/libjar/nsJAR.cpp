@@ -321,7 +321,8 @@ nsJAR::GetInputStreamWithSpec(const nsACString& aJarDirSpec,
     rv = jis->InitDirectory(this, aJarDirSpec, entry.get());
   } else {
     RefPtr<nsZipHandle> fd = mZip->GetFD();
-    rv = jis->InitFile(fd, mZip->GetData(item), item);
+    rv = jis->InitFile(fd, mZip->GetData(item), item,
+                       mZip->TakeInflated(item));
   }
   if (NS_FAILED(rv)) {
     NS_RELEASE(*result);
@@ -29,13 +29,26 @@ NS_IMPL_ISUPPORTS(nsJARInputStream, nsIInputStream)
  *--------------------------------------------------------*/
 
 nsresult nsJARInputStream::InitFile(nsZipHandle* aFd, const uint8_t* aData,
-                                    nsZipItem* aItem) {
+                                    nsZipItem* aItem,
+                                    mozilla::UniquePtr<uint8_t[]> aInflated) {
   nsresult rv = NS_OK;
   MOZ_ASSERT(aFd, "Argument may not be null");
   MOZ_ASSERT(aItem, "Argument may not be null");
 
   // Mark it as closed, in case something fails in initialisation
   mMode = MODE_CLOSED;
+  if (aInflated) {
+    MOZ_ASSERT(aItem->Compression() == DEFLATED);
+    // Already inflated (and CRC-checked), so it only needs copying out.
+    mFd = aFd;
+    mInflated = std::move(aInflated);
+    mMode = MODE_COPY;
+    mZs.next_in = mInflated.get();
+    mZs.avail_in = aItem->RealSize();
+    mOutSize = aItem->RealSize();
+    mZs.total_out = 0;
+    return NS_OK;
+  }
   //-- prepare for the compression type
   switch (aItem->Compression()) {
     case STORED:
@@ -246,6 +259,7 @@ nsJARInputStream::Close() {
   }
   mMode = MODE_CLOSED;
   mFd = nullptr;
+  mInflated = nullptr;
   return NS_OK;
 }
 
@@ -11,6 +11,7 @@
 #include "nsJAR.h"
 #include "nsTArray.h"
 #include "mozilla/Attributes.h"
+#include "mozilla/UniquePtr.h"
 
 /*-------------------------------------------------------------------------
  * Class nsJARInputStream declaration. This class defines the type of the
@@ -33,8 +34,10 @@ class nsJARInputStream final : public nsIInputStream {
   NS_DECL_THREADSAFE_ISUPPORTS
   NS_DECL_NSIINPUTSTREAM
 
-  // takes ownership of |fd|, even on failure
-  nsresult InitFile(nsZipHandle* aFd, const uint8_t* aData, nsZipItem* item);
+  // takes ownership of |fd|, even on failure. |aInflated|, if given, holds
+  // the already inflated contents of a deflated item.
+  nsresult InitFile(nsZipHandle* aFd, const uint8_t* aData, nsZipItem* item,
+                    mozilla::UniquePtr<uint8_t[]> aInflated = nullptr);
 
   nsresult InitDirectory(nsJAR* aJar, const nsACString& aJarDirSpec,
                          const char* aDir);
@@ -47,6 +50,7 @@ class nsJARInputStream final : public nsIInputStream {
   uint32_t mInCrc;          // CRC as provided by the zipentry
   uint32_t mOutCrc;         // CRC as calculated by me
   z_stream mZs;             // zip data structure
+  mozilla::UniquePtr<uint8_t[]> mInflated;  // inflated ahead of time, if any
 
   /* For directory reading */
   RefPtr<nsJAR> mJar;          // string reference to zipreader
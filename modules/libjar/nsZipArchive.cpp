@@ -15,14 +15,20 @@
 #include "mozilla/Attributes.h"
 #include "mozilla/Logging.h"
 #include "mozilla/MemUtils.h"
+#include "mozilla/Services.h"
 #include "mozilla/UniquePtrExtensions.h"
 #include "mozilla/StaticMutex.h"
+#include "mozilla/Unused.h"
 #include "stdlib.h"
 #include "nsDirectoryService.h"
+#include "nsIMemoryReporter.h"
+#include "nsIObserver.h"
+#include "nsIObserverService.h"
 #include "nsWildCard.h"
 #include "nsXULAppAPI.h"
 #include "nsZipArchive.h"
 #include "nsString.h"
+#include "nsThreadUtils.h"
 #include "prenv.h"
 #if defined(XP_WIN)
 #  include <windows.h>
@@ -30,6 +36,7 @@
 
 // For placement new used for arena allocations of zip file list
 #include <new>
+#include <algorithm>
 #define ZIP_ARENABLOCKSIZE (1 * 1024)
 
 #ifdef XP_UNIX
@@ -77,6 +84,8 @@ static LazyLogModule gZipLog("nsZipArchive");
 #define LOG_ENABLED() MOZ_LOG_TEST(gZipLog, mozilla::LogLevel::Debug)
 
 static const uint32_t kMaxNameLength = PATH_MAX; /* Maximum name length */
+// Upper bound on what PreinflateStartupItems keeps around for readers.
+static const uint32_t kMaxPreinflatedSize = 16 * 1024 * 1024;
 // For synthetic zip entries. Date/time corresponds to 1980-01-01 00:00.
 static const uint16_t kSyntheticTime = 0;
 static const uint16_t kSyntheticDate = (1 + (1 << 5) + (0 << 9));
@@ -621,8 +630,8 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd)
   if (XRE_IsParentProcess() && mFd->mLen > ZIPCENTRAL_SIZE &&
       xtolong(startp + centralOffset) == CENTRALSIG) {
     // Success means optimized jar layout from bug 559961 is in effect
-    uint32_t readaheadLength = xtolong(startp);
-    mozilla::PrefetchMemory(const_cast<uint8_t*>(startp), readaheadLength);
+    mReadaheadLength = std::min(xtolong(startp), mFd->mLen);
+    mozilla::PrefetchMemory(const_cast<uint8_t*>(startp), mReadaheadLength);
   } else {
     for (buf = endp - ZIPEND_SIZE; buf > startp; buf--) {
       if (xtolong(buf) == ENDSIG) {
@@ -680,6 +689,7 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd)
     item->central = central;
     item->nameLength = namelen;
     item->isSynthetic = false;
+    item->wasRead = false;
 
     // Add item to file table
 #ifdef DEBUG
@@ -757,6 +767,7 @@ nsresult nsZipArchive::BuildSynthetics() {
         diritem->central = item->central;
         diritem->nameLength = dirlen;
         diritem->isSynthetic = true;
+        diritem->wasRead = false;
 
         // add diritem to the file table
         diritem->next = mFiles[hash];
@@ -827,13 +838,223 @@ const uint8_t* nsZipArchive::GetData(nsZipItem* aItem) {
 //---------------------------------------------
 int64_t nsZipArchive::SizeOfMapping() { return mFd ? mFd->SizeOfMapping() : 0; }
 
+namespace {
+
+MOZ_DEFINE_MALLOC_SIZE_OF(PreinflatedMallocSizeOf)
+
+// Reports what PreinflateStartupItems inflated ahead of time, and frees
+// whatever readers haven't taken once startup is over.
+class PreinflatedItemsWatcher final : public nsIObserver,
+                                      public nsIMemoryReporter {
+ public:
+  NS_DECL_ISUPPORTS
+  NS_DECL_NSIOBSERVER
+  NS_DECL_NSIMEMORYREPORTER
+
+  explicit PreinflatedItemsWatcher(nsZipArchive* aZip) : mZip(aZip) {}
+
+  void Register() {
+    nsCOMPtr<nsIObserverService> os = mozilla::services::GetObserverService();
+    if (os) {
+      for (const char* topic : sTopics) {
+        os->AddObserver(this, topic, false);
+      }
+    }
+    RegisterStrongMemoryReporter(this);
+  }
+
+ private:
+  ~PreinflatedItemsWatcher() = default;
+
+  // Session restore finishing is the end of startup; memory pressure and
+  // shutdown come first in sessions that never get there.
+  static constexpr const char* sTopics[] = {"sessionstore-windows-restored",
+                                            "memory-pressure",
+                                            "xpcom-will-shutdown"};
+
+  RefPtr<nsZipArchive> mZip;
+};
+
+NS_IMPL_ISUPPORTS(PreinflatedItemsWatcher, nsIObserver, nsIMemoryReporter)
+
+NS_IMETHODIMP
+PreinflatedItemsWatcher::Observe(nsISupports* aSubject, const char* aTopic,
+                                 const char16_t* aData) {
+  mZip->DiscardPreinflated();
+
+  nsCOMPtr<nsIObserverService> os = mozilla::services::GetObserverService();
+  if (os) {
+    for (const char* topic : sTopics) {
+      os->RemoveObserver(this, topic);
+    }
+  }
+  UnregisterStrongMemoryReporter(this);
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+PreinflatedItemsWatcher::CollectReports(nsIHandleReportCallback* aHandleReport,
+                                        nsISupports* aData, bool aAnonymize) {
+  MOZ_COLLECT_REPORT(
+      "explicit/omnijar/preinflated", KIND_HEAP, UNITS_BYTES,
+      mZip->SizeOfPreinflated(PreinflatedMallocSizeOf),
+      "Memory used by omni.ja startup items that were inflated ahead of time "
+      "and haven't been read yet.");
+  return NS_OK;
+}
+
+}  // namespace
+
+//---------------------------------------------
+// nsZipArchive::PreinflateStartupItems
+//---------------------------------------------
+void nsZipArchive::PreinflateStartupItems() {
+  MOZ_ASSERT(NS_IsMainThread());
+  if (!mReadaheadLength) {
+    return;
+  }
+
+  nsTArray<nsZipItem*> items;
+  {
+    MutexAutoLock lock(mLock);
+    if (mPreinflating) {
+      return;
+    }
+    MMAP_FAULT_HANDLER_BEGIN_HANDLE(mFd)
+    uint32_t total = 0;
+    for (nsZipItem* bucket : mFiles) {
+      for (nsZipItem* item = bucket; item; item = item->next) {
+        // Items read before we got here don't need inflating again.
+        if (item->isSynthetic || item->wasRead ||
+            item->Compression() != DEFLATED ||
+            item->LocalOffset() >= mReadaheadLength ||
+            item->RealSize() > kMaxPreinflatedSize - total) {
+          continue;
+        }
+        total += item->RealSize();
+        items.AppendElement(item);
+      }
+    }
+
+    // The readahead section is laid out in the order items were first read,
+    // so going through it in file order keeps ahead of the readers.
+    items.Sort([](nsZipItem* aA, nsZipItem* aB) {
+      return int(aA->LocalOffset() > aB->LocalOffset()) -
+             int(aA->LocalOffset() < aB->LocalOffset());
+    });
+    MMAP_FAULT_HANDLER_CATCH()
+    if (items.IsEmpty()) {
+      return;
+    }
+    mPreinflating = true;
+  }
+
+  nsresult rv = NS_DispatchBackgroundTask(NS_NewRunnableFunction(
+      "nsZipArchive::PreinflateStartupItems",
+      [self = RefPtr{this}, items = std::move(items)]() {
+        for (nsZipItem* item : items) {
+          {
+            MutexAutoLock lock(self->mLock);
+            if (!self->mPreinflating) {
+              return;
+            }
+            if (item->wasRead) {
+              continue;
+            }
+          }
+          uint32_t size = item->RealSize();
+          auto buf = MakeUniqueFallible<uint8_t[]>(size);
+          if (!buf) {
+            break;
+          }
+          uint32_t readlen = 0;
+          nsZipCursor cursor(item, self, buf.get(), size, /* doCRC */ true);
+          // Leave anything that fails for its reader to report.
+          if (!cursor.Read(&readlen) || readlen != size) {
+            continue;
+          }
+          MutexAutoLock lock(self->mLock);
+          if (!self->mPreinflating) {
+            return;
+          }
+          // A reader that got there while we were inflating did it itself.
+          if (!item->wasRead) {
+            self->mInflated.InsertOrUpdate(item, std::move(buf));
+          }
+        }
+        MutexAutoLock lock(self->mLock);
+        self->mPreinflating = false;
+      }));
+  if (NS_FAILED(rv)) {
+    MutexAutoLock lock(mLock);
+    mPreinflating = false;
+    return;
+  }
+
+  MakeRefPtr<PreinflatedItemsWatcher>(this)->Register();
+}
+
+//---------------------------------------------
+// nsZipArchive::TakeInflated
+//---------------------------------------------
+UniquePtr<uint8_t[]> nsZipArchive::TakeInflated(nsZipItem* aItem) {
+  MutexAutoLock lock(mLock);
+  aItem->wasRead = true;
+  if (mInflated.IsEmpty()) {
+    return nullptr;
+  }
+  Maybe<UniquePtr<uint8_t[]>> inflated = mInflated.Extract(aItem);
+  if (!inflated) {
+    return nullptr;
+  }
+  return std::move(*inflated);
+}
+
+//---------------------------------------------
+// nsZipArchive::DiscardPreinflated
+//---------------------------------------------
+void nsZipArchive::DiscardPreinflated() {
+  nsTHashMap<nsPtrHashKey<nsZipItem>, UniquePtr<uint8_t[]>> inflated;
+  {
+    MutexAutoLock lock(mLock);
+    mPreinflating = false;
+    inflated = std::move(mInflated);
+  }
+  // The buffers are freed here, outside the lock.
+}
+
+//---------------------------------------------
+// nsZipArchive::IsPreinflating
+//---------------------------------------------
+bool nsZipArchive::IsPreinflating() {
+  MutexAutoLock lock(mLock);
+  return mPreinflating;
+}
+
+//---------------------------------------------
+// nsZipArchive::SizeOfPreinflated
+//---------------------------------------------
+size_t nsZipArchive::SizeOfPreinflated(MallocSizeOf aMallocSizeOf) {
+  MutexAutoLock lock(mLock);
+  size_t n = mInflated.ShallowSizeOfExcludingThis(aMallocSizeOf);
+  for (const auto& buf : mInflated.Values()) {
+    n += aMallocSizeOf(buf.get());
+  }
+  return n;
+}
+
 //------------------------------------------
 // nsZipArchive constructor and destructor
 //------------------------------------------
 
 nsZipArchive::nsZipArchive(nsZipHandle* aZipHandle, PRFileDesc* aFd,
                            nsresult& aRv)
-    : mRefCnt(0), mFd(aZipHandle), mUseZipLog(false), mBuiltSynthetics(false) {
+    : mRefCnt(0),
+      mFd(aZipHandle),
+      mUseZipLog(false),
+      mReadaheadLength(0),
+      mBuiltSynthetics(false),
+      mPreinflating(false) {
   // initialize the table to nullptr
   memset(mFiles, 0, sizeof(mFiles));
 
@@ -997,7 +1218,11 @@ static PRTime GetModTime(uint16_t aDate, uint16_t aTime) {
 }
 
 nsZipItem::nsZipItem()
-    : next(nullptr), central(nullptr), nameLength(0), isSynthetic(false) {}
+    : next(nullptr),
+      central(nullptr),
+      nameLength(0),
+      isSynthetic(false),
+      wasRead(false) {}
 
 uint32_t nsZipItem::LocalOffset() { return xtolong(central->localhdr_offset); }
 
@@ -1161,6 +1386,13 @@ nsZipItemPtr_base::nsZipItemPtr_base(nsZipArchive* aZip, const char* aEntryName,
   uint32_t size = 0;
   bool compressed = (item->Compression() == DEFLATED);
   if (compressed) {
+    mAutoBuf = aZip->TakeInflated(item);
+    if (mAutoBuf) {
+      mReturnBuf = mAutoBuf.get();
+      mReadlen = item->RealSize();
+      return;
+    }
+
     size = item->RealSize();
     mAutoBuf = MakeUniqueFallible<uint8_t[]>(size);
     if (!mAutoBuf) {
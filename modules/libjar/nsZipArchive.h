@@ -19,8 +19,10 @@
 #include "mozilla/ArenaAllocator.h"
 #include "mozilla/FileUtils.h"
 #include "mozilla/FileLocation.h"
+#include "mozilla/MemoryReporting.h"
 #include "mozilla/Mutex.h"
 #include "mozilla/UniquePtr.h"
+#include "nsTHashMap.h"
 
 class nsZipFind;
 struct PRFileDesc;
@@ -70,6 +72,9 @@ class nsZipItem final {
   const ZipCentral* central;
   uint16_t nameLength;
   bool isSynthetic;
+  // Whether a reader asked for the contents yet. Guarded by the archive's
+  // mLock; only kept up to date for deflated items, see TakeInflated().
+  bool wasRead;
 };
 
 class nsZipHandle;
@@ -176,6 +181,40 @@ class nsZipArchive final {
    */
   int64_t SizeOfMapping();
 
+  /**
+   * Inflates, on a background thread and in file order, the deflated items
+   * that the optimized jar layout put in the readahead section, i.e. the ones
+   * recorded as used during startup. Readers then take the inflated data with
+   * TakeInflated() rather than inflating it on their own thread. Does nothing
+   * if the archive doesn't have the optimized layout.
+   */
+  void PreinflateStartupItems();
+
+  /**
+   * Hands over the data PreinflateStartupItems() inflated for aItem, and
+   * records that aItem was read so that it isn't inflated ahead of time
+   * afterwards.
+   * @param   aItem       Pointer to nsZipItem
+   * returns null if aItem wasn't inflated ahead of time or was already taken.
+   */
+  mozilla::UniquePtr<uint8_t[]> TakeInflated(nsZipItem* aItem);
+
+  /**
+   * Stops PreinflateStartupItems() and frees whatever it inflated that
+   * hasn't been taken. Called once startup is over.
+   */
+  void DiscardPreinflated();
+
+  /**
+   * Whether PreinflateStartupItems() is still inflating items.
+   */
+  bool IsPreinflating();
+
+  /**
+   * Size of the data inflated ahead of time that hasn't been taken yet.
+   */
+  size_t SizeOfPreinflated(mozilla::MallocSizeOf aMallocSizeOf);
+
   /*
    * Refcounting
    */
@@ -198,6 +237,9 @@ class nsZipArchive final {
   // variable avoids grabbing zipLog's lock when not necessary.
   // Effectively const after constructor
   bool mUseZipLog;
+  // Length of the readahead section at the start of an archive with the
+  // optimized jar layout, 0 otherwise. Effectively const after constructor
+  uint32_t mReadaheadLength;
 
   mozilla::Mutex mLock{"nsZipArchive"};
   // all of the following members are guarded by mLock:
@@ -205,6 +247,11 @@ class nsZipArchive final {
   mozilla::ArenaAllocator<1024, sizeof(void*)> mArena GUARDED_BY(mLock);
   // Whether we synthesized the directory entries
   bool mBuiltSynthetics GUARDED_BY(mLock);
+  // Items inflated by PreinflateStartupItems that haven't been taken yet
+  nsTHashMap<nsPtrHashKey<nsZipItem>, mozilla::UniquePtr<uint8_t[]>> mInflated
+      GUARDED_BY(mLock);
+  // Whether the PreinflateStartupItems task is still running
+  bool mPreinflating GUARDED_BY(mLock);
 
  private:
   //--- private methods ---
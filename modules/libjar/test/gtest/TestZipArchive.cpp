@@ -0,0 +1,212 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gtest/gtest.h"
+
+#include "mozilla/RefPtr.h"
+#include "nsString.h"
+#include "nsTArray.h"
+#include "nsZipArchive.h"
+#include "prinrval.h"
+#include "prthread.h"
+#include "zlib.h"
+
+struct TestZipEntry {
+  const char* mName;
+  nsCString mContents;
+};
+
+static void Append16(nsTArray<uint8_t>& aBuf, uint16_t aValue) {
+  aBuf.AppendElement(uint8_t(aValue));
+  aBuf.AppendElement(uint8_t(aValue >> 8));
+}
+
+static void Append32(nsTArray<uint8_t>& aBuf, uint32_t aValue) {
+  Append16(aBuf, uint16_t(aValue));
+  Append16(aBuf, uint16_t(aValue >> 16));
+}
+
+static nsTArray<uint8_t> Deflate(const nsCString& aContents) {
+  z_stream zs{};
+  EXPECT_EQ(deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                         Z_DEFAULT_STRATEGY),
+            Z_OK);
+  nsTArray<uint8_t> out;
+  out.SetLength(deflateBound(&zs, aContents.Length()));
+  zs.next_in = (Bytef*)aContents.get();
+  zs.avail_in = aContents.Length();
+  zs.next_out = out.Elements();
+  zs.avail_out = out.Length();
+  EXPECT_EQ(deflate(&zs, Z_FINISH), Z_STREAM_END);
+  out.SetLength(zs.total_out);
+  deflateEnd(&zs);
+  return out;
+}
+
+// Builds an archive with the optimized jar layout: the length of the
+// readahead section, the central directory and then every entry, all of it
+// in the readahead section.
+static nsTArray<uint8_t> BuildOptimizedArchive(
+    const nsTArray<TestZipEntry>& aEntries) {
+  nsTArray<nsTArray<uint8_t>> deflated;
+  uint32_t centralSize = 0;
+  for (const auto& entry : aEntries) {
+    deflated.AppendElement(Deflate(entry.mContents));
+    centralSize += ZIPCENTRAL_SIZE + strlen(entry.mName);
+  }
+
+  nsTArray<uint8_t> central;
+  nsTArray<uint8_t> local;
+  uint32_t localStart = 4 + centralSize + ZIPEND_SIZE;
+  for (size_t i = 0; i < aEntries.Length(); i++) {
+    const auto& entry = aEntries[i];
+    uint16_t nameLength = strlen(entry.mName);
+    uint32_t crc = crc32(0, (const Bytef*)entry.mContents.get(),
+                         entry.mContents.Length());
+
+    Append32(central, CENTRALSIG);
+    Append16(central, 20);  // version made by
+    Append16(central, 20);  // version needed
+    Append16(central, 0);   // flags
+    Append16(central, DEFLATED);
+    Append16(central, 0);  // time
+    Append16(central, 0);  // date
+    Append32(central, crc);
+    Append32(central, deflated[i].Length());
+    Append32(central, entry.mContents.Length());
+    Append16(central, nameLength);
+    Append16(central, 0);  // extra field length
+    Append16(central, 0);  // comment length
+    Append16(central, 0);  // disk number
+    Append16(central, 0);  // internal attributes
+    Append32(central, 0);  // external attributes
+    Append32(central, localStart + local.Length());
+    central.AppendElements((const uint8_t*)entry.mName, nameLength);
+
+    Append32(local, LOCALSIG);
+    Append16(local, 20);  // version needed
+    Append16(local, 0);   // flags
+    Append16(local, DEFLATED);
+    Append16(local, 0);  // time
+    Append16(local, 0);  // date
+    Append32(local, crc);
+    Append32(local, deflated[i].Length());
+    Append32(local, entry.mContents.Length());
+    Append16(local, nameLength);
+    Append16(local, 0);  // extra field length
+    local.AppendElements((const uint8_t*)entry.mName, nameLength);
+    local.AppendElements(deflated[i]);
+  }
+
+  nsTArray<uint8_t> archive;
+  Append32(archive, localStart + local.Length());
+  archive.AppendElements(central);
+  Append32(archive, ENDSIG);
+  Append16(archive, 0);  // disk number
+  Append16(archive, 0);  // disk with the central directory
+  Append16(archive, aEntries.Length());
+  Append16(archive, aEntries.Length());
+  Append32(archive, centralSize);
+  Append32(archive, 4);  // offset of the central directory
+  Append16(archive, 0);  // comment length
+  archive.AppendElements(local);
+  return archive;
+}
+
+static already_AddRefed<nsZipArchive> OpenArchive(
+    const nsTArray<uint8_t>& aData) {
+  RefPtr<nsZipHandle> handle;
+  EXPECT_TRUE(NS_SUCCEEDED(nsZipHandle::Init(aData.Elements(), aData.Length(),
+                                             getter_AddRefs(handle))));
+  return nsZipArchive::OpenArchive(handle);
+}
+
+static void WaitForPreinflation(nsZipArchive* aZip) {
+  while (aZip->IsPreinflating()) {
+    PR_Sleep(PR_MillisecondsToInterval(1));
+  }
+}
+
+static void ExpectContents(nsZipArchive* aZip, const TestZipEntry& aEntry) {
+  nsZipItemPtr<char> item(aZip, aEntry.mName, /* doCRC */ true);
+  ASSERT_TRUE(item.Buffer());
+  EXPECT_TRUE(nsDependentCSubstring(item.Buffer(), item.Length())
+                  .Equals(aEntry.mContents));
+}
+
+static nsTArray<TestZipEntry> MakeEntries() {
+  nsTArray<TestZipEntry> entries;
+  nsCString big;
+  for (int i = 0; i < 4096; i++) {
+    big.AppendPrintf("line %d of the startup item\n", i);
+  }
+  entries.AppendElement(TestZipEntry{"big.js", big});
+  entries.AppendElement(TestZipEntry{"small.js", "let small = true;\n"_ns});
+  return entries;
+}
+
+TEST(ZipArchive, PreinflateStartupItems)
+{
+  nsTArray<TestZipEntry> entries = MakeEntries();
+  nsTArray<uint8_t> data = BuildOptimizedArchive(entries);
+  RefPtr<nsZipArchive> zip = OpenArchive(data);
+  ASSERT_TRUE(zip);
+
+  zip->PreinflateStartupItems();
+  WaitForPreinflation(zip);
+  EXPECT_GE(zip->SizeOfPreinflated(moz_malloc_size_of),
+            entries[0].mContents.Length() + entries[1].mContents.Length());
+
+  for (const auto& entry : entries) {
+    ExpectContents(zip, entry);
+  }
+  EXPECT_LT(zip->SizeOfPreinflated(moz_malloc_size_of),
+            entries[0].mContents.Length());
+
+  // Reading them again inflates them on the spot.
+  for (const auto& entry : entries) {
+    ExpectContents(zip, entry);
+  }
+}
+
+TEST(ZipArchive, PreinflateSkipsItemsAlreadyRead)
+{
+  nsTArray<TestZipEntry> entries = MakeEntries();
+  nsTArray<uint8_t> data = BuildOptimizedArchive(entries);
+  RefPtr<nsZipArchive> zip = OpenArchive(data);
+  ASSERT_TRUE(zip);
+
+  ExpectContents(zip, entries[0]);
+
+  zip->PreinflateStartupItems();
+  WaitForPreinflation(zip);
+  size_t size = zip->SizeOfPreinflated(moz_malloc_size_of);
+  EXPECT_GE(size, entries[1].mContents.Length());
+  EXPECT_LT(size, entries[0].mContents.Length());
+
+  for (const auto& entry : entries) {
+    ExpectContents(zip, entry);
+  }
+}
+
+TEST(ZipArchive, DiscardPreinflated)
+{
+  nsTArray<TestZipEntry> entries = MakeEntries();
+  nsTArray<uint8_t> data = BuildOptimizedArchive(entries);
+  RefPtr<nsZipArchive> zip = OpenArchive(data);
+  ASSERT_TRUE(zip);
+
+  zip->PreinflateStartupItems();
+  WaitForPreinflation(zip);
+  zip->DiscardPreinflated();
+  EXPECT_LT(zip->SizeOfPreinflated(moz_malloc_size_of),
+            entries[0].mContents.Length());
+
+  // Whatever was discarded is inflated by the reader instead.
+  for (const auto& entry : entries) {
+    ExpectContents(zip, entry);
+  }
+}
@@ -1024,6 +1024,15 @@ pref("javascript.options.mem.gc_incremental_slice_ms", 5);
 // JSGC_COMPACTING_ENABLED
 pref("javascript.options.mem.gc_compacting", true);
 
+// JSGC_COMPACTING_FRAGMENTATION_THRESHOLD
+pref("javascript.options.mem.gc_compacting_fragmentation_threshold", 0);
+
+// JSGC_PARALLEL_MINOR_GC_ENABLED
+pref("javascript.options.mem.gc_parallel_minor", false);
+
+// JSGC_BACKGROUND_MARKING_ENABLED
+pref("javascript.options.mem.gc_background_marking", true);
+
 // JSGC_HIGH_FREQUENCY_TIME_LIMIT
 pref("javascript.options.mem.gc_high_frequency_time_limit_ms", 1000);
 
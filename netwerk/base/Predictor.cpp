@@ -30,6 +30,7 @@
 #include "nsServiceManagerUtils.h"
 #include "nsStreamUtils.h"
 #include "nsString.h"
+#include "nsTHashSet.h"
 #include "nsThreadUtils.h"
 #include "mozilla/Logging.h"
 
@@ -1152,10 +1153,24 @@ bool Predictor::RunPredictions(nsIURI* referrer,
     }
   }
 
+  // Predictions are learned per subresource, so one origin usually shows up
+  // many times. A speculative connect resolves the host as well, so only the
+  // first preconnect to an origin and the first preresolve of a host that is
+  // not being connected to are worth issuing.
+  nsTHashSet<nsCString> connectedOrigins, resolvedHosts;
+
   len = preconnects.Length();
   for (i = 0; i < len; ++i) {
-    PREDICTOR_LOG(("    doing preconnect"));
     nsCOMPtr<nsIURI> uri = preconnects[i];
+    nsAutoCString origin, hostname;
+    uri->GetPrePath(origin);
+    uri->GetAsciiHost(hostname);
+    resolvedHosts.Insert(hostname);
+    if (!connectedOrigins.EnsureInserted(origin)) {
+      PREDICTOR_LOG(("    skipping duplicate preconnect %s", origin.get()));
+      continue;
+    }
+    PREDICTOR_LOG(("    doing preconnect"));
     ++totalPredictions;
     ++totalPreconnects;
     nsCOMPtr<nsIPrincipal> principal =
@@ -1171,10 +1186,14 @@ bool Predictor::RunPredictions(nsIURI* referrer,
   len = preresolves.Length();
   for (i = 0; i < len; ++i) {
     nsCOMPtr<nsIURI> uri = preresolves[i];
-    ++totalPredictions;
-    ++totalPreresolves;
     nsAutoCString hostname;
     uri->GetAsciiHost(hostname);
+    if (!resolvedHosts.EnsureInserted(hostname)) {
+      PREDICTOR_LOG(("    skipping duplicate preresolve %s", hostname.get()));
+      continue;
+    }
+    ++totalPredictions;
+    ++totalPreresolves;
     PREDICTOR_LOG(("    doing preresolve %s", hostname.get()));
     nsCOMPtr<nsICancelable> tmpCancelable;
     mDnsService->AsyncResolveNative(
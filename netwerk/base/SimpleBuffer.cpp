@@ -42,6 +42,40 @@ nsresult SimpleBuffer::Write(char* src, size_t len) {
   return NS_OK;
 }
 
+nsresult SimpleBuffer::GetWriteSegment(char** dest, size_t* maxLen) {
+  NS_ASSERT_OWNINGTHREAD(SimpleBuffer);
+  if (NS_FAILED(mStatus)) {
+    return mStatus;
+  }
+
+  SimpleBufferPage* p = mBufferList.getLast();
+  if (!p || (p->mWriteOffset == SimpleBufferPage::kSimpleBufferPageSize)) {
+    p = new (fallible) SimpleBufferPage();
+    if (!p) {
+      mStatus = NS_ERROR_OUT_OF_MEMORY;
+      return mStatus;
+    }
+    mBufferList.insertBack(p);
+  }
+
+  *dest = p->mBuffer + p->mWriteOffset;
+  *maxLen = SimpleBufferPage::kSimpleBufferPageSize - p->mWriteOffset;
+  return NS_OK;
+}
+
+void SimpleBuffer::CommitWrite(size_t len) {
+  NS_ASSERT_OWNINGTHREAD(SimpleBuffer);
+  if (!len) {
+    return;
+  }
+
+  SimpleBufferPage* p = mBufferList.getLast();
+  MOZ_RELEASE_ASSERT(p && (len <= SimpleBufferPage::kSimpleBufferPageSize -
+                                      p->mWriteOffset));
+  p->mWriteOffset += len;
+  mAvailable += len;
+}
+
 size_t SimpleBuffer::Read(char* dest, size_t maxLen) {
   NS_ASSERT_OWNINGTHREAD(SimpleBuffer);
   if (NS_FAILED(mStatus)) {
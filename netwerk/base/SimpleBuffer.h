@@ -38,6 +38,11 @@ class SimpleBuffer {
 
   nsresult Write(char* src, size_t len);   // return OK or OUT_OF_MEMORY
   size_t Read(char* dest, size_t maxLen);  // return bytes read
+  // Like Write(), but lets the caller fill free space at the end of the
+  // buffer directly. The bytes written there are added by CommitWrite().
+  nsresult GetWriteSegment(char** dest,
+                           size_t* maxLen);  // return OK or OUT_OF_MEMORY
+  void CommitWrite(size_t len);
   size_t Available();
   void Clear();
 
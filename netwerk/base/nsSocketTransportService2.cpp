@@ -612,30 +612,9 @@ void nsSocketTransportService::ApplyPortRemapPreference(
   }
 }
 
-PRIntervalTime nsSocketTransportService::PollTimeout(PRIntervalTime now) {
-  if (mActiveCount == 0) {
-    return NS_SOCKET_POLL_TIMEOUT;
-  }
-
-  // compute minimum time before any socket timeout expires.
-  PRIntervalTime minR = NS_SOCKET_POLL_TIMEOUT;
-  for (uint32_t i = 0; i < mActiveCount; ++i) {
-    const SocketContext& s = mActiveList[i];
-    PRIntervalTime r = s.TimeoutIn(now);
-    if (r < minR) {
-      minR = r;
-    }
-  }
-  if (minR == NS_SOCKET_POLL_TIMEOUT) {
-    SOCKET_LOG(("poll timeout: none\n"));
-    return NS_SOCKET_POLL_TIMEOUT;
-  }
-  SOCKET_LOG(("poll timeout: %" PRIu32 "\n", PR_IntervalToSeconds(minR)));
-  return minR;
-}
-
 int32_t nsSocketTransportService::Poll(TimeDuration* pollDuration,
-                                       PRIntervalTime ts) {
+                                       PRIntervalTime ts,
+                                       PRIntervalTime socketTimeout) {
   MOZ_ASSERT(IsOnCurrentThread());
   PRPollDesc* pollList;
   uint32_t pollCount;
@@ -651,7 +630,7 @@ int32_t nsSocketTransportService::Poll(TimeDuration* pollDuration,
     mPollList[0].out_flags = 0;
     pollList = mPollList;
     pollCount = mActiveCount + 1;
-    pollTimeout = pendingEvents ? PR_INTERVAL_NO_WAIT : PollTimeout(ts);
+    pollTimeout = pendingEvents ? PR_INTERVAL_NO_WAIT : socketTimeout;
   } else {
     // no pollable event, so busy wait...
     pollCount = mActiveCount;
@@ -1312,6 +1291,11 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
   // should become active.  take care to check only idle sockets that
   // were idle to begin with ;-)
   //
+  // the minimum time before any active socket times out is collected along
+  // the way, so that computing the poll timeout doesn't take another pass
+  // over the active list.
+  //
+  PRIntervalTime socketTimeout = NS_SOCKET_POLL_TIMEOUT;
   count = mIdleCount;
   for (i = mActiveCount - 1; i >= 0; --i) {
     //---
@@ -1332,6 +1316,7 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
         mPollList[i + 1].in_flags = in_flags;
         mPollList[i + 1].out_flags = 0;
         mActiveList[i].EnsureTimeout(now);
+        socketTimeout = std::min(socketTimeout, mActiveList[i].TimeoutIn(now));
       }
     }
   }
@@ -1346,7 +1331,13 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
     if (NS_FAILED(mIdleList[i].mHandler->mCondition)) {
       DetachSocket(mIdleList, &mIdleList[i]);
     } else if (mIdleList[i].mHandler->mPollFlags != 0) {
+      // the timeout of the socket starts when it's added to the poll list.
+      uint16_t pollTimeout = mIdleList[i].mHandler->mPollTimeout;
       MoveToPollList(&mIdleList[i]);
+      if (pollTimeout != UINT16_MAX) {
+        socketTimeout =
+            std::min(socketTimeout, PR_SecondsToInterval(pollTimeout));
+      }
     }
   }
 
@@ -1383,7 +1374,7 @@ nsresult nsSocketTransportService::DoPollIteration(TimeDuration* pollDuration) {
 #if defined(XP_WIN)
     StartPolling();
 #endif
-    n = Poll(pollDuration, now);
+    n = Poll(pollDuration, now, socketTimeout);
 #if defined(XP_WIN)
     EndPolling();
 #endif
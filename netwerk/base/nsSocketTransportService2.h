@@ -249,11 +249,10 @@ class nsSocketTransportService final : public nsPISocketTransportService,
 
   PRPollDesc* mPollList; /* mListSize + 1 entries */
 
-  PRIntervalTime PollTimeout(
-      PRIntervalTime now);  // computes ideal poll timeout
   nsresult DoPollIteration(TimeDuration* pollDuration);
   // perfoms a single poll iteration
-  int32_t Poll(TimeDuration* pollDuration, PRIntervalTime ts);
+  int32_t Poll(TimeDuration* pollDuration, PRIntervalTime ts,
+               PRIntervalTime socketTimeout);
   // calls PR_Poll.  the out param
   // interval indicates the poll
   // duration in seconds.
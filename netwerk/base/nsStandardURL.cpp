@@ -2369,6 +2369,14 @@ nsresult nsStandardURL::EqualsInternal(
     return NS_OK;
   }
 
+  // Specs are always normalized, so identical specs mean identical URIs.
+  // This is by far the most common case for equal URIs and avoids comparing
+  // every segment separately.
+  if (mSpec == other->mSpec) {
+    *result = true;
+    return NS_OK;
+  }
+
   // Next check parts of a URI that, if different, automatically make the
   // URIs different
   if (!SegmentIs(mScheme, other->mSpec.get(), other->mScheme) ||
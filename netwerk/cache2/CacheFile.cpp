@@ -1474,16 +1474,41 @@ nsresult CacheFile::GetChunkLocked(uint32_t aIndex, ECallerType aCaller,
     mChunks.InsertOrUpdate(aIndex, RefPtr{chunk});
     chunk->mActiveChunk = true;
 
+    uint32_t len = std::min(static_cast<uint32_t>(mDataSize - off),
+                            static_cast<uint32_t>(kChunkSize));
+
+    // The data of small entries is read together with the metadata.
+    if (aIndex == 0) {
+      uint32_t prereadSize;
+      UniquePtr<char[]> prereadData =
+          mMetadata->TakePrereadData(&prereadSize);
+      if (prereadData && prereadSize == len &&
+          NS_SUCCEEDED(chunk->InitFromPrereadData(
+              prereadData.get(), len, mMetadata->GetHash(aIndex)))) {
+        LOG(
+            ("CacheFile::GetChunkLocked() - Initialized newly created chunk %p "
+             "from preread data [this=%p]",
+             chunk.get(), this));
+
+        if (aCaller != PRELOADER) {
+          chunk.swap(*_retval);
+        }
+
+        if (preload) {
+          PreloadChunks(aIndex + 1);
+        }
+
+        return NS_OK;
+      }
+    }
+
     LOG(
         ("CacheFile::GetChunkLocked() - Reading newly created chunk %p from "
          "the disk [this=%p]",
          chunk.get(), this));
 
     // Read the chunk from the disk
-    rv = chunk->Read(mHandle,
-                     std::min(static_cast<uint32_t>(mDataSize - off),
-                              static_cast<uint32_t>(kChunkSize)),
-                     mMetadata->GetHash(aIndex), this);
+    rv = chunk->Read(mHandle, len, mMetadata->GetHash(aIndex), this);
     if (NS_WARN_IF(NS_FAILED(rv))) {
       RemoveChunkInternal(chunk, false);
       return rv;
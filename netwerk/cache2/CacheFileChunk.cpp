@@ -330,6 +330,42 @@ void CacheFileChunk::InitNew() {
   mState = READY;
 }
 
+// Initializes the chunk with data that was already read from the disk, see
+// CacheFileMetadata::TakePrereadData().
+nsresult CacheFileChunk::InitFromPrereadData(const char* aBuf, uint32_t aLen,
+                                             CacheHash::Hash16_t aHash) {
+  AssertOwnsLock();
+
+  LOG(("CacheFileChunk::InitFromPrereadData() [this=%p, len=%d]", this, aLen));
+
+  MOZ_ASSERT(mState == INITIAL);
+  MOZ_ASSERT(NS_SUCCEEDED(mStatus));
+  MOZ_ASSERT(!mBuf->Buf());
+  MOZ_ASSERT(!mWritingStateHandle);
+  MOZ_ASSERT(!mReadingStateBuf);
+  MOZ_ASSERT(aLen);
+
+  CacheHash::Hash16_t hash = CacheHash::Hash16(aBuf, aLen);
+  if (hash != aHash) {
+    LOG(
+        ("CacheFileChunk::InitFromPrereadData() - Hash mismatch! Hash of the "
+         "data is %hx, hash in metadata is %hx. [this=%p, idx=%d]",
+         hash, aHash, this, mIndex));
+    return NS_ERROR_FILE_CORRUPTED;
+  }
+
+  nsresult rv = mBuf->EnsureBufSize(aLen);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+
+  memcpy(mBuf->Buf(), aBuf, aLen);
+  mBuf->SetDataSize(aLen);
+  mState = READY;
+
+  return NS_OK;
+}
+
 nsresult CacheFileChunk::Read(CacheFileHandle* aHandle, uint32_t aLen,
                               CacheHash::Hash16_t aHash,
                               CacheFileChunkListener* aCallback) {
@@ -136,6 +136,8 @@ class CacheFileChunk final : public CacheFileIOListener,
   CacheFileChunk(CacheFile* aFile, uint32_t aIndex, bool aInitByWriter);
 
   void InitNew();
+  nsresult InitFromPrereadData(const char* aBuf, uint32_t aLen,
+                               CacheHash::Hash16_t aHash);
   nsresult Read(CacheFileHandle* aHandle, uint32_t aLen,
                 CacheHash::Hash16_t aHash, CacheFileChunkListener* aCallback);
   nsresult Write(CacheFileHandle* aHandle, CacheFileChunkListener* aCallback);
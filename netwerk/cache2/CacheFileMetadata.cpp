@@ -15,6 +15,7 @@
 #include "../cache/nsCacheUtils.h"
 #include "nsIFile.h"
 #include "mozilla/ScopeExit.h"
+#include "mozilla/UniquePtrExtensions.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/IntegerPrintfMacros.h"
@@ -24,6 +25,8 @@ namespace mozilla::net {
 
 #define kMinMetadataRead 1024  // TODO find optimal value from telemetry
 #define kAlignSize 4096
+// Entries up to this size are read whole, see TakePrereadData().
+#define kMaxPrereadEntrySize (16 * 1024)
 
 // Most of the cache entries fit into one chunk due to current chunk size. Make
 // sure to tweak this value if kChunkSize is going to change.
@@ -166,9 +169,10 @@ void CacheFileMetadata::ReadMetadata(CacheFileMetadataListener* aListener) {
   }
 
   // Set offset so that we read at least kMinMetadataRead if the file is big
-  // enough.
+  // enough. Small entries are read whole, so their data can be handed to the
+  // first chunk without reading it again.
   int64_t offset;
-  if (size < kMinMetadataRead) {
+  if (size < kMinMetadataRead || size <= kMaxPrereadEntrySize) {
     offset = 0;
   } else {
     offset = size - kMinMetadataRead;
@@ -728,6 +732,17 @@ nsresult CacheFileMetadata::OnDataRead(CacheFileHandle* aHandle, char* aBuf,
   Telemetry::Accumulate(Telemetry::NETWORK_CACHE_METADATA_SIZE_2,
                         size - realOffset);
 
+  // If the whole entry was read and the data fits into a single chunk, keep
+  // the data before the buffer is reused for the elements.
+  UniquePtr<char[]> prereadData;
+  if (usedOffset == 0 && realOffset > 0 &&
+      realOffset <= static_cast<uint32_t>(kChunkSize)) {
+    prereadData = MakeUniqueFallible<char[]>(realOffset);
+    if (prereadData) {
+      memcpy(prereadData.get(), mBuf, realOffset);
+    }
+  }
+
   // We have all data according to offset information at the end of the entry.
   // Try to parse it.
   rv = ParseMetadata(realOffset, realOffset - usedOffset, true);
@@ -742,6 +757,12 @@ nsresult CacheFileMetadata::OnDataRead(CacheFileHandle* aHandle, char* aBuf,
     mBuf = static_cast<char*>(moz_xrealloc(mBuf, mElementsSize));
     mBufSize = mElementsSize;
 
+    if (prereadData) {
+      mPrereadData = std::move(prereadData);
+      mPrereadDataSize = realOffset;
+    }
+    DoMemoryReport(MemoryUsage());
+
     // There is usually no or just one call to SetMetadataElement() when the
     // metadata is parsed from disk. Avoid allocating power of two sized buffer
     // which we do in case of newly created metadata.
@@ -777,6 +798,8 @@ void CacheFileMetadata::InitEmptyMetadata() {
     mBuf = nullptr;
     mBufSize = 0;
   }
+  mPrereadData = nullptr;
+  mPrereadDataSize = 0;
   mAllocExactSize = false;
   mOffset = 0;
   mMetaHdr.mVersion = kCacheEntryVersion;
@@ -1020,6 +1043,17 @@ nsresult CacheFileMetadata::ParseKey(const nsACString& aKey) {
 
 // Memory reporting
 
+UniquePtr<char[]> CacheFileMetadata::TakePrereadData(uint32_t* aSize) {
+  *aSize = mPrereadDataSize;
+  if (!mPrereadData) {
+    return nullptr;
+  }
+
+  mPrereadDataSize = 0;
+  DoMemoryReport(MemoryUsage());
+  return std::move(mPrereadData);
+}
+
 size_t CacheFileMetadata::SizeOfExcludingThis(
     mozilla::MallocSizeOf mallocSizeOf) const {
   size_t n = 0;
@@ -1027,6 +1061,7 @@ size_t CacheFileMetadata::SizeOfExcludingThis(
   n += mKey.SizeOfExcludingThisIfUnshared(mallocSizeOf);
   n += mallocSizeOf(mHashArray);
   n += mallocSizeOf(mBuf);
+  n += mallocSizeOf(mPrereadData.get());
   // Ignore mWriteBuf, it's not safe to access it when metadata is being
   // written and it's null otherwise.
   // mListener is usually the owning CacheFile.
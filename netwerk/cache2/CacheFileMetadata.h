@@ -12,6 +12,7 @@
 #include "mozilla/EndianUtils.h"
 #include "mozilla/BasePrincipal.h"
 #include "mozilla/NotNull.h"
+#include "mozilla/UniquePtr.h"
 #include "nsString.h"
 
 class nsICacheEntryMetaDataVisitor;
@@ -188,9 +189,15 @@ class CacheFileMetadata final : public CacheFileIOListener,
   void MarkDirty(bool aUpdateLastModified = true);
   bool IsDirty() { return mIsDirty; }
   uint32_t MemoryUsage() {
-    return sizeof(CacheFileMetadata) + mHashArraySize + mBufSize;
+    return sizeof(CacheFileMetadata) + mHashArraySize + mBufSize +
+           mPrereadDataSize;
   }
 
+  // Small entries are read whole together with their metadata. This hands
+  // out the data part of such an entry, so that its only chunk doesn't need
+  // another read from the disk. Returns null if there is no such data.
+  UniquePtr<char[]> TakePrereadData(uint32_t* aSize);
+
   NS_IMETHOD OnFileOpened(CacheFileHandle* aHandle, nsresult aResult) override;
   NS_IMETHOD OnDataWritten(CacheFileHandle* aHandle, const char* aBuf,
                            nsresult aResult) override;
@@ -227,6 +234,8 @@ class CacheFileMetadata final : public CacheFileIOListener,
   char* mBuf{nullptr};
   uint32_t mBufSize{0};
   char* mWriteBuf{nullptr};
+  UniquePtr<char[]> mPrereadData;
+  uint32_t mPrereadDataSize{0};
   CacheFileMetadataHeader mMetaHdr{0};
   uint32_t mElementsSize{0};
   bool mIsDirty : 1;
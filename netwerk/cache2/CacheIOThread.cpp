@@ -16,6 +16,7 @@
 #include "mozilla/EventQueue.h"
 #include "mozilla/IOInterposer.h"
 #include "mozilla/ProfilerLabels.h"
+#include "mozilla/StaticPrefs_network.h"
 #include "mozilla/ThreadEventQueue.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/TelemetryHistogramEnums.h"
@@ -462,6 +463,18 @@ void CacheIOThread::ThreadFunc() {
           continue;
         }
 
+        if (level >= INDEX && !mShutdown) {
+          // Let a page load's opens and reads run back to back rather than
+          // having index updates and evictions squeezed in between them.
+          TimeDuration delay = BackgroundLevelDelay();
+          if (delay) {
+            AUTO_PROFILER_LABEL("CacheIOThread::ThreadFunc::BackgroundDelay",
+                                IDLE);
+            lock.Wait(delay);
+            goto loopStart;
+          }
+        }
+
         LoopOneLevel(level);
 
         // Go to the first (lowest) level again
@@ -546,6 +559,10 @@ void CacheIOThread::LoopOneLevel(uint32_t aLevel) {
     }
   }
 
+  if (aLevel <= READ) {
+    mLastForegroundRun = TimeStamp::Now();
+  }
+
   if (returnEvents) {
     // This code must prevent any AddRef/Release calls on the stored COMPtrs as
     // it might be exhaustive and block the monitor's lock for an excessive
@@ -568,6 +585,18 @@ bool CacheIOThread::EventsPending(uint32_t aLastLevel) {
   return mLowestLevelWaiting < aLastLevel || mHasXPCOMEvents;
 }
 
+TimeDuration CacheIOThread::BackgroundLevelDelay() {
+  uint32_t delayMs = StaticPrefs::network_cache_background_io_delay_ms();
+  if (!delayMs || mLastForegroundRun.IsNull()) {
+    return TimeDuration();
+  }
+
+  TimeDuration remaining = mLastForegroundRun +
+                           TimeDuration::FromMilliseconds(delayMs) -
+                           TimeStamp::Now();
+  return remaining > TimeDuration() ? remaining : TimeDuration();
+}
+
 NS_IMETHODIMP CacheIOThread::OnDispatchedEvent() {
   MonitorAutoLock lock(mMonitor);
   mHasXPCOMEvents = true;
@@ -12,6 +12,7 @@
 #include "mozilla/Monitor.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/Atomics.h"
+#include "mozilla/TimeStamp.h"
 #include "mozilla/UniquePtr.h"
 
 class nsIRunnable;
@@ -105,6 +106,7 @@ class CacheIOThread final : public nsIThreadObserver {
   void ThreadFunc();
   void LoopOneLevel(uint32_t aLevel);
   bool EventsPending(uint32_t aLastLevel = LAST_LEVEL);
+  TimeDuration BackgroundLevelDelay();
   nsresult DispatchInternal(already_AddRefed<nsIRunnable> aRunnable,
                             uint32_t aLevel);
   bool YieldInternal();
@@ -129,6 +131,8 @@ class CacheIOThread final : public nsIThreadObserver {
   Atomic<bool, Relaxed> mHasXPCOMEvents{false};
   // See YieldAndRerun() above
   bool mRerunCurrentEvent{false};  // Only accessed on the cache thread
+  // When events on the levels up to READ last ran, see BackgroundLevelDelay()
+  TimeStamp mLastForegroundRun;  // Only accessed on the cache thread
   // Signal to process all pending events and then shutdown
   // Synchronized by mMonitor
   bool mShutdown{false};
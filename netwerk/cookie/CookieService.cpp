@@ -128,6 +128,14 @@ namespace {
 
 void ComposeCookieString(nsTArray<Cookie*>& aCookieList,
                          nsACString& aCookieString) {
+  // Size the string up front; sites with many cookies would otherwise grow it
+  // several times per request.
+  size_t length = aCookieString.Length();
+  for (Cookie* cookie : aCookieList) {
+    length += cookie->Name().Length() + cookie->Value().Length() + 3;
+  }
+  Unused << aCookieString.SetCapacity(length, fallible);
+
   for (Cookie* cookie : aCookieList) {
     // check if we have anything to write
     if (!cookie->Name().IsEmpty() || !cookie->Value().IsEmpty()) {
@@ -1032,13 +1040,9 @@ void CookieService::GetCookiesForURI(
   //
   CookieProblem sameSiteProblems = CookieProblem::None;
 
-  // iterate the cookies!
+  // iterate the cookies! The cheap flag and expiry checks come before the
+  // string matching on host and path.
   for (Cookie* cookie : *cookies) {
-    // check the host, since the base domain lookup is conservative.
-    if (!CookieCommons::DomainMatches(cookie, hostFromURI)) {
-      continue;
-    }
-
     // if the cookie is secure and the host scheme isn't, we can't send it
     if (cookie->IsSecure() && !potentiallyTurstworthy) {
       continue;
@@ -1050,13 +1054,18 @@ void CookieService::GetCookiesForURI(
       continue;
     }
 
-    // if the nsIURI path doesn't match the cookie path, don't send it back
-    if (!CookieCommons::PathMatches(cookie, pathFromURI)) {
+    // check if the cookie has expired
+    if (cookie->Expiry() <= currentTime) {
       continue;
     }
 
-    // check if the cookie has expired
-    if (cookie->Expiry() <= currentTime) {
+    // check the host, since the base domain lookup is conservative.
+    if (!CookieCommons::DomainMatches(cookie, hostFromURI)) {
+      continue;
+    }
+
+    // if the nsIURI path doesn't match the cookie path, don't send it back
+    if (!CookieCommons::PathMatches(cookie, pathFromURI)) {
       continue;
     }
 
@@ -87,6 +87,44 @@ static already_AddRefed<Http2Stream> GetNextStreamFromQueue(
   return stream.forget();
 }
 
+// How many times the stream at the head of the write queue can be passed over
+// for a better priority one before it gets its turn anyway.
+static const uint32_t kMaxReadyForWriteHeadSkips = 8;
+
+// Like GetNextStreamFromQueue, but picks the stream with the best priority.
+// Streams of equal priority are taken in queue order, and a stream that
+// still has data after its turn is appended again, so they round-robin.
+// The head of the queue is the stream that has waited longest, and it is
+// taken regardless of priority once it has been passed over
+// kMaxReadyForWriteHeadSkips times in a row, so a steady flow of better
+// priority streams can't starve the others.
+static already_AddRefed<Http2Stream> GetNextStreamToWrite(
+    nsTArray<WeakPtr<Http2Stream>>& queue, uint32_t& aHeadSkips) {
+  if (!queue.IsEmpty() && !queue[0]) {
+    aHeadSkips = 0;
+  }
+  queue.RemoveElementsBy(
+      [](const WeakPtr<Http2Stream>& aStream) { return !aStream; });
+  if (queue.IsEmpty()) {
+    aHeadSkips = 0;
+    return nullptr;
+  }
+
+  size_t best = 0;
+  if (aHeadSkips < kMaxReadyForWriteHeadSkips) {
+    for (size_t i = 1; i < queue.Length(); ++i) {
+      if (queue[i]->Priority() < queue[best]->Priority()) {
+        best = i;
+      }
+    }
+  }
+  aHeadSkips = best ? aHeadSkips + 1 : 0;
+
+  RefPtr<Http2Stream> stream = queue[best].get();
+  queue.RemoveElementAt(best);
+  return stream.forget();
+}
+
 // "magic" refers to the string that preceeds HTTP/2 on the wire
 // to help find any intermediaries speaking an older version of HTTP
 const uint8_t Http2Session::kMagicHello[] = {
@@ -2781,7 +2819,8 @@ nsresult Http2Session::ReadSegmentsAgain(nsAHttpSegmentReader* reader,
 
   LOG3(("Http2Session::ReadSegments %p", this));
 
-  RefPtr<Http2Stream> stream = GetNextStreamFromQueue(mReadyForWrite);
+  RefPtr<Http2Stream> stream =
+      GetNextStreamToWrite(mReadyForWrite, mReadyForWriteHeadSkips);
 
   if (!stream) {
     LOG3(("Http2Session %p could not identify a stream to write; suspending.",
@@ -393,6 +393,9 @@ class Http2Session final : public ASpdySession,
       mStreamTransactionHash;
 
   nsTArray<WeakPtr<Http2Stream>> mReadyForWrite;
+  // How many times in a row the stream at the head of mReadyForWrite, the one
+  // that has waited longest, was passed over for a better priority one.
+  uint32_t mReadyForWriteHeadSkips = 0;
   nsTArray<WeakPtr<Http2Stream>> mQueuedStreams;
   nsTArray<WeakPtr<Http2Stream>> mPushesReadyForRead;
   nsTArray<WeakPtr<Http2Stream>> mSlowConsumersReadyForRead;
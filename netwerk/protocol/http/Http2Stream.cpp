@@ -291,21 +291,24 @@ uint64_t Http2Stream::LocalUnAcked() {
 }
 
 nsresult Http2Stream::BufferInput(uint32_t count, uint32_t* countWritten) {
-  char buf[SimpleBufferPage::kSimpleBufferPageSize];
-  if (SimpleBufferPage::kSimpleBufferPageSize < count) {
-    count = SimpleBufferPage::kSimpleBufferPageSize;
+  // Read the data straight into the buffer rather than copying it there.
+  char* buf;
+  size_t room;
+  nsresult rv = mSimpleBuffer.GetWriteSegment(&buf, &room);
+  if (NS_FAILED(rv)) {
+    MOZ_ASSERT(rv == NS_ERROR_OUT_OF_MEMORY);
+    return NS_ERROR_OUT_OF_MEMORY;
+  }
+  if (room < count) {
+    count = room;
   }
 
   mBypassInputBuffer = 1;
-  nsresult rv = mSegmentWriter->OnWriteSegment(buf, count, countWritten);
+  rv = mSegmentWriter->OnWriteSegment(buf, count, countWritten);
   mBypassInputBuffer = 0;
 
   if (NS_SUCCEEDED(rv)) {
-    rv = mSimpleBuffer.Write(buf, *countWritten);
-    if (NS_FAILED(rv)) {
-      MOZ_ASSERT(rv == NS_ERROR_OUT_OF_MEMORY);
-      return NS_ERROR_OUT_OF_MEMORY;
-    }
+    mSimpleBuffer.CommitWrite(*countWritten);
   }
   return rv;
 }
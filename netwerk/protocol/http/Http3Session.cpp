@@ -290,8 +290,10 @@ void Http3Session::ProcessInput(nsIUDPSocket* socket) {
   LOG(("Http3Session::ProcessInput writer=%p [this=%p state=%d]",
        mUdpConn.get(), this, mState));
 
+  // Reuse the buffer for all datagrams read in this call.
+  nsTArray<uint8_t> data;
   while (true) {
-    nsTArray<uint8_t> data;
+    data.ClearAndRetainStorage();
     NetAddr addr{};
     // RecvWithAddr actually does not return an error.
     nsresult rv = socket->RecvWithAddr(&addr, data);
@@ -614,10 +616,18 @@ nsresult Http3Session::ProcessOutput(nsIUDPSocket* socket) {
   LOG(("Http3Session::ProcessOutput reader=%p, [this=%p]", mUdpConn.get(),
        this));
 
+  // Reuse the packet buffer, and the parsed address as long as the packets
+  // go to the same peer, which is the usual case.
+  nsTArray<uint8_t> packetToSend;
+  nsAutoCString lastRemoteAddrStr;
+  uint16_t lastPort = 0;
+  bool haveAddr = false;
+  NetAddr addr;
+
   // Check if we have a packet that could not have been sent in a previous
   // iteration or maybe get new packets to send.
   while (true) {
-    nsTArray<uint8_t> packetToSend;
+    packetToSend.ClearAndRetainStorage();
     nsAutoCString remoteAddrStr;
     uint16_t port = 0;
     uint64_t timeout = 0;
@@ -634,9 +644,15 @@ nsresult Http3Session::ProcessOutput(nsIUDPSocket* socket) {
          PromiseFlatCString(remoteAddrStr).get(), port, this));
 
     uint32_t written = 0;
-    NetAddr addr;
-    if (NS_FAILED(StringAndPortToNetAddr(remoteAddrStr, port, &addr))) {
-      continue;
+    if (!haveAddr || port != lastPort ||
+        !remoteAddrStr.Equals(lastRemoteAddrStr)) {
+      haveAddr =
+          NS_SUCCEEDED(StringAndPortToNetAddr(remoteAddrStr, port, &addr));
+      if (!haveAddr) {
+        continue;
+      }
+      lastRemoteAddrStr = remoteAddrStr;
+      lastPort = port;
     }
     nsresult rv = socket->SendWithAddress(&addr, packetToSend, &written);
     LOG(("Http3Session::ProcessOutput sending packet rv=%d",
@@ -8,6 +8,7 @@
 #define nsHttp_h__
 
 #include <stdint.h>
+#include <type_traits>
 #include "prtime.h"
 #include "nsString.h"
 #include "nsError.h"
@@ -281,6 +282,14 @@ bool SendDataInChunks(const nsCString& aData, uint64_t aOffset, uint32_t aCount,
   static uint32_t const kCopyChunkSize = 128 * 1024;
   uint32_t toRead = std::min<uint32_t>(aCount, kCopyChunkSize);
 
+  if constexpr (std::is_same_v<T, nsCString>) {
+    // When everything fits in one chunk, send the string itself rather than a
+    // copy of it.
+    if (aCount && toRead == aCount && aCount == aData.Length()) {
+      return aSendFunc(aData, aOffset, aCount);
+    }
+  }
+
   uint32_t start = 0;
   while (aCount) {
     T data(Substring(aData, start, toRead));
@@ -371,6 +371,17 @@ nsresult nsHttpTransaction::Init(
       rv = mResolver->FetchHTTPSRRInternal(target, getter_AddRefs(dnsRequest));
       if (NS_SUCCEEDED(rv)) {
         mHTTPSSVCReceivedStage = HTTPSSVC_NOT_PRESENT;
+
+        // When we are going to wait for the HTTPS RR, resolve the addresses
+        // of the origin at the same time. The service mode record usually
+        // points back at the origin, so the connection then finds them in
+        // the cache instead of starting a second lookup.
+        if (mCaps & NS_HTTP_FORCE_WAIT_HTTP_RR) {
+          const nsCString& host = mConnInfo->GetRoutedHost().IsEmpty()
+                                      ? mConnInfo->GetOrigin()
+                                      : mConnInfo->GetRoutedHost();
+          mResolver->PrefetchAddrRecord(host, mCaps & NS_HTTP_REFRESH_DNS);
+        }
       }
 
       {
@@ -277,8 +277,8 @@ void WebSocketChannelChild::OnStop(const nsresult& aStatusCode) {
 
 class MessageEvent : public WebSocketEvent {
  public:
-  MessageEvent(const nsCString& aMessage, bool aBinary)
-      : mMessage(aMessage), mBinary(aBinary) {}
+  MessageEvent(nsCString&& aMessage, bool aBinary)
+      : mMessage(std::move(aMessage)), mBinary(aBinary) {}
 
   void Run(WebSocketChannelChild* aChild) override {
     if (!mBinary) {
@@ -303,8 +303,10 @@ bool WebSocketChannelChild::RecvOnMessageAvailableInternal(
     return false;
   }
 
+  // Hand the assembled message over to the event rather than sharing the
+  // buffer, so the target thread ends up as its sole owner.
   mEventQ->RunOrEnqueue(new EventTargetDispatcher(
-      this, new MessageEvent(mReceivedMsgBuffer, aBinary)));
+      this, new MessageEvent(std::move(mReceivedMsgBuffer), aBinary)));
   mReceivedMsgBuffer.Truncate();
   return true;
 }
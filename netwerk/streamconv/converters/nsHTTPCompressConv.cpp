@@ -20,6 +20,8 @@
 #include "nsIRequest.h"
 #include "mozilla/UniquePtrExtensions.h"
 
+#include <algorithm>
+
 // brotli headers
 #undef assert
 #include "assert.h"
@@ -33,6 +35,11 @@ extern LazyLogModule gHttpLog;
 #define LOG(args) \
   MOZ_LOG(mozilla::net::gHttpLog, mozilla::LogLevel::Debug, args)
 
+// Lower bound for the gzip/deflate output buffer. Sizing it only from the
+// input chunk leaves it a few KB for small network reads, so well compressed
+// text is inflated and handed to the listener in many tiny pieces.
+static const uint32_t kMinOutBufferLen = 64 * 1024;
+
 class BrotliWrapper {
  public:
   BrotliWrapper() {
@@ -307,8 +314,9 @@ nsHTTPCompressConv::OnDataAvailable(nsIRequest* request, nsIInputStream* iStr,
 
         if (mOutBufferLen < streamLen * 2) {
           unsigned char* originalOutBuffer = mOutBuffer;
-          if (!(mOutBuffer = (unsigned char*)realloc(
-                    mOutBuffer, mOutBufferLen = streamLen * 3))) {
+          mOutBufferLen = std::max(streamLen * 3, kMinOutBufferLen);
+          if (!(mOutBuffer =
+                    (unsigned char*)realloc(mOutBuffer, mOutBufferLen))) {
             free(originalOutBuffer);
           }
         }
@@ -323,7 +331,8 @@ nsHTTPCompressConv::OnDataAvailable(nsIRequest* request, nsIInputStream* iStr,
       }
 
       if (mOutBuffer == nullptr) {
-        mOutBuffer = (unsigned char*)malloc(mOutBufferLen = streamLen * 3);
+        mOutBufferLen = std::max(streamLen * 3, kMinOutBufferLen);
+        mOutBuffer = (unsigned char*)malloc(mOutBufferLen);
       }
 
       if (mInpBuffer == nullptr || mOutBuffer == nullptr) {
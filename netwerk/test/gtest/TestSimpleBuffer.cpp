@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+
+#include "SimpleBuffer.h"
+#include <string.h>
+
+using namespace mozilla::net;
+
+TEST(TestSimpleBuffer, WriteSegment)
+{
+  SimpleBuffer buffer;
+
+  char* dest;
+  size_t room;
+  ASSERT_EQ(buffer.GetWriteSegment(&dest, &room), NS_OK);
+  ASSERT_EQ(room, size_t(SimpleBufferPage::kSimpleBufferPageSize));
+
+  memcpy(dest, "hello", 5);
+  buffer.CommitWrite(5);
+  EXPECT_EQ(buffer.Available(), 5u);
+
+  // The next segment continues in the same page.
+  char* next;
+  ASSERT_EQ(buffer.GetWriteSegment(&next, &room), NS_OK);
+  EXPECT_EQ(next, dest + 5);
+  EXPECT_EQ(room, size_t(SimpleBufferPage::kSimpleBufferPageSize - 5));
+
+  // Fill the page; the following segment must start a new one.
+  memset(next, 'x', room);
+  buffer.CommitWrite(room);
+  ASSERT_EQ(buffer.GetWriteSegment(&next, &room), NS_OK);
+  EXPECT_EQ(room, size_t(SimpleBufferPage::kSimpleBufferPageSize));
+  memcpy(next, "!", 1);
+  buffer.CommitWrite(1);
+
+  EXPECT_EQ(buffer.Available(),
+            size_t(SimpleBufferPage::kSimpleBufferPageSize + 1));
+
+  char out[5];
+  EXPECT_EQ(buffer.Read(out, sizeof(out)), sizeof(out));
+  EXPECT_EQ(memcmp(out, "hello", 5), 0);
+}
@@ -72,6 +72,10 @@ class URIData {
 
   const nsTArray<nsCString>& Fragments();
 
+  // The SHA-256 hashes of Fragments(), shared by all the tables checked for
+  // this URI.
+  const nsTArray<Completion>& FragmentHashes();
+
   nsIURI* URI() const;
 
  private:
@@ -81,6 +85,7 @@ class URIData {
   nsCOMPtr<nsIURI> mURI;
   nsCString mURISpec;
   nsTArray<nsCString> mFragments;
+  nsTArray<Completion> mFragmentHashes;
   nsIUrlClassifierFeature::URIType mURIType;
 };
 
@@ -148,6 +153,21 @@ const nsTArray<nsCString>& URIData::Fragments() {
   return mFragments;
 }
 
+const nsTArray<Completion>& URIData::FragmentHashes() {
+  MOZ_ASSERT(!NS_IsMainThread());
+
+  if (mFragmentHashes.IsEmpty()) {
+    nsresult rv =
+        LookupCache::GetLookupFragmentHashes(Fragments(), &mFragmentHashes);
+    if (NS_WARN_IF(NS_FAILED(rv))) {
+      // Don't check the tables against only some of the fragments.
+      mFragmentHashes.Clear();
+    }
+  }
+
+  return mFragmentHashes;
+}
+
 nsIURI* URIData::URI() const {
   MOZ_ASSERT(NS_IsMainThread());
   return mURI;
@@ -242,9 +262,9 @@ bool TableData::DoLookup(nsUrlClassifierDBServiceWorker* aWorkerClassifier) {
          "[this=%p]",
          this));
 
-    const nsTArray<nsCString>& fragments = mURIData->Fragments();
-    nsresult rv = aWorkerClassifier->DoSingleLocalLookupWithURIFragments(
-        fragments, mTable, mResults);
+    const nsTArray<Completion>& hashes = mURIData->FragmentHashes();
+    nsresult rv = aWorkerClassifier->DoSingleLocalLookupWithURIFragmentHashes(
+        hashes, mTable, mResults);
     Unused << NS_WARN_IF(NS_FAILED(rv));
 
     mState = mResults.IsEmpty() ? TableData::eNoMatch : TableData::eMatch;
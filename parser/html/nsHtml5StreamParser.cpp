@@ -151,10 +151,21 @@ NS_IMPL_CYCLE_COLLECTION_TRAVERSE_END
 class nsHtml5ExecutorFlusher : public Runnable {
  private:
   RefPtr<nsHtml5TreeOpExecutor> mExecutor;
+  mozilla::Atomic<bool> mPending{false};
 
  public:
   explicit nsHtml5ExecutorFlusher(nsHtml5TreeOpExecutor* aExecutor)
       : Runnable("nsHtml5ExecutorFlusher"), mExecutor(aExecutor) {}
+
+  /**
+   * Returns false if this runnable has already been dispatched and hasn't
+   * started reading the stage yet, in which case it will pick up whatever
+   * the caller has just staged.
+   */
+  bool MarkPending() { return !mPending.exchange(true); }
+
+  void ClearPending() { mPending = false; }
+
   NS_IMETHOD Run() override {
     if (!mExecutor->isInList()) {
       Document* doc = mExecutor->GetDocument();
@@ -171,8 +182,13 @@ class nsHtml5ExecutorFlusher : public Runnable {
           return NS_OK;
         }
       }
+      // Clear before RunFlushLoop() reads the stage so that ops staged from
+      // here on get a flush of their own.
+      ClearPending();
       mExecutor->RunFlushLoop();
+      return NS_OK;
     }
+    ClearPending();
     return NS_OK;
   }
 };
@@ -1792,10 +1808,7 @@ void nsHtml5StreamParser::PostLoadFlusher() {
       return;
     }
     if (r.unwrap()) {
-      nsCOMPtr<nsIRunnable> runnable(mExecutorFlusher);
-      if (NS_FAILED(DispatchToMain(runnable.forget()))) {
-        NS_WARNING("failed to dispatch executor flush event");
-      }
+      DispatchExecutorFlush();
     }
   }
 }
@@ -1821,10 +1834,7 @@ void nsHtml5StreamParser::FlushTreeOpsAndDisarmTimer() {
   if (r.isErr()) {
     MarkAsBroken(r.unwrapErr());
   }
-  nsCOMPtr<nsIRunnable> runnable(mExecutorFlusher);
-  if (NS_FAILED(DispatchToMain(runnable.forget()))) {
-    NS_WARNING("failed to dispatch executor flush event");
-  }
+  DispatchExecutorFlush();
 }
 
 void nsHtml5StreamParser::SwitchDecoderIfAsciiSoFar(
@@ -2810,10 +2820,7 @@ void nsHtml5StreamParser::TimerFlush() {
       return;
     }
     if (r.unwrap()) {
-      nsCOMPtr<nsIRunnable> runnable(mExecutorFlusher);
-      if (NS_FAILED(DispatchToMain(runnable.forget()))) {
-        NS_WARNING("failed to dispatch executor flush event");
-      }
+      DispatchExecutorFlush();
     }
   } else {
     // we aren't speculating and we don't know when new data is
@@ -2824,10 +2831,7 @@ void nsHtml5StreamParser::TimerFlush() {
       return;
     }
     if (r.unwrap()) {
-      nsCOMPtr<nsIRunnable> runnable(mExecutorFlusher);
-      if (NS_FAILED(DispatchToMain(runnable.forget()))) {
-        NS_WARNING("failed to dispatch executor flush event");
-      }
+      DispatchExecutorFlush();
     }
   }
 }
@@ -2844,8 +2848,19 @@ void nsHtml5StreamParser::MarkAsBroken(nsresult aRv) {
   } else {
     MOZ_CRASH("OOM prevents propagation of OOM state");
   }
-  nsCOMPtr<nsIRunnable> runnable(mExecutorFlusher);
+  DispatchExecutorFlush();
+}
+
+void nsHtml5StreamParser::DispatchExecutorFlush() {
+  if (!mExecutorFlusher->MarkPending()) {
+    // The flush already in the main thread's queue will take everything
+    // staged so far, so a burst of flushes from this thread is executed as
+    // one larger batch instead of many small ones.
+    return;
+  }
+  RefPtr<nsHtml5ExecutorFlusher> runnable(mExecutorFlusher);
   if (NS_FAILED(DispatchToMain(runnable.forget()))) {
+    mExecutorFlusher->ClearPending();
     NS_WARNING("failed to dispatch executor flush event");
   }
 }
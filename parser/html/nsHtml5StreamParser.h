@@ -30,6 +30,7 @@
 #include "nscore.h"
 
 class nsCycleCollectionTraversalCallback;
+class nsHtml5ExecutorFlusher;
 class nsHtml5OwningUTF16Buffer;
 class nsHtml5Parser;
 class nsHtml5Speculation;
@@ -461,6 +462,11 @@ class nsHtml5StreamParser final : public nsISupports {
    */
   bool IsSpeculationEnabled() { return mSpeculationFailureCount < 100; }
 
+  /**
+   * Dispatches mExecutorFlusher unless it is already pending.
+   */
+  void DispatchExecutorFlush();
+
   /**
    * Dispatch an event to a Quantum DOM main thread-ish thread.
    * (Not the parser thread.)
@@ -680,7 +686,7 @@ class nsHtml5StreamParser final : public nsISupports {
    */
   nsCOMPtr<nsISerialEventTarget> mEventTarget;
 
-  nsCOMPtr<nsIRunnable> mExecutorFlusher;
+  RefPtr<nsHtml5ExecutorFlusher> mExecutorFlusher;
 
   nsCOMPtr<nsIRunnable> mLoadFlusher;
 
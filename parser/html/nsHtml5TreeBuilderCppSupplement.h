@@ -281,6 +281,32 @@ nsIContentHandle* nsHtml5TreeBuilder::createElement(
                 mSpeculativeLoadQueue.AppendElement()->InitPreconnect(
                     url, crossOrigin);
               }
+            } else if (rel.LowerCaseEqualsASCII("modulepreload")) {
+              nsHtml5String url =
+                  aAttributes->getValue(nsHtml5AttributeName::ATTR_HREF);
+              nsHtml5String as =
+                  aAttributes->getValue(nsHtml5AttributeName::ATTR_AS);
+              // Only the "script" destination (the default) is fetched as a
+              // module by the script loader. Fetching the module also fetches
+              // its static imports, so deep import graphs start loading as
+              // soon as the parser sees the link.
+              if (url && (!as || as.LowerCaseEqualsASCII("script"))) {
+                nsHtml5String crossOrigin = aAttributes->getValue(
+                    nsHtml5AttributeName::ATTR_CROSSORIGIN);
+                nsHtml5String integrity =
+                    aAttributes->getValue(nsHtml5AttributeName::ATTR_INTEGRITY);
+                nsHtml5String referrerPolicy = aAttributes->getValue(
+                    nsHtml5AttributeName::ATTR_REFERRERPOLICY);
+                nsHtml5String media =
+                    aAttributes->getValue(nsHtml5AttributeName::ATTR_MEDIA);
+                nsHtml5String type =
+                    nsHtml5Portability::newStringFromLiteral("module");
+                mSpeculativeLoadQueue.AppendElement()->InitScript(
+                    url, nullptr, type, crossOrigin, media, integrity,
+                    referrerPolicy, mode == nsHtml5TreeBuilder::IN_HEAD, false,
+                    false, false, true);
+                type.Release();
+              }
             } else if (StaticPrefs::network_preload() &&
                        rel.LowerCaseEqualsASCII("preload")) {
               nsHtml5String url =
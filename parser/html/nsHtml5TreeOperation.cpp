@@ -405,6 +405,7 @@ nsresult nsHtml5TreeOperation::AddAttributes(nsIContent* aNode,
 void nsHtml5TreeOperation::SetHTMLElementAttributes(
     dom::Element* aElement, nsAtom* aName, nsHtml5HtmlAttributes* aAttributes) {
   int32_t len = aAttributes->getLength();
+  aElement->EnsureAttrCapacity(len);
   for (int32_t i = 0; i < len; i++) {
     nsHtml5String val = aAttributes->getValueNoBoundsCheck(i);
     nsAtom* klass = val.MaybeAsAtom();
@@ -571,6 +572,7 @@ nsIContent* nsHtml5TreeOperation::CreateSVGElement(
   }
 
   int32_t len = aAttributes->getLength();
+  newContent->EnsureAttrCapacity(len);
   for (int32_t i = 0; i < len; i++) {
     nsHtml5String val = aAttributes->getValueNoBoundsCheck(i);
     nsAtom* klass = val.MaybeAsAtom();
@@ -619,6 +621,7 @@ nsIContent* nsHtml5TreeOperation::CreateMathMLElement(
   }
 
   int32_t len = aAttributes->getLength();
+  newContent->EnsureAttrCapacity(len);
   for (int32_t i = 0; i < len; i++) {
     nsHtml5String val = aAttributes->getValueNoBoundsCheck(i);
     nsAtom* klass = val.MaybeAsAtom();
@@ -92,6 +92,11 @@ static const size_t STARTUP_CACHE_MAX_CAPACITY = 5000;
 // Not const because we change it for gtests.
 static uint8_t STARTUP_CACHE_WRITE_TIMEOUT = 60;
 
+// Upper bound on how much the prefetch thread decompresses ahead of the main
+// thread. Entries past this are left for GetBuffer to decompress on demand, so
+// that entries the session never asks for don't pin memory.
+static const size_t STARTUP_CACHE_MAX_PREDECOMPRESSED_SIZE = 8 * 1024 * 1024;
+
 #define STARTUP_CACHE_NAME "startupCache." SC_WORDSIZE "." SC_ENDIAN
 
 static inline Result<Ok, nsresult> Write(PRFileDesc* fd, const void* data,
@@ -113,6 +118,28 @@ static nsresult MapLZ4ErrorToNsresult(size_t aError) {
   return NS_ERROR_FAILURE;
 }
 
+// Decompresses the single LZ4 frame in aCompressed, which must fill
+// aUncompressed exactly.
+static Result<Ok, nsresult> DecompressEntry(
+    LZ4FrameDecompressionContext& aContext, Span<const char> aCompressed,
+    Span<char> aUncompressed) {
+  size_t totalRead = 0;
+  size_t totalWritten = 0;
+  bool finished = false;
+  while (!finished) {
+    auto result = aContext.Decompress(aUncompressed.From(totalWritten),
+                                      aCompressed.From(totalRead));
+    if (result.isErr()) {
+      return Err(NS_ERROR_FAILURE);
+    }
+    auto decompressionResult = result.unwrap();
+    totalRead += decompressionResult.mSizeRead;
+    totalWritten += decompressionResult.mSizeWritten;
+    finished = decompressionResult.mFinished;
+  }
+  return Ok();
+}
+
 StartupCache* StartupCache::GetSingletonNoInit() {
   return StartupCache::gStartupCache;
 }
@@ -165,7 +192,9 @@ StartupCache::StartupCache()
       mCurTableReferenced(false),
       mRequestedCount(0),
       mCacheEntriesBaseOffset(0),
-      mPrefetchThread(nullptr) {}
+      mPrefetchThread(nullptr),
+      mPredecompressedCount(0),
+      mCancelPrefetch(false) {}
 
 StartupCache::~StartupCache() { UnregisterWeakMemoryReporter(this); }
 
@@ -251,6 +280,7 @@ void StartupCache::StartPrefetchMemoryThread() {
   // XXX: It would be great for this to not create its own thread, unfortunately
   // there doesn't seem to be an existing thread that makes sense for this, so
   // barring a coordinated global scheduling system this is the best we get.
+  mCancelPrefetch = false;
   mPrefetchThread = PR_CreateThread(
       PR_USER_THREAD, StartupCache::ThreadedPrefetch, this, PR_PRIORITY_NORMAL,
       PR_GLOBAL_THREAD, PR_JOINABLE_THREAD, 256 * 1024);
@@ -265,9 +295,6 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
 
   MOZ_TRY(mCacheData.init(mFile));
   auto size = mCacheData.size();
-  if (CanPrefetchMemory()) {
-    StartPrefetchMemoryThread();
-  }
 
   uint32_t headerSize;
   if (size < sizeof(MAGIC) + sizeof(headerSize)) {
@@ -301,8 +328,8 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
       return Err(NS_ERROR_UNEXPECTED);
     }
     auto cleanup = MakeScopeExit([&]() {
-      WaitOnPrefetchThread();
       mTable.clear();
+      ClearPredecompressedEntries();
       mCacheData.reset();
     });
     loader::InputBuffer buf(header);
@@ -338,11 +365,14 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
         return Err(NS_ERROR_UNEXPECTED);
       }
 
-      if (!mTable.add(
-              p, key,
-              StartupCacheEntry(offset, compressedSize, uncompressedSize))) {
+      int32_t fileIndex = int32_t(mPredecompressed.Length());
+      if (!mTable.add(p, key,
+                      StartupCacheEntry(offset, compressedSize,
+                                        uncompressedSize, fileIndex))) {
         return Err(NS_ERROR_UNEXPECTED);
       }
+      mPredecompressed.AppendElement(PredecompressedEntry{
+          offset, compressedSize, uncompressedSize, nullptr});
     }
 
     if (buf.error()) {
@@ -352,6 +382,14 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
     cleanup.release();
   }
 
+  mPredecompressedTaken =
+      MakeUnique<Atomic<bool, Relaxed>[]>(mPredecompressed.Length());
+
+  // The thread reads the entry list, so it can only start once that's built.
+  if (CanPrefetchMemory()) {
+    StartPrefetchMemoryThread();
+  }
+
   MMAP_FAULT_HANDLER_CATCH(Err(NS_ERROR_UNEXPECTED))
 
   return Ok();
@@ -385,6 +423,12 @@ nsresult StartupCache::GetBuffer(const char* id, const char** outbuf,
   auto& value = p->value();
   if (value.mData) {
     label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitMemory;
+  } else if (value.mFileIndex >= 0 &&
+             uint32_t(value.mFileIndex) < mPredecompressedCount &&
+             mPredecompressed[value.mFileIndex].mData) {
+    // The prefetch thread already decompressed this one; take ownership.
+    value.mData = std::move(mPredecompressed[value.mFileIndex].mData);
+    label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitDisk;
   } else {
     if (!mCacheData.initialized()) {
       return NS_ERROR_NOT_AVAILABLE;
@@ -406,8 +450,12 @@ nsresult StartupCache::GetBuffer(const char* id, const char** outbuf,
     mTableLock.Unlock();
 #endif
 
-    size_t totalRead = 0;
-    size_t totalWritten = 0;
+    // Don't let the prefetch thread spend its budget on this one too.
+    if (value.mFileIndex >= 0 &&
+        uint32_t(value.mFileIndex) < mPredecompressed.Length()) {
+      mPredecompressedTaken[value.mFileIndex] = true;
+    }
+
     Span<const char> compressed = Span(
         mCacheData.get<char>().get() + mCacheEntriesBaseOffset + value.mOffset,
         value.mCompressedSize);
@@ -415,19 +463,12 @@ nsresult StartupCache::GetBuffer(const char* id, const char** outbuf,
     Span<char> uncompressed = Span(value.mData.get(), value.mUncompressedSize);
     MMAP_FAULT_HANDLER_BEGIN_BUFFER(uncompressed.Elements(),
                                     uncompressed.Length())
-    bool finished = false;
-    while (!finished) {
-      auto result = mDecompressionContext->Decompress(
-          uncompressed.From(totalWritten), compressed.From(totalRead));
-      if (NS_WARN_IF(result.isErr())) {
-        value.mData = nullptr;
-        InvalidateCache();
-        return NS_ERROR_FAILURE;
-      }
-      auto decompressionResult = result.unwrap();
-      totalRead += decompressionResult.mSizeRead;
-      totalWritten += decompressionResult.mSizeWritten;
-      finished = decompressionResult.mFinished;
+    if (NS_WARN_IF(
+            DecompressEntry(*mDecompressionContext, compressed, uncompressed)
+                .isErr())) {
+      value.mData = nullptr;
+      InvalidateCache();
+      return NS_ERROR_FAILURE;
     }
 
     MMAP_FAULT_HANDLER_CATCH(NS_ERROR_FAILURE)
@@ -504,6 +545,11 @@ size_t StartupCache::HeapSizeOfIncludingThis(
     n += iter.get().key().SizeOfExcludingThisIfUnshared(aMallocSizeOf);
   }
 
+  n += mPredecompressed.ShallowSizeOfExcludingThis(aMallocSizeOf);
+  for (uint32_t i = 0; i < mPredecompressedCount; i++) {
+    n += aMallocSizeOf(mPredecompressed[i].mData.get());
+  }
+
   return n;
 }
 
@@ -648,6 +694,7 @@ void StartupCache::InvalidateCache(bool memoryOnly) {
   } else {
     mTable.clear();
   }
+  ClearPredecompressedEntries();
   mRequestedCount = 0;
   if (!memoryOnly) {
     mCacheData.reset();
@@ -713,6 +760,9 @@ void StartupCache::IgnoreDiskCache() {
 void StartupCache::WaitOnPrefetchThread() {
   if (!mPrefetchThread || mPrefetchThread == PR_GetCurrentThread()) return;
 
+  // Whatever hasn't been decompressed yet is cheaper to do on demand than to
+  // wait for.
+  mCancelPrefetch = true;
   PR_JoinThread(mPrefetchThread);
   mPrefetchThread = nullptr;
 }
@@ -727,9 +777,57 @@ void StartupCache::ThreadedPrefetch(void* aClosure) {
   MMAP_FAULT_HANDLER_BEGIN_BUFFER(buf, size)
   PrefetchMemory(buf, size);
   MMAP_FAULT_HANDLER_CATCH()
+  startupCacheObj->PredecompressEntries();
   mozilla::IOInterposer::UnregisterCurrentThread();
 }
 
+/**
+ * PredecompressEntries runs on the prefetch thread.
+ */
+void StartupCache::PredecompressEntries() {
+  LZ4FrameDecompressionContext context(true);
+  const char* base = mCacheData.get<char>().get() + mCacheEntriesBaseOffset;
+  size_t budget = STARTUP_CACHE_MAX_PREDECOMPRESSED_SIZE;
+
+  MMAP_FAULT_HANDLER_BEGIN_BUFFER(mCacheData.get<uint8_t>().get(),
+                                  mCacheData.size())
+  for (uint32_t i = 0; i < mPredecompressed.Length(); i++) {
+    auto& entry = mPredecompressed[i];
+    if (mCancelPrefetch) {
+      break;
+    }
+    if (mPredecompressedTaken[i]) {
+      // The main thread got here first.
+      mPredecompressedCount = i + 1;
+      continue;
+    }
+    if (entry.mUncompressedSize > budget) {
+      break;
+    }
+    budget -= entry.mUncompressedSize;
+
+    auto data = MakeUnique<char[]>(entry.mUncompressedSize);
+    Span<const char> compressed(base + entry.mOffset, entry.mCompressedSize);
+    // On failure, leave the entry to GetBuffer, which reports the corruption
+    // and invalidates the cache on the main thread.
+    if (DecompressEntry(context, compressed,
+                        Span(data.get(), entry.mUncompressedSize))
+            .isErr()) {
+      break;
+    }
+    entry.mData = std::move(data);
+    mPredecompressedCount = i + 1;
+  }
+  MMAP_FAULT_HANDLER_CATCH()
+}
+
+void StartupCache::ClearPredecompressedEntries() {
+  WaitOnPrefetchThread();
+  mPredecompressed.Clear();
+  mPredecompressedTaken = nullptr;
+  mPredecompressedCount = 0;
+}
+
 bool StartupCache::ShouldCompactCache() {
   // If we've requested less than 4/5 of the startup cache, then we should
   // probably compact it down. This can happen quite easily after the first run,
@@ -759,6 +857,11 @@ void StartupCache::WriteTimeout(nsITimer* aTimer, void* aClosure) {
  * See StartupCache::WriteTimeout above - this is just the non-static body.
  */
 void StartupCache::MaybeWriteOffMainThread() {
+  // Startup is over by the time the write timer fires, so anything the
+  // prefetch thread decompressed that still hasn't been asked for is unlikely
+  // to be. Free it whether or not we end up writing.
+  ClearPredecompressedEntries();
+
   if (mWrittenOnce) {
     return;
   }
@@ -89,16 +89,21 @@ struct StartupCacheEntry {
   uint32_t mUncompressedSize;
   int32_t mHeaderOffsetInFile;
   int32_t mRequestedOrder;
+  // Position of the entry in the file, used to find data that the prefetch
+  // thread already decompressed. -1 for entries not loaded from disk.
+  int32_t mFileIndex;
   bool mRequested;
 
   MOZ_IMPLICIT StartupCacheEntry(uint32_t aOffset, uint32_t aCompressedSize,
-                                 uint32_t aUncompressedSize)
+                                 uint32_t aUncompressedSize,
+                                 int32_t aFileIndex = -1)
       : mData(nullptr),
         mOffset(aOffset),
         mCompressedSize(aCompressedSize),
         mUncompressedSize(aUncompressedSize),
         mHeaderOffsetInFile(0),
         mRequestedOrder(0),
+        mFileIndex(aFileIndex),
         mRequested(false) {}
 
   StartupCacheEntry(UniquePtr<char[]> aData, size_t aLength,
@@ -109,6 +114,7 @@ struct StartupCacheEntry {
         mUncompressedSize(aLength),
         mHeaderOffsetInFile(0),
         mRequestedOrder(0),
+        mFileIndex(-1),
         mRequested(true) {}
 
   struct Comparator {
@@ -208,6 +214,8 @@ class StartupCache : public nsIMemoryReporter {
 
   void WaitOnPrefetchThread();
   void StartPrefetchMemoryThread();
+  void PredecompressEntries();
+  void ClearPredecompressedEntries();
 
   static nsresult InitSingleton();
   static void WriteTimeout(nsITimer* aTimer, void* aClosure);
@@ -242,6 +250,26 @@ class StartupCache : public nsIMemoryReporter {
   static bool gFoundDiskCacheOnInit;
   PRThread* mPrefetchThread;
   UniquePtr<Compression::LZ4FrameDecompressionContext> mDecompressionContext;
+
+  // Entries of the loaded file, in file order. Since the file is written in
+  // the order entries were requested during the previous session, the
+  // prefetch thread decompresses them front to back ahead of the main thread.
+  // It fills in mData for an element before publishing it by bumping
+  // mPredecompressedCount; elements below that count belong to the main
+  // thread, and the array itself is not resized while the thread runs.
+  // mPredecompressedTaken has one flag per element, set by the main thread
+  // when it decompresses an entry itself so the thread can skip it. All of
+  // this is freed once the startup write timer fires.
+  struct PredecompressedEntry {
+    uint32_t mOffset;
+    uint32_t mCompressedSize;
+    uint32_t mUncompressedSize;
+    UniquePtr<char[]> mData;
+  };
+  nsTArray<PredecompressedEntry> mPredecompressed;
+  UniquePtr<Atomic<bool, Relaxed>[]> mPredecompressedTaken;
+  Atomic<uint32_t, ReleaseAcquire> mPredecompressedCount;
+  Atomic<bool> mCancelPrefetch;
 #ifdef DEBUG
   nsTHashSet<nsCOMPtr<nsISupports>> mWriteObjectMap;
 #endif
@@ -23,6 +23,7 @@
 #include "mozilla/Printf.h"
 #include "mozilla/UniquePtr.h"
 #include "nsNetCID.h"
+#include "nsPrintfCString.h"
 #include "nsIURIMutator.h"
 
 using namespace JS;
@@ -182,3 +183,64 @@ TEST_F(TestStartupCache, WriteObject) {
   EXPECT_TRUE(NS_SUCCEEDED(rv));
   ASSERT_TRUE(outSpec.Equals(spec));
 }
+
+TEST_F(TestStartupCache, WriteReloadReadInOrder) {
+  nsresult rv;
+  StartupCache* sc = StartupCache::GetSingleton();
+  ASSERT_TRUE(sc);
+
+  // Enough entries that some are read back while the prefetch thread may
+  // still be decompressing later ones.
+  static const uint32_t kNumEntries = 64;
+  for (uint32_t i = 0; i < kNumEntries; i++) {
+    nsPrintfCString id("id%u", i);
+    nsPrintfCString buf("BeardBook quarterly report, part %u", i);
+    rv = sc->PutBuffer(id.get(), UniquePtr<char[]>(strdup(buf.get())),
+                       buf.Length() + 1);
+    EXPECT_TRUE(NS_SUCCEEDED(rv));
+  }
+
+  // Write the entries out and load them back from disk.
+  sc->InvalidateCache(true);
+
+  for (uint32_t i = 0; i < kNumEntries; i++) {
+    nsPrintfCString id("id%u", i);
+    nsPrintfCString buf("BeardBook quarterly report, part %u", i);
+    const char* outbuf;
+    uint32_t len;
+    rv = sc->GetBuffer(id.get(), &outbuf, &len);
+    EXPECT_TRUE(NS_SUCCEEDED(rv));
+    EXPECT_EQ(len, buf.Length() + 1);
+    EXPECT_STREQ(buf.get(), outbuf);
+  }
+}
+
+TEST_F(TestStartupCache, WriteReloadReadOutOfOrder) {
+  nsresult rv;
+  StartupCache* sc = StartupCache::GetSingleton();
+  ASSERT_TRUE(sc);
+
+  static const uint32_t kNumEntries = 64;
+  for (uint32_t i = 0; i < kNumEntries; i++) {
+    nsPrintfCString id("id%u", i);
+    nsPrintfCString buf("BeardBook quarterly report, part %u", i);
+    rv = sc->PutBuffer(id.get(), UniquePtr<char[]>(strdup(buf.get())),
+                       buf.Length() + 1);
+    EXPECT_TRUE(NS_SUCCEEDED(rv));
+  }
+
+  sc->InvalidateCache(true);
+
+  // Read back to front, so the main thread decompresses entries the prefetch
+  // thread hasn't reached yet and the thread has to skip them.
+  for (uint32_t i = kNumEntries; i > 0; i--) {
+    nsPrintfCString id("id%u", i - 1);
+    nsPrintfCString buf("BeardBook quarterly report, part %u", i - 1);
+    const char* outbuf;
+    uint32_t len;
+    rv = sc->GetBuffer(id.get(), &outbuf, &len);
+    EXPECT_TRUE(NS_SUCCEEDED(rv));
+    EXPECT_EQ(len, buf.Length() + 1);
+    EXPECT_STREQ(buf.get(), outbuf);
+  }
+}
@@ -485,16 +485,26 @@ nsresult Classifier::CheckURIFragments(
          aSpecFragments[urlIdx].get()));
   }
 
+  nsTArray<Completion> hashes;
+  nsresult rv = LookupCache::GetLookupFragmentHashes(aSpecFragments, &hashes);
+  NS_ENSURE_SUCCESS(rv, rv);
+
+  return CheckURIFragmentHashes(hashes, aTable, aResults);
+}
+
+nsresult Classifier::CheckURIFragmentHashes(
+    const nsTArray<Completion>& aFragmentHashes, const nsACString& aTable,
+    LookupResultArray& aResults) {
+  MOZ_ASSERT(aFragmentHashes.Length() <=
+             (MAX_HOST_COMPONENTS * (MAX_PATH_COMPONENTS + 2)));
+
   RefPtr<LookupCache> cache = GetLookupCache(aTable);
   if (NS_WARN_IF(!cache)) {
     return NS_ERROR_FAILURE;
   }
 
   // Now check each lookup fragment against the entries in the DB.
-  for (uint32_t i = 0; i < aSpecFragments.Length(); i++) {
-    Completion lookupHash;
-    lookupHash.FromPlaintext(aSpecFragments[i]);
-
+  for (const Completion& lookupHash : aFragmentHashes) {
     bool has, confirmed;
     uint32_t matchLength;
 
@@ -508,8 +518,8 @@ nsresult Classifier::CheckURIFragments(
       if (LOG_ENABLED()) {
         nsAutoCString checking;
         lookupHash.ToHexString(checking);
-        LOG(("Found a result in fragment %s, hash %s (%X)",
-             aSpecFragments[i].get(), checking.get(), lookupHash.ToUint32()));
+        LOG(("Found a result in table %s, hash %s (%X)",
+             aTable.BeginReading(), checking.get(), lookupHash.ToUint32()));
         LOG(("Result %s, match %d-bytes prefix",
              confirmed ? "confirmed." : "Not confirmed.", matchLength));
       }
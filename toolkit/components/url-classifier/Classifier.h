@@ -63,6 +63,14 @@ class Classifier {
                              const nsACString& table,
                              LookupResultArray& aResults);
 
+  /**
+   * Same as above, with the fragments already hashed by
+   * |LookupCache::GetLookupFragmentHashes|.
+   */
+  nsresult CheckURIFragmentHashes(const nsTArray<Completion>& aFragmentHashes,
+                                  const nsACString& table,
+                                  LookupResultArray& aResults);
+
   /**
    * Asynchronously apply updates to the in-use databases. When the
    * update is complete, the caller can be notified by |aCallback|, which
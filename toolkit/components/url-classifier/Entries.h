@@ -36,15 +36,22 @@ struct SafebrowsingHash {
   uint8_t buf[S];
 
   nsresult FromPlaintext(const nsACString& aPlainText) {
-    // From the protocol doc:
-    // Each entry in the chunk is composed
-    // of the SHA 256 hash of a suffix/prefix expression.
     nsresult rv;
     nsCOMPtr<nsICryptoHash> hash =
         do_CreateInstance(NS_CRYPTO_HASH_CONTRACTID, &rv);
     NS_ENSURE_SUCCESS(rv, rv);
 
-    rv = hash->Init(nsICryptoHash::SHA256);
+    return FromPlaintext(aPlainText, hash);
+  }
+
+  // Same as above, but reuses |aHash| so that hashing many strings in a row
+  // doesn't create a new hash object for each of them.
+  nsresult FromPlaintext(const nsACString& aPlainText, nsICryptoHash* aHash) {
+    // From the protocol doc:
+    // Each entry in the chunk is composed
+    // of the SHA 256 hash of a suffix/prefix expression.
+    nsCOMPtr<nsICryptoHash> hash = aHash;
+    nsresult rv = hash->Init(nsICryptoHash::SHA256);
     NS_ENSURE_SUCCESS(rv, rv);
 
     rv = hash->Update(
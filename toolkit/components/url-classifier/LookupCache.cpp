@@ -504,6 +504,32 @@ nsresult LookupCache::GetLookupEntitylistFragments(
   return NS_OK;
 }
 
+/* static */
+nsresult LookupCache::GetLookupFragmentHashes(
+    const nsTArray<nsCString>& aFragments, nsTArray<Completion>* aHashes) {
+  aHashes->Clear();
+
+  nsresult rv;
+  nsCOMPtr<nsICryptoHash> hash =
+      do_CreateInstance(NS_CRYPTO_HASH_CONTRACTID, &rv);
+  NS_ENSURE_SUCCESS(rv, rv);
+
+  if (!aHashes->SetCapacity(aFragments.Length(), fallible)) {
+    return NS_ERROR_OUT_OF_MEMORY;
+  }
+
+  for (const nsCString& fragment : aFragments) {
+    Completion* lookupHash = aHashes->AppendElement();
+    rv = lookupHash->FromPlaintext(fragment, hash);
+    if (NS_FAILED(rv)) {
+      aHashes->Clear();
+      return rv;
+    }
+  }
+
+  return NS_OK;
+}
+
 /* static */
 nsresult LookupCache::GetLookupFragments(const nsACString& aSpec,
                                          nsTArray<nsCString>* aFragments)
@@ -185,6 +185,12 @@ class LookupCache {
   static nsresult GetLookupEntitylistFragments(const nsACString& aSpec,
                                                nsTArray<nsCString>* aFragments);
 
+  // Hash the fragments returned by one of the functions above. The hashes
+  // can be checked against any number of tables. aHashes is left empty on
+  // failure.
+  static nsresult GetLookupFragmentHashes(const nsTArray<nsCString>& aFragments,
+                                          nsTArray<Completion>* aHashes);
+
   LookupCache(const nsACString& aTableName, const nsACString& aProvider,
               nsCOMPtr<nsIFile>& aStoreFile);
 
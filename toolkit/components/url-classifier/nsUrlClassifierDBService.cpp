@@ -170,9 +170,14 @@ class nsUrlClassifierDBService::FeatureHolder final {
     nsresult rv = LookupCache::GetLookupFragments(aSpec, &fragments);
     NS_ENSURE_SUCCESS(rv, rv);
 
+    // Hash the fragments once rather than once per table.
+    nsTArray<Completion> hashes;
+    rv = LookupCache::GetLookupFragmentHashes(fragments, &hashes);
+    NS_ENSURE_SUCCESS(rv, rv);
+
     for (TableData* tableData : mTableData) {
-      rv = aWorker->DoSingleLocalLookupWithURIFragments(
-          fragments, tableData->mTable, tableData->mResults);
+      rv = aWorker->DoSingleLocalLookupWithURIFragmentHashes(
+          hashes, tableData->mTable, tableData->mResults);
       if (NS_WARN_IF(NS_FAILED(rv))) {
         return rv;
       }
@@ -357,6 +362,33 @@ nsresult nsUrlClassifierDBServiceWorker::DoSingleLocalLookupWithURIFragments(
   return NS_OK;
 }
 
+nsresult
+nsUrlClassifierDBServiceWorker::DoSingleLocalLookupWithURIFragmentHashes(
+    const nsTArray<Completion>& aFragmentHashes, const nsACString& aTable,
+    LookupResultArray& aResults) {
+  if (gShuttingDownThread) {
+    return NS_ERROR_ABORT;
+  }
+
+  MOZ_ASSERT(!NS_IsMainThread(),
+             "DoSingleLocalLookupWithURIFragmentHashes must be on background "
+             "thread");
+
+  // Bail if we haven't been initialized on the background thread.
+  if (!mClassifier) {
+    return NS_ERROR_NOT_AVAILABLE;
+  }
+
+  nsresult rv =
+      mClassifier->CheckURIFragmentHashes(aFragmentHashes, aTable, aResults);
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    return rv;
+  }
+
+  LOG(("Found %zu results.", aResults.Length()));
+  return NS_OK;
+}
+
 /**
  * Lookup up a key in the database is a two step process:
  *
@@ -170,6 +170,12 @@ class nsUrlClassifierDBServiceWorker final : public nsIUrlClassifierDBService {
       const nsTArray<nsCString>& aSpecFragments, const nsACString& aTable,
       LookupResultArray& aResults);
 
+  // Same as above, for fragments hashed with
+  // LookupCache::GetLookupFragmentHashes.
+  nsresult DoSingleLocalLookupWithURIFragmentHashes(
+      const nsTArray<Completion>& aFragmentHashes,
+      const nsACString& aTable, LookupResultArray& aResults);
+
   // Open the DB connection
   nsresult OpenDb();
 
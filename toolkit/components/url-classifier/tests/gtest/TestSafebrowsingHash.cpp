@@ -3,6 +3,7 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "LookupCache.h"
 #include "mozilla/EndianUtils.h"
 
 #include "Common.h"
@@ -56,3 +57,26 @@ TEST(UrlClassifierHash, Compare)
   ASSERT_TRUE(p1 == p1);
   ASSERT_TRUE(p1 == p3);
 }
+
+TEST(UrlClassifierHash, FragmentHashes)
+{
+  using namespace mozilla::safebrowsing;
+
+  nsTArray<nsCString> fragments;
+  ASSERT_EQ(LookupCache::GetLookupFragments("a.b.c.example.com/1/2.html?p=1"_ns,
+                                            &fragments),
+            NS_OK);
+  ASSERT_FALSE(fragments.IsEmpty());
+
+  nsTArray<Completion> hashes;
+  ASSERT_EQ(LookupCache::GetLookupFragmentHashes(fragments, &hashes), NS_OK);
+  ASSERT_EQ(hashes.Length(), fragments.Length());
+
+  // Reusing one hash object must give the same results as hashing each
+  // fragment on its own.
+  for (uint32_t i = 0; i < fragments.Length(); i++) {
+    Completion expected;
+    ASSERT_EQ(expected.FromPlaintext(fragments[i]), NS_OK);
+    ASSERT_TRUE(hashes[i] == expected);
+  }
+}
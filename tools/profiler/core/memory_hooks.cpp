@@ -134,12 +134,29 @@ static size_t MallocSizeOf(const void* aPtr) {
 // However this value resulted in a lot of slowdown since the profiler stacks
 // are pretty heavy to collect. The value was lowered to 10% of the original to
 // 0.0003.
+//
+// Since the trial is per byte, sampled allocations form a Poisson process over
+// the allocated bytes, with on average one sample every 1/probability bytes.
+// MOZ_PROFILER_NATIVE_ALLOCATIONS_INTERVAL can set that mean interval instead,
+// e.g. to something much larger to keep the overhead negligible while looking
+// for hot spots over a long time.
 static void EnsureBernoulliIsInstalled() {
   if (!gBernoulli) {
+    double probability = 0.0003;
+    const char* interval =
+        PR_GetEnv("MOZ_PROFILER_NATIVE_ALLOCATIONS_INTERVAL");
+    if (interval && interval[0] != '\0') {
+      errno = 0;
+      double bytes = strtod(interval, nullptr);
+      if (errno == 0 && bytes >= 1.0) {
+        probability = 1.0 / bytes;
+      }
+    }
+
     // This is only installed once. See the gBernoulli definition for more
     // information.
-    gBernoulli =
-        new FastBernoulliTrial(0.0003, 0x8e26eeee166bc8ca, 0x56820f304a9c9ae0);
+    gBernoulli = new FastBernoulliTrial(probability, 0x8e26eeee166bc8ca,
+                                        0x56820f304a9c9ae0);
   }
 }
 
@@ -364,6 +381,10 @@ class MOZ_RAII ThreadIntercept {
 
   static void EnableAllocationFeature() { sAllocationsFeatureEnabled = true; }
 
+  static bool IsAllocationFeatureEnabled() {
+    return sAllocationsFeatureEnabled;
+  }
+
   static void DisableAllocationFeature() { sAllocationsFeatureEnabled = false; }
 };
 
@@ -387,6 +408,21 @@ static void AllocCallback(void* aPtr, size_t aReqSize) {
     sCounter->Add(actualSize);
   }
 
+  if (!ThreadIntercept::IsAllocationFeatureEnabled()) {
+    return;
+  }
+
+  // Perform a bernoulli trial, which will return true or false based on its
+  // configured probability. It takes into account the byte size so that
+  // larger allocations are weighted heavier than smaller allocations.
+  // This is done before anything else so that allocations that aren't sampled,
+  // which are the vast majority, only pay for the trial.
+  MOZ_ASSERT(gBernoulli,
+             "gBernoulli must be properly installed for the memory hooks.");
+  if (!gBernoulli->trial(actualSize)) {
+    return;
+  }
+
   ThreadIntercept threadIntercept;
   if (threadIntercept.IsBlocked()) {
     // Either the native allocations feature is not turned on, or we may be
@@ -397,16 +433,8 @@ static void AllocCallback(void* aPtr, size_t aReqSize) {
 
   AUTO_PROFILER_LABEL("AllocCallback", PROFILER);
 
-  // Perform a bernoulli trial, which will return true or false based on its
-  // configured probability. It takes into account the byte size so that
-  // larger allocations are weighted heavier than smaller allocations.
-  MOZ_ASSERT(gBernoulli,
-             "gBernoulli must be properly installed for the memory hooks.");
-  if (
-      // First perform the Bernoulli trial.
-      gBernoulli->trial(actualSize) &&
-      // Second, attempt to add a marker if the Bernoulli trial passed.
-      profiler_add_native_allocation_marker(
+  // Attempt to add a marker now that the Bernoulli trial passed.
+  if (profiler_add_native_allocation_marker(
           static_cast<int64_t>(actualSize),
           reinterpret_cast<uintptr_t>(aPtr))) {
     MOZ_ASSERT(gAllocationTracker,
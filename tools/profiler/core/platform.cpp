@@ -3520,6 +3520,11 @@ static void PrintUsage() {
       "  This variable is used to propagate the activeTabID of\n"
       "  the profiler init params to subprocesses.\n"
       "\n"
+      "  MOZ_PROFILER_NATIVE_ALLOCATIONS_INTERVAL=<Bytes>\n"
+      "  Specifies the average number of bytes allocated between two native\n"
+      "  allocations being sampled when the \"nativeallocations\" feature is\n"
+      "  on. If unset, there is on average one sample every 3333 bytes.\n"
+      "\n"
       "  MOZ_PROFILER_SHUTDOWN\n"
       "  If set, the profiler saves a profile to the named file on shutdown.\n"
       "\n"
@@ -160,6 +160,7 @@
 #include "mozilla/HashTable.h"
 #include "mozilla/HoldDropJSObjects.h"
 /* This must occur *after* base/process_util.h to avoid typedefs conflicts. */
+#include <algorithm>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -175,6 +176,7 @@
 #include "mozilla/PoisonIOInterposer.h"
 #include "mozilla/ProfilerLabels.h"
 #include "mozilla/SegmentedVector.h"
+#include "mozilla/StaticPrefs_dom.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/ThreadLocal.h"
 #include "mozilla/UniquePtr.h"
@@ -1002,7 +1004,10 @@ struct nsPurpleBuffer {
     mEntries.Clear();
   }
 
-  void SelectPointers(CCGraphBuilder& aBuilder);
+  // Add the suspected objects to the graph as roots, except for those in
+  // aDeferred, which are left in the buffer. Returns how many were left.
+  uint32_t SelectPointers(CCGraphBuilder& aBuilder,
+                          const mozilla::HashSet<void*>* aDeferred);
 
   // RemoveSkippable removes entries from the purple buffer synchronously
   // (1) if !aAsyncSnowWhiteFreeing and nsPurpleBufferEntry::mRefCnt is 0 or
@@ -1040,13 +1045,19 @@ static bool AddPurpleRoot(CCGraphBuilder& aBuilder, void* aRoot,
                           nsCycleCollectionParticipant* aParti);
 
 struct SelectPointersVisitor {
-  explicit SelectPointersVisitor(CCGraphBuilder& aBuilder)
-      : mBuilder(aBuilder) {}
+  SelectPointersVisitor(CCGraphBuilder& aBuilder,
+                        const mozilla::HashSet<void*>* aDeferred)
+      : mBuilder(aBuilder), mDeferred(aDeferred), mDeferredCount(0) {}
 
   bool Visit(nsPurpleBuffer& aBuffer, nsPurpleBufferEntry* aEntry) {
     MOZ_ASSERT(aEntry->mObject, "Null object in purple buffer");
     MOZ_ASSERT(aEntry->mRefCnt->get() != 0,
                "SelectPointersVisitor: snow-white object in the purple buffer");
+    if (aEntry->mRefCnt->IsPurple() && mDeferred &&
+        mDeferred->has(aEntry->mObject)) {
+      ++mDeferredCount;
+      return true;
+    }
     if (!aEntry->mRefCnt->IsPurple() ||
         AddPurpleRoot(mBuilder, aEntry->mObject, aEntry->mParticipant)) {
       aBuffer.Remove(aEntry);
@@ -1054,18 +1065,24 @@ struct SelectPointersVisitor {
     return true;
   }
 
+  uint32_t DeferredCount() const { return mDeferredCount; }
+
  private:
   CCGraphBuilder& mBuilder;
+  const mozilla::HashSet<void*>* mDeferred;
+  uint32_t mDeferredCount;
 };
 
-void nsPurpleBuffer::SelectPointers(CCGraphBuilder& aBuilder) {
-  SelectPointersVisitor visitor(aBuilder);
+uint32_t nsPurpleBuffer::SelectPointers(
+    CCGraphBuilder& aBuilder, const mozilla::HashSet<void*>* aDeferred) {
+  SelectPointersVisitor visitor(aBuilder, aDeferred);
   VisitEntries(visitor);
 
-  MOZ_ASSERT(mCount == 0, "AddPurpleRoot failed");
+  MOZ_ASSERT(mCount == visitor.DeferredCount(), "AddPurpleRoot failed");
   if (mCount == 0) {
     FreeBlocks();
   }
+  return visitor.DeferredCount();
 }
 
 enum ccPhase {
@@ -1085,6 +1102,12 @@ using js::SliceBudget;
 
 class JSPurpleBuffer;
 
+// See nsCycleCollector::mOldSuspects.
+static const uint32_t kSurvivalsBeforePromotion = 3;
+static const uint32_t kMaxYoungCollectionsInARow = 10;
+static const uint32_t kMaxDeferredSuspects = 10000;
+static const double kMaxSecondsBetweenFullCollections = 60.0;
+
 class nsCycleCollector : public nsIMemoryReporter {
  public:
   NS_DECL_ISUPPORTS
@@ -1123,6 +1146,28 @@ class nsCycleCollector : public nsIMemoryReporter {
 
   RefPtr<JSPurpleBuffer> mJSPurpleBuffer;
 
+  // Generational collection. Purple roots found to be live in
+  // kSurvivalsBeforePromotion collections in a row are promoted to
+  // mOldSuspects. Young collections leave old suspects in the purple buffer
+  // instead of adding them to the graph as roots, and treat them as live if
+  // the graph reaches them anyway. A full collection scans every suspect and
+  // starts the counts over. See NextCollectionIsFull() for when that happens.
+  // Old suspects are not invalidated when they are mutated, so garbage they
+  // root is only found by the next full collection. Entries may outlive the
+  // objects they name. A new object at the same address is then just deferred
+  // until the next full collection.
+  //
+  // This can be turned off with the dom.cycle_collector.generational pref.
+  mozilla::HashMap<void*, uint32_t> mSurvivorCounts;
+  mozilla::HashSet<void*> mOldSuspects;
+  uint32_t mYoungCollectionsInARow;
+  TimeStamp mLastFullCollection;
+  // The number of old suspects left in the purple buffer by the current or
+  // last collection. Removing entries from the purple buffer between
+  // collections can make this stale, so it is then reset and the deferred
+  // suspects are counted again by SuspectedCount until the next collection.
+  uint32_t mDeferredSuspectCount;
+
  private:
   virtual ~nsCycleCollector();
 
@@ -1152,6 +1197,14 @@ class nsCycleCollector : public nsIMemoryReporter {
   bool FreeSnowWhite(bool aUntilNoSWInPurpleBuffer);
   bool FreeSnowWhiteWithBudget(js::SliceBudget& aBudget);
 
+  // Some purple buffer entries were removed, and they may have included
+  // deferred suspects.
+  void PurpleBufferEntriesRemoved() {
+    if (IsIdle()) {
+      mDeferredSuspectCount = 0;
+    }
+  }
+
   // This method assumes its argument is already canonicalized.
   void RemoveObjectFromGraph(void* aPtr);
 
@@ -1189,9 +1242,12 @@ class nsCycleCollector : public nsIMemoryReporter {
   void MarkRoots(SliceBudget& aBudget);
   void ScanRoots(bool aFullySynchGraphBuild);
   void ScanIncrementalRoots();
+  void ScanDeferredSuspects();
   void ScanWhiteNodes(bool aFullySynchGraphBuild);
   void ScanBlackNodes();
   void ScanWeakMaps();
+  void UpdateSurvivors();
+  bool NextCollectionIsFull() const;
 
   // returns whether anything was collected
   bool CollectWhite();
@@ -1207,11 +1263,18 @@ NS_IMPL_ISUPPORTS(nsCycleCollector, nsIMemoryReporter)
  *
  * bool ShouldVisitNode(PtrInfo const *pi);
  * void VisitNode(PtrInfo *pi);
+ *
+ * Once ShouldVisitNode returns false for a node it must keep doing so for the
+ * rest of the walk, so that such nodes need not be queued at all.
+ *
+ * The queue is kept between walks, so a walker that is reused for many
+ * Walk() calls only allocates it once.
  */
 template <class Visitor>
 class GraphWalker {
  private:
   Visitor mVisitor;
+  nsDeque<PtrInfo> mQueue;
 
   void DoWalk(nsDeque<PtrInfo>& aQueue);
 
@@ -1272,19 +1335,17 @@ static void ToParticipant(void* aParti, nsCycleCollectionParticipant** aCp) {
 
 template <class Visitor>
 MOZ_NEVER_INLINE void GraphWalker<Visitor>::Walk(PtrInfo* aPi) {
-  nsDeque<PtrInfo> queue;
-  CheckedPush(queue, aPi);
-  DoWalk(queue);
+  CheckedPush(mQueue, aPi);
+  DoWalk(mQueue);
 }
 
 template <class Visitor>
 MOZ_NEVER_INLINE void GraphWalker<Visitor>::WalkFromRoots(CCGraph& aGraph) {
-  nsDeque<PtrInfo> queue;
   NodePool::Enumerator etor(aGraph.mNodes);
   for (uint32_t i = 0; i < aGraph.mRootCount; ++i) {
-    CheckedPush(queue, etor.GetNext());
+    CheckedPush(mQueue, etor.GetNext());
   }
-  DoWalk(queue);
+  DoWalk(mQueue);
 }
 
 template <class Visitor>
@@ -1299,7 +1360,16 @@ MOZ_NEVER_INLINE void GraphWalker<Visitor>::DoWalk(nsDeque<PtrInfo>& aQueue) {
       for (EdgePool::Iterator child = pi->FirstChild(),
                               child_end = pi->LastChild();
            child != child_end; ++child) {
-        CheckedPush(aQueue, *child);
+        // Children that are already done would be discarded when popped, so
+        // don't queue them. A child can still be queued more than once
+        // before it is visited, which the check above handles.
+        PtrInfo* childPi = *child;
+        if (!childPi) {
+          MOZ_CRASH();
+        }
+        if (childPi->WasTraversed() && mVisitor.ShouldVisitNode(childPi)) {
+          CheckedPush(aQueue, childPi);
+        }
       }
     }
   }
@@ -2594,6 +2664,9 @@ bool nsCycleCollector::FreeSnowWhite(bool aUntilNoSWInPurpleBuffer) {
       break;
     }
   } while (aUntilNoSWInPurpleBuffer);
+  if (hadSnowWhiteObjects) {
+    PurpleBufferEntriesRemoved();
+  }
   return hadSnowWhiteObjects;
 }
 
@@ -2610,6 +2683,9 @@ bool nsCycleCollector::FreeSnowWhiteWithBudget(js::SliceBudget& aBudget) {
 
   SnowWhiteKiller visitor(this, &aBudget);
   mPurpleBuf.VisitEntries(visitor);
+  if (visitor.SawSnowWhiteObjects()) {
+    PurpleBufferEntriesRemoved();
+  }
   return visitor.SawSnowWhiteObjects();
   ;
 }
@@ -2641,6 +2717,7 @@ void nsCycleCollector::ForgetSkippable(js::SliceBudget& aBudget,
       "Don't forget skippable or free snow-white while scan is in progress.");
   mPurpleBuf.RemoveSkippable(this, aBudget, aRemoveChildlessNodes,
                              aAsyncSnowWhiteFreeing, mForgetSkippableCB);
+  PurpleBufferEntriesRemoved();
 }
 
 MOZ_NEVER_INLINE void nsCycleCollector::MarkRoots(SliceBudget& aBudget) {
@@ -2875,6 +2952,26 @@ void nsCycleCollector::ScanIncrementalRoots() {
   }
 }
 
+// Old suspects that were left in the purple buffer by a young collection may
+// still be reachable from the graph. We didn't add them as roots, so we don't
+// know everything that holds them. Treat them as live, like purple objects in
+// an incremental collection. Incremental collections don't need this, because
+// ScanIncrementalRoots already visits the whole purple buffer.
+void nsCycleCollector::ScanDeferredSuspects() {
+  TimeLog timeLog;
+
+  bool failed = false;
+  PurpleScanBlackVisitor purpleScanBlackVisitor(mGraph, mLogger,
+                                                mWhiteNodeCount, failed);
+  mPurpleBuf.VisitEntries(purpleScanBlackVisitor);
+  timeLog.Checkpoint("ScanDeferredSuspects");
+
+  if (failed) {
+    NS_ASSERTION(false, "Ran out of memory in ScanDeferredSuspects");
+    CC_TELEMETRY(_OOM, true);
+  }
+}
+
 // Mark nodes white and make sure their refcounts are ok.
 // No nodes are marked black during this pass to ensure that refcount
 // checking is run on all nodes not marked black by ScanIncrementalRoots.
@@ -2886,8 +2983,9 @@ void nsCycleCollector::ScanWhiteNodes(bool aFullySynchGraphBuild) {
       // Incremental roots can be in a nonsensical state, so don't
       // check them. This will miss checking nodes that are merely
       // reachable from incremental roots.
-      MOZ_ASSERT(!aFullySynchGraphBuild,
-                 "In a synch CC, no nodes should be marked black early on.");
+      MOZ_ASSERT(!aFullySynchGraphBuild || mDeferredSuspectCount,
+                 "In a synch CC, only deferred suspects and the nodes they "
+                 "reach should be marked black early on.");
       continue;
     }
     MOZ_ASSERT(pi->mColor == grey);
@@ -2914,17 +3012,57 @@ void nsCycleCollector::ScanWhiteNodes(bool aFullySynchGraphBuild) {
   }
 }
 
+// Count how many collections in a row each refcounted root has survived, and
+// promote long-lived ones to old suspects. See mOldSuspects.
+void nsCycleCollector::UpdateSurvivors() {
+  if (!StaticPrefs::dom_cycle_collector_generational()) {
+    return;
+  }
+
+  NodePool::Enumerator etor(mGraph.mNodes);
+  for (uint32_t i = 0; i < mGraph.mRootCount; ++i) {
+    PtrInfo* pi = etor.GetNext();
+    if (!pi->mParticipant || pi->IsGrayJS()) {
+      continue;
+    }
+
+    if (pi->mColor != black) {
+      mSurvivorCounts.remove(pi->mPointer);
+      continue;
+    }
+
+    auto p = mSurvivorCounts.lookupForAdd(pi->mPointer);
+    if (!p) {
+      if (!mSurvivorCounts.add(p, pi->mPointer, 1)) {
+        return;
+      }
+      continue;
+    }
+    if (++p->value() >= kSurvivalsBeforePromotion) {
+      mSurvivorCounts.remove(p);
+      if (!mOldSuspects.put(pi->mPointer)) {
+        return;
+      }
+    }
+  }
+}
+
 // Any remaining grey nodes that haven't already been deleted must be alive,
 // so mark them and their children black. Any nodes that are black must have
 // already had their children marked black, so there's no need to look at them
 // again. This pass may turn some white nodes to black.
 void nsCycleCollector::ScanBlackNodes() {
   bool failed = false;
+  // Most live nodes are grey at this point, so share one walker and its queue
+  // between them rather than setting one up per node.
+  GraphWalker<ScanBlackVisitor> walker(
+      ScanBlackVisitor(mWhiteNodeCount, failed));
   NodePool::Enumerator nodeEnum(mGraph.mNodes);
   while (!nodeEnum.IsDone()) {
     PtrInfo* pi = nodeEnum.GetNext();
     if (pi->mColor == grey && pi->WasTraversed()) {
-      FloodBlackNode(mWhiteNodeCount, failed, pi);
+      walker.Walk(pi);
+      MOZ_ASSERT(pi->mColor == black, "Walk should make pi black");
     }
   }
 
@@ -2946,6 +3084,8 @@ void nsCycleCollector::ScanRoots(bool aFullySynchGraphBuild) {
 
   if (!aFullySynchGraphBuild) {
     ScanIncrementalRoots();
+  } else if (mDeferredSuspectCount) {
+    ScanDeferredSuspects();
   }
 
   TimeLog timeLog;
@@ -2959,6 +3099,9 @@ void nsCycleCollector::ScanRoots(bool aFullySynchGraphBuild) {
   ScanWeakMaps();
   timeLog.Checkpoint("ScanRoots::ScanWeakMaps");
 
+  UpdateSurvivors();
+  timeLog.Checkpoint("ScanRoots::UpdateSurvivors");
+
   if (mLogger) {
     mLogger->BeginResults();
 
@@ -3149,7 +3292,10 @@ nsCycleCollector::nsCycleCollector()
       mBeforeUnlinkCB(nullptr),
       mForgetSkippableCB(nullptr),
       mUnmergedNeeded(0),
-      mMergedInARow(0) {
+      mMergedInARow(0),
+      mYoungCollectionsInARow(0),
+      mLastFullCollection(TimeStamp::Now()),
+      mDeferredSuspectCount(0) {
 }
 
 nsCycleCollector::~nsCycleCollector() {
@@ -3617,20 +3763,53 @@ void nsCycleCollector::BeginCollection(
   AutoRestore<bool> ar(mScanInProgress);
   MOZ_RELEASE_ASSERT(!mScanInProgress);
   mScanInProgress = true;
-  mPurpleBuf.SelectPointers(*mBuilder);
+  // Logs are expected to be complete, so always do a full collection when
+  // there is a logger.
+  bool isFull =
+      aIsManual == CCIsManual || isShutdown || mLogger || NextCollectionIsFull();
+  if (isFull) {
+    mYoungCollectionsInARow = 0;
+    mLastFullCollection = TimeStamp::Now();
+    mSurvivorCounts.clear();
+    mOldSuspects.clear();
+  } else {
+    ++mYoungCollectionsInARow;
+  }
+  mDeferredSuspectCount =
+      mPurpleBuf.SelectPointers(*mBuilder, isFull ? nullptr : &mOldSuspects);
   timeLog.Checkpoint("SelectPointers()");
 
   mBuilder->DoneAddingRoots();
   mIncrementalPhase = GraphBuildingPhase;
 }
 
+// Whether the next collection that isn't manual, logged or at shutdown will
+// scan the old suspects too.
+bool nsCycleCollector::NextCollectionIsFull() const {
+  // Garbage rooted by old suspects doesn't add to SuspectedCount(), so on a
+  // page that is otherwise idle there may never be enough young collections to
+  // reach a full one. Bound how much and how long deferred suspects can wait.
+  return !StaticPrefs::dom_cycle_collector_generational() ||
+         mYoungCollectionsInARow >= kMaxYoungCollectionsInARow ||
+         mDeferredSuspectCount >= kMaxDeferredSuspects ||
+         (TimeStamp::Now() - mLastFullCollection).ToSeconds() >=
+             kMaxSecondsBetweenFullCollections;
+}
+
 uint32_t nsCycleCollector::SuspectedCount() {
   CheckThreadSafety();
+  // Old suspects left in the purple buffer don't make a young collection any
+  // more worthwhile. Once the next collection is going to be full they count
+  // again, so that the scheduler eventually runs it.
+  uint32_t count = mPurpleBuf.Count();
+  if (!NextCollectionIsFull()) {
+    count -= std::min(count, mDeferredSuspectCount);
+  }
   if (NS_IsMainThread()) {
-    return gNurseryPurpleBufferEntryCount + mPurpleBuf.Count();
+    return gNurseryPurpleBufferEntryCount + count;
   }
 
-  return mPurpleBuf.Count();
+  return count;
 }
 
 void nsCycleCollector::Shutdown(bool aDoCollect) {
@@ -3667,7 +3846,9 @@ void nsCycleCollector::SizeOfIncludingThis(mozilla::MallocSizeOf aMallocSizeOf,
                                            size_t* aObjectSize,
                                            size_t* aGraphSize,
                                            size_t* aPurpleBufferSize) const {
-  *aObjectSize = aMallocSizeOf(this);
+  *aObjectSize = aMallocSizeOf(this) +
+                 mSurvivorCounts.shallowSizeOfExcludingThis(aMallocSizeOf) +
+                 mOldSuspects.shallowSizeOfExcludingThis(aMallocSizeOf);
 
   *aGraphSize = mGraph.SizeOfExcludingThis(aMallocSizeOf);
 
@@ -460,6 +460,16 @@ NS_InitXPCOM(nsIServiceManager** aResult, nsIFile* aBinDirectory,
   RegisterStrongMemoryReporter(new OggReporter());
   xpc::SelfHostedShmem::GetSingleton().InitMemoryReporter();
 
+  // Start inflating what the rest of startup is going to read from the
+  // omnijar. This registers a memory reporter, and an observer that frees
+  // what's left once startup is over, so it needs both services up.
+  if (XRE_IsParentProcess()) {
+    if (RefPtr<nsZipArchive> reader =
+            mozilla::Omnijar::GetReader(mozilla::Omnijar::GRE)) {
+      reader->PreinflateStartupItems();
+    }
+  }
+
   mozilla::Telemetry::Init();
 
   mozilla::BackgroundHangMonitor::Startup();
@@ -132,6 +132,12 @@ struct StaticModule {
 
   nsISupports* ServiceInstance() const;
   void SetServiceInstance(already_AddRefed<nsISupports> aInst) const;
+
+  /**
+   * Returns the same as ServiceInstance(), but may be called without holding
+   * the component manager lock.
+   */
+  nsISupports* CachedServiceInstance() const;
 };
 
 /**
@@ -235,6 +241,14 @@ class StaticComponents final {
 
   static const StaticModule* LookupByContractID(const nsACString& aContractID);
 
+  /**
+   * Like LookupByContractID, but may be called without holding the component
+   * manager lock. Once any static contract ID has been overridden at runtime
+   * this always returns null, and callers must take the locked path.
+   */
+  static const StaticModule* LookupByContractIDUnlocked(
+      const nsACString& aContractID);
+
   /**
    * Marks a static contract ID entry invalid (or unsets the invalid bit if
    * aInvalid is false). See `CategoryEntry::Invalid()`.
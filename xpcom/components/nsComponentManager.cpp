@@ -1047,6 +1047,14 @@ nsresult nsComponentManagerImpl::GetService(ModuleID aId, const nsIID& aIID,
     return NS_ERROR_UNEXPECTED;
   }
 
+  // A service that can't be overridden never changes once it exists, so
+  // there's no need for the lock to hand it out.
+  if (!entry.Overridable()) {
+    if (nsISupports* service = entry.CachedServiceInstance()) {
+      return service->QueryInterface(aIID, aResult);
+    }
+  }
+
   Maybe<MonitorAutoLock> lock(std::in_place, mLock);
 
   Maybe<EntryWrapper> wrapper;
@@ -1151,12 +1159,22 @@ nsComponentManagerImpl::GetServiceByContractID(const char* aContractID,
     return NS_ERROR_UNEXPECTED;
   }
 
+  nsDependentCString contractID(aContractID);
+
+  // Most calls are for static services that are already running, which only
+  // need a QueryInterface.
+  if (const StaticModule* module =
+          StaticComponents::LookupByContractIDUnlocked(contractID)) {
+    if (nsISupports* service = module->CachedServiceInstance()) {
+      return service->QueryInterface(aIID, aResult);
+    }
+  }
+
   AUTO_PROFILER_LABEL_DYNAMIC_CSTR_NONSENSITIVE("GetServiceByContractID", OTHER,
                                                 aContractID);
   Maybe<MonitorAutoLock> lock(std::in_place, mLock);
 
-  Maybe<EntryWrapper> entry =
-      LookupByContractID(*lock, nsDependentCString(aContractID));
+  Maybe<EntryWrapper> entry = LookupByContractID(*lock, contractID);
   if (!entry) {
     return NS_ERROR_FACTORY_NOT_REGISTERED;
   }
@@ -20,6 +20,13 @@
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/ChaosMode.h"
+#include "mozilla/SSE.h"
+
+#if defined(MOZILLA_PRESUME_SSE2)
+#  include <emmintrin.h>
+#elif defined(__aarch64__)
+#  include <arm_neon.h>
+#endif
 
 using namespace mozilla;
 
@@ -240,27 +247,6 @@ PLDHashNumber PLDHashTable::Hash1(PLDHashNumber aHash0) const {
   return aHash0 >> mHashShift;
 }
 
-void PLDHashTable::Hash2(PLDHashNumber aHash0, uint32_t& aHash2Out,
-                         uint32_t& aSizeMaskOut) const {
-  uint32_t sizeLog2 = kPLDHashNumberBits - mHashShift;
-  uint32_t sizeMask = (PLDHashNumber(1) << sizeLog2) - 1;
-  aSizeMaskOut = sizeMask;
-
-  // The incoming aHash0 always has the low bit unset (since we leave it
-  // free for the collision flag), and should have reasonably random
-  // data in the other 31 bits.  We used the high bits of aHash0 for
-  // Hash1, so we use the low bits here.  If the table size is large,
-  // the bits we use may overlap, but that's still more random than
-  // filling with 0s.
-  //
-  // Double hashing needs the second hash code to be relatively prime to table
-  // size, so we simply make hash2 odd.
-  //
-  // This also conveniently covers up the fact that we have the low bit
-  // unset since aHash0 has the low bit unset.
-  aHash2Out = (aHash0 & sizeMask) | 1;
-}
-
 // Reserve mKeyHash 0 for free entries and 1 for removed-entry sentinels. Note
 // that a removed-entry sentinel need be stored only if the removed entry had
 // a colliding entry added after it. Therefore we can use 1 as the collision
@@ -311,12 +297,55 @@ void PLDHashTable::ClearAndPrepareForLength(uint32_t aLength) {
 
 void PLDHashTable::Clear() { ClearAndPrepareForLength(kDefaultInitialLength); }
 
+// Slots are probed a group of kGroupSize adjacent cached hashes at a time, so
+// that each step of a probe touches a single 16-byte run of the hash array and
+// can test every slot in it with a couple of vector compares. The capacity is
+// always a multiple of kGroupSize.
+static const uint32_t kGroupSize = 4;
+static_assert(PLDHashTable::kMinCapacity % kGroupSize == 0,
+              "The capacity must be a whole number of groups");
+
+// Return a mask with bit i set if (aHashes[i] & ~aIgnoredBits) == aValue, for
+// each of the kGroupSize hashes starting at aHashes.
+static MOZ_ALWAYS_INLINE uint32_t MatchGroup(const PLDHashNumber* aHashes,
+                                             PLDHashNumber aValue,
+                                             PLDHashNumber aIgnoredBits) {
+#if defined(MOZILLA_PRESUME_SSE2)
+  __m128i hashes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aHashes));
+  hashes = _mm_andnot_si128(_mm_set1_epi32(aIgnoredBits), hashes);
+  __m128i eq = _mm_cmpeq_epi32(hashes, _mm_set1_epi32(aValue));
+  return _mm_movemask_ps(_mm_castsi128_ps(eq));
+#elif defined(__aarch64__)
+  static const uint32_t kLaneBits[kGroupSize] = {1, 2, 4, 8};
+  uint32x4_t hashes = vld1q_u32(aHashes);
+  hashes = vbicq_u32(hashes, vdupq_n_u32(aIgnoredBits));
+  uint32x4_t eq = vceqq_u32(hashes, vdupq_n_u32(aValue));
+  return vaddvq_u32(vandq_u32(eq, vld1q_u32(kLaneBits)));
+#else
+  uint32_t mask = 0;
+  for (uint32_t i = 0; i < kGroupSize; i++) {
+    if ((aHashes[i] & ~aIgnoredBits) == aValue) {
+      mask |= 1 << i;
+    }
+  }
+  return mask;
+#endif
+}
+
 // If |Reason| is |ForAdd|, the return value is always non-null and it may be
 // a previously-removed entry. If |Reason| is |ForSearchOrRemove|, the return
 // value is null on a miss, and will never be a previously-removed entry on a
 // hit. This distinction is a bit grotty but this function is hot enough that
 // these differences are worthwhile. (It's also hot enough that
 // MOZ_ALWAYS_INLINE makes a significant difference.)
+//
+// Groups are visited in triangular order starting from the group containing
+// the primary hash address, which visits every group once because the number
+// of groups is a power of two. A key is always stored in the first group of
+// its probe sequence that had a free or removed slot when it was added, so a
+// search can stop at the first group with a free slot. Add() marks every slot
+// of a full group it passes over as colliding, which keeps RawRemove() from
+// freeing a slot in such a group.
 template <PLDHashTable::SearchReason Reason, typename Success, typename Failure>
 MOZ_ALWAYS_INLINE auto PLDHashTable::SearchTable(const void* aKey,
                                                  PLDHashNumber aKeyHash,
@@ -325,59 +354,51 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::SearchTable(const void* aKey,
   MOZ_ASSERT(mEntryStore.IsAllocated());
   NS_ASSERTION(!(aKeyHash & kCollisionFlag), "!(aKeyHash & kCollisionFlag)");
 
-  // Compute the primary hash address.
-  PLDHashNumber hash1 = Hash1(aKeyHash);
-  Slot slot = SlotForIndex(hash1);
-
-  // Miss: return space for a new entry.
-  if (slot.IsFree()) {
-    return (Reason == ForAdd) ? aSuccess(slot) : aFailure();
-  }
-
-  // Hit: return entry.
+  auto hashes = reinterpret_cast<PLDHashNumber*>(mEntryStore.Get());
+  uint32_t groupMask = CapacityFromHashShift() / kGroupSize - 1;
+  uint32_t group = Hash1(aKeyHash) / kGroupSize;
   PLDHashMatchEntry matchEntry = mOps->matchEntry;
-  if (MatchSlotKeyhash(slot, aKeyHash)) {
-    PLDHashEntryHdr* e = slot.ToEntry();
-    if (matchEntry(e, aKey)) {
-      return aSuccess(slot);
-    }
-  }
-
-  // Collision: double hash.
-  PLDHashNumber hash2;
-  uint32_t sizeMask;
-  Hash2(aKeyHash, hash2, sizeMask);
 
   // Save the first removed entry slot so Add() can recycle it. (Only used
   // if Reason==ForAdd.)
   Maybe<Slot> firstRemoved;
 
-  for (;;) {
-    if (Reason == ForAdd && !firstRemoved) {
-      if (MOZ_UNLIKELY(slot.IsRemoved())) {
-        firstRemoved.emplace(slot);
-      } else {
-        slot.MarkColliding();
+  for (uint32_t step = 1;; step++) {
+    uint32_t base = group * kGroupSize;
+    PLDHashNumber* groupHashes = hashes + base;
+
+    // Hit: return entry.
+    for (uint32_t matches = MatchGroup(groupHashes, aKeyHash, kCollisionFlag);
+         matches; matches &= matches - 1) {
+      Slot slot = SlotForIndex(base + CountTrailingZeroes32(matches));
+      if (matchEntry(slot.ToEntry(), aKey)) {
+        return aSuccess(slot);
       }
     }
 
-    hash1 -= hash2;
-    hash1 &= sizeMask;
+    uint32_t freeSlots = MatchGroup(groupHashes, 0, 0);
+    if (Reason == ForAdd && !firstRemoved) {
+      if (uint32_t removedSlots = MatchGroup(groupHashes, 1, 0)) {
+        firstRemoved.emplace(
+            SlotForIndex(base + CountTrailingZeroes32(removedSlots)));
+      } else if (!freeSlots) {
+        for (uint32_t i = 0; i < kGroupSize; i++) {
+          groupHashes[i] |= kCollisionFlag;
+        }
+      }
+    }
 
-    slot = SlotForIndex(hash1);
-    if (slot.IsFree()) {
+    // Miss: return space for a new entry.
+    if (freeSlots) {
       if (Reason != ForAdd) {
         return aFailure();
       }
+      Slot slot = SlotForIndex(base + CountTrailingZeroes32(freeSlots));
       return aSuccess(firstRemoved.refOr(slot));
     }
 
-    if (MatchSlotKeyhash(slot, aKeyHash)) {
-      PLDHashEntryHdr* e = slot.ToEntry();
-      if (matchEntry(e, aKey)) {
-        return aSuccess(slot);
-      }
-    }
+    // Collision: probe the next group.
+    group = (group + step) & groupMask;
   }
 
   // NOTREACHED
@@ -396,31 +417,25 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::FindFreeSlot(PLDHashNumber aKeyHash) const
   MOZ_ASSERT(mEntryStore.IsAllocated());
   NS_ASSERTION(!(aKeyHash & kCollisionFlag), "!(aKeyHash & kCollisionFlag)");
 
-  // Compute the primary hash address.
-  PLDHashNumber hash1 = Hash1(aKeyHash);
-  Slot slot = SlotForIndex(hash1);
+  auto hashes = reinterpret_cast<PLDHashNumber*>(mEntryStore.Get());
+  uint32_t groupMask = CapacityFromHashShift() / kGroupSize - 1;
+  uint32_t group = Hash1(aKeyHash) / kGroupSize;
 
-  // Miss: return space for a new entry.
-  if (slot.IsFree()) {
-    return slot;
-  }
-
-  // Collision: double hash.
-  PLDHashNumber hash2;
-  uint32_t sizeMask;
-  Hash2(aKeyHash, hash2, sizeMask);
+  for (uint32_t step = 1;; step++) {
+    uint32_t base = group * kGroupSize;
+    PLDHashNumber* groupHashes = hashes + base;
+    MOZ_ASSERT(!MatchGroup(groupHashes, 1, 0));
 
-  for (;;) {
-    MOZ_ASSERT(!slot.IsRemoved());
-    slot.MarkColliding();
-
-    hash1 -= hash2;
-    hash1 &= sizeMask;
+    // Miss: return space for a new entry.
+    if (uint32_t freeSlots = MatchGroup(groupHashes, 0, 0)) {
+      return SlotForIndex(base + CountTrailingZeroes32(freeSlots));
+    }
 
-    slot = SlotForIndex(hash1);
-    if (slot.IsFree()) {
-      return slot;
+    // Collision: probe the next group.
+    for (uint32_t i = 0; i < kGroupSize; i++) {
+      groupHashes[i] |= kCollisionFlag;
     }
+    group = (group + step) & groupMask;
   }
 
   // NOTREACHED
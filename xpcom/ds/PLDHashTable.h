@@ -202,13 +202,18 @@ class Checker {
 // common.
 //
 // There used to be a long, math-heavy comment here about the merits of
-// double hashing vs. chaining; it was removed in bug 1058335. In short, double
-// hashing is more space-efficient unless the element size gets large (in which
-// case you should keep using double hashing but switch to using pointer
-// elements). Also, with double hashing, you can't safely hold an entry pointer
+// open addressing vs. chaining; it was removed in bug 1058335. In short, open
+// addressing is more space-efficient unless the element size gets large (in
+// which case you should keep using open addressing but switch to using pointer
+// elements). Also, with open addressing, you can't safely hold an entry pointer
 // and use it after an add or remove operation, unless you sample Generation()
 // before adding or removing, and compare the sample after, dereferencing the
 // entry pointer only if Generation() has not changed.
+//
+// Lookups probe the cached hashes a group of four adjacent slots at a time,
+// comparing the whole group at once with SIMD where it is available. Only
+// slots whose cached hash matches have their entries looked at, so a probe
+// mostly touches the compact hash array rather than the entries.
 class PLDHashTable {
  private:
   // A slot represents a cached hash value and its associated entry stored in
@@ -703,8 +708,6 @@ class PLDHashTable {
   static const PLDHashNumber kCollisionFlag = 1;
 
   PLDHashNumber Hash1(PLDHashNumber aHash0) const;
-  void Hash2(PLDHashNumber aHash, uint32_t& aHash2Out,
-             uint32_t& aSizeMaskOut) const;
 
   static bool MatchSlotKeyhash(Slot& aSlot, const PLDHashNumber aHash);
   Slot SlotForIndex(uint32_t aIndex) const;
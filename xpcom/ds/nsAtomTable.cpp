@@ -40,7 +40,10 @@
 //   immutable, so it ignores all AddRef/Release calls.
 //
 // Note that gAtomTable is used on multiple threads, and has internal
-// synchronization.
+// synchronization. Static atoms are all registered at startup, before any
+// other thread can atomize, and never change afterwards, so they live in a
+// separate immutable table that is searched without locking. Only strings that
+// don't name a static atom take a subtable lock.
 
 using namespace mozilla;
 
@@ -208,7 +211,9 @@ class nsAtomSubTable {
 // subtables.
 class nsAtomTable {
  public:
+  nsAtomTable();
   nsAtomSubTable& SelectSubTable(AtomTableKey& aKey);
+  nsStaticAtom* SearchStaticAtoms(AtomTableKey& aKey) const;
   void AddSizeOfIncludingThis(MallocSizeOf aMallocSizeOf, AtomsSizes& aSizes);
   void GC(GCKind aKind);
   already_AddRefed<nsAtom> Atomize(const nsAString& aUTF16String);
@@ -258,6 +263,11 @@ class nsAtomTable {
 
  private:
   nsAtomSubTable mSubTables[kNumSubTables];
+
+  // The static atoms. This is filled in by RegisterStaticAtoms() on the main
+  // thread and is immutable afterwards, so it can be read from any thread
+  // without a lock.
+  PLDHashTable mStaticAtoms;
 };
 
 // Static singleton instance for the atom table.
@@ -316,6 +326,14 @@ static const PLDHashTableOps AtomTableOps = {
 // subtable.
 #define INITIAL_SUBTABLE_LENGTH (4096 / nsAtomTable::kNumSubTables)
 
+nsAtomTable::nsAtomTable()
+    : mStaticAtoms(&AtomTableOps, sizeof(AtomTableEntry)) {}
+
+nsStaticAtom* nsAtomTable::SearchStaticAtoms(AtomTableKey& aKey) const {
+  auto he = static_cast<AtomTableEntry*>(mStaticAtoms.Search(&aKey));
+  return he ? static_cast<nsStaticAtom*>(he->mAtom) : nullptr;
+}
+
 nsAtomSubTable& nsAtomTable::SelectSubTable(AtomTableKey& aKey) {
   // There are a few considerations around how we select subtables.
   //
@@ -343,6 +361,7 @@ void nsAtomTable::AddSizeOfIncludingThis(MallocSizeOf aMallocSizeOf,
                                          AtomsSizes& aSizes) {
   MOZ_ASSERT(NS_IsMainThread());
   aSizes.mTable += aMallocSizeOf(this);
+  aSizes.mTable += mStaticAtoms.ShallowSizeOfExcludingThis(aMallocSizeOf);
   for (auto& table : mSubTables) {
     MutexAutoLock lock(table.mLock);
     table.AddSizeOfExcludingThisLocked(aMallocSizeOf, aSizes);
@@ -387,7 +406,7 @@ void nsAtomTable::GC(GCKind aKind) {
 size_t nsAtomTable::RacySlowCount() {
   // Trigger a GC so that the result is deterministic modulo other threads.
   GC(GCKind::RegularOperation);
-  size_t count = 0;
+  size_t count = mStaticAtoms.EntryCount();
   for (auto& table : mSubTables) {
     MutexAutoLock lock(table.mLock);
     count += table.mTable.EntryCount();
@@ -409,12 +428,9 @@ void nsAtomSubTable::GCLocked(GCKind aKind) {
   uint32_t nonZeroRefcountAtomsCount = 0;
   for (auto i = mTable.Iter(); !i.Done(); i.Next()) {
     auto entry = static_cast<AtomTableEntry*>(i.Get());
-    if (entry->mAtom->IsStatic()) {
-      continue;
-    }
-
     nsAtom* atom = entry->mAtom;
-    if (atom->IsDynamic() && atom->AsDynamic()->mRefCnt == 0) {
+    MOZ_ASSERT(atom->IsDynamic(), "Static atoms live in mStaticAtoms");
+    if (atom->AsDynamic()->mRefCnt == 0) {
       i.Remove();
       nsDynamicAtom::Destroy(atom->AsDynamic());
       ++removedCount;
@@ -504,6 +520,8 @@ void nsAtomTable::RegisterStaticAtoms(const nsStaticAtom* aAtoms,
   MOZ_ASSERT(NS_IsMainThread());
   MOZ_RELEASE_ASSERT(!gStaticAtomsDone, "Static atom insertion is finished!");
 
+  mStaticAtoms.ClearAndPrepareForLength(aAtomsLen);
+
   for (uint32_t i = 0; i < aAtomsLen; ++i) {
     const nsStaticAtom* atom = &aAtoms[i];
     MOZ_ASSERT(IsAsciiNullTerminated(atom->String()));
@@ -517,23 +535,21 @@ void nsAtomTable::RegisterStaticAtoms(const nsStaticAtom* aAtoms,
     MOZ_ASSERT(HashString(atom->String()) == atom->hash());
 
     AtomTableKey key(atom);
-    nsAtomSubTable& table = SelectSubTable(key);
-    MutexAutoLock lock(table.mLock);
-    AtomTableEntry* he = table.Add(key);
+    auto he = static_cast<AtomTableEntry*>(mStaticAtoms.Add(&key));
 
     if (he->mAtom) {
-      // There are two ways we could get here.
-      // - Register two static atoms with the same string.
-      // - Create a dynamic atom and then register a static atom with the same
-      //   string while the dynamic atom is alive.
-      // Both cases can cause subtle bugs, and are disallowed. We're
-      // programming in C++ here, not Smalltalk.
+      // We get here if two static atoms are registered with the same string.
+      // That can cause subtle bugs, and is disallowed. We're programming in
+      // C++ here, not Smalltalk. (No dynamic atoms can exist yet, because
+      // static atoms are registered as soon as the table is created.)
       nsAutoCString name;
       he->mAtom->ToUTF8String(name);
       MOZ_CRASH_UNSAFE_PRINTF("Atom for '%s' already exists", name.get());
     }
     he->mAtom = const_cast<nsStaticAtom*>(atom);
   }
+
+  mStaticAtoms.MarkImmutable();
 }
 
 already_AddRefed<nsAtom> NS_Atomize(const char* aUTF8String) {
@@ -552,6 +568,11 @@ already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsACString& aUTF8String) {
     CopyUTF8toUTF16(aUTF8String, str);
     return Atomize(str);
   }
+  if (nsStaticAtom* staticAtom = SearchStaticAtoms(key)) {
+    RefPtr<nsAtom> atom = staticAtom;
+    return atom.forget();
+  }
+
   nsAtomSubTable& table = SelectSubTable(key);
   MutexAutoLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
@@ -582,6 +603,11 @@ already_AddRefed<nsAtom> NS_Atomize(const char16_t* aUTF16String) {
 
 already_AddRefed<nsAtom> nsAtomTable::Atomize(const nsAString& aUTF16String) {
   AtomTableKey key(aUTF16String.Data(), aUTF16String.Length());
+  if (nsStaticAtom* staticAtom = SearchStaticAtoms(key)) {
+    RefPtr<nsAtom> atom = staticAtom;
+    return atom.forget();
+  }
+
   nsAtomSubTable& table = SelectSubTable(key);
   MutexAutoLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
@@ -614,6 +640,12 @@ already_AddRefed<nsAtom> nsAtomTable::AtomizeMainThread(
     return retVal.forget();
   }
 
+  if (nsStaticAtom* staticAtom = SearchStaticAtoms(key)) {
+    retVal = staticAtom;
+    p.Set(retVal);
+    return retVal.forget();
+  }
+
   nsAtomSubTable& table = SelectSubTable(key);
   MutexAutoLock lock(table.mLock);
   AtomTableEntry* he = table.Add(key);
@@ -651,11 +683,7 @@ nsStaticAtom* NS_GetStaticAtom(const nsAString& aUTF16String) {
 
 nsStaticAtom* nsAtomTable::GetStaticAtom(const nsAString& aUTF16String) {
   AtomTableKey key(aUTF16String.Data(), aUTF16String.Length());
-  nsAtomSubTable& table = SelectSubTable(key);
-  MutexAutoLock lock(table.mLock);
-  AtomTableEntry* he = table.Search(key);
-  return he && he->mAtom->IsStatic() ? static_cast<nsStaticAtom*>(he->mAtom)
-                                     : nullptr;
+  return SearchStaticAtoms(key);
 }
 
 void ToLowerCaseASCII(RefPtr<nsAtom>& aAtom) {
@@ -9,6 +9,7 @@
 #endif
 
 #include "mozilla/Atomics.h"
+#include "mozilla/ArrayUtils.h"
 #include "mozilla/MemoryReporting.h"
 
 #ifdef ENABLE_STRING_STATS
@@ -23,6 +24,7 @@
 #include "nsMemory.h"
 #include "prprf.h"
 #include "nsCOMPtr.h"
+#include "MainThreadUtils.h"
 
 #include "mozilla/IntegerPrintfMacros.h"
 #ifdef XP_WIN
@@ -154,6 +156,58 @@ class nsACStringAccessor : public nsACString {
 
 // ---------------------------------------------------------------------------
 
+// The main thread allocates and frees huge numbers of tiny string buffers, so
+// it keeps a few recently freed ones of each of the smallest size classes and
+// reuses them instead of going back to malloc. Only buffers whose malloc size
+// is exactly a class size are kept, so a reused buffer is the same size as a
+// fresh one. This is disabled under the sanitizers and Valgrind, where reuse
+// would hide use-after-free bugs.
+#if !defined(MOZ_ASAN) && !defined(MOZ_MSAN) && !defined(MOZ_TSAN) && \
+    !defined(MOZ_VALGRIND)
+#  define STRING_BUFFER_CACHE
+#endif
+
+#ifdef STRING_BUFFER_CACHE
+static const size_t kCachedBufferSizes[] = {16, 32, 64};
+static const size_t kNumCachedBufferSizes =
+    mozilla::ArrayLength(kCachedBufferSizes);
+static const uint32_t kMaxCachedBuffersPerSize = 32;
+
+static nsStringBuffer* gCachedBuffers[kNumCachedBufferSizes]
+                                     [kMaxCachedBuffersPerSize];
+static uint32_t gCachedBufferCounts[kNumCachedBufferSizes];
+
+// Return the index of the cached buffer size class aSize, or -1.
+static int CachedBufferClass(size_t aSize) {
+  for (size_t i = 0; i < kNumCachedBufferSizes; i++) {
+    if (aSize == kCachedBufferSizes[i]) {
+      return int(i);
+    }
+  }
+  return -1;
+}
+
+static nsStringBuffer* TakeCachedBuffer(size_t aSize) {
+  int sizeClass = CachedBufferClass(aSize);
+  if (sizeClass < 0 || !gCachedBufferCounts[sizeClass] || !NS_IsMainThread()) {
+    return nullptr;
+  }
+  return gCachedBuffers[sizeClass][--gCachedBufferCounts[sizeClass]];
+}
+
+// Returns true if aBuffer was kept for reuse, rather than needing to be freed.
+static bool CacheBuffer(nsStringBuffer* aBuffer, size_t aSize) {
+  int sizeClass = CachedBufferClass(aSize);
+  if (sizeClass < 0 ||
+      gCachedBufferCounts[sizeClass] == kMaxCachedBuffersPerSize ||
+      !NS_IsMainThread()) {
+    return false;
+  }
+  gCachedBuffers[sizeClass][gCachedBufferCounts[sizeClass]++] = aBuffer;
+  return true;
+}
+#endif
+
 void nsStringBuffer::AddRef() {
   // Memory synchronization is not required when incrementing a
   // reference count.  The first increment of a reference count on a
@@ -190,6 +244,11 @@ void nsStringBuffer::Release() {
     count = mRefCount.load(std::memory_order_acquire);
 
     STRING_STAT_INCREMENT(Free);
+#ifdef STRING_BUFFER_CACHE
+    if (CacheBuffer(this, sizeof(nsStringBuffer) + mStorageSize)) {
+      return;
+    }
+#endif
     free(this);  // we were allocated with |malloc|
   }
 }
@@ -203,7 +262,14 @@ already_AddRefed<nsStringBuffer> nsStringBuffer::Alloc(size_t aSize) {
                    sizeof(nsStringBuffer) + aSize > aSize,
                "mStorageSize will truncate");
 
-  nsStringBuffer* hdr = (nsStringBuffer*)malloc(sizeof(nsStringBuffer) + aSize);
+  size_t size = sizeof(nsStringBuffer) + aSize;
+  nsStringBuffer* hdr = nullptr;
+#ifdef STRING_BUFFER_CACHE
+  hdr = TakeCachedBuffer(size);
+#endif
+  if (!hdr) {
+    hdr = (nsStringBuffer*)malloc(size);
+  }
   if (hdr) {
     STRING_STAT_INCREMENT(Alloc);
 
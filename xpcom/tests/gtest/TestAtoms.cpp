@@ -7,6 +7,7 @@
 #include "mozilla/ArrayUtils.h"
 
 #include "nsAtom.h"
+#include "nsGkAtoms.h"
 #include "nsString.h"
 #include "UTFStrings.h"
 #include "nsIThread.h"
@@ -175,4 +176,43 @@ TEST(Atoms, ConcurrentAccessing)
   EXPECT_EQ(NS_GetUnusedAtomCount(), int32_t(1));
 }
 
+class nsStaticAtomRunner final : public Runnable {
+ public:
+  NS_IMETHOD Run() final {
+    for (int i = 0; i < 10000; i++) {
+      RefPtr<nsAtom> atom16 = NS_Atomize(u"div");
+      RefPtr<nsAtom> atom8 = NS_Atomize("div");
+      if (atom16 != nsGkAtoms::div || atom8 != nsGkAtoms::div ||
+          NS_GetStaticAtom(u"div"_ns) != nsGkAtoms::div) {
+        mFailed = true;
+      }
+    }
+    return NS_OK;
+  }
+
+  nsStaticAtomRunner() : Runnable("nsStaticAtomRunner") {}
+
+  bool mFailed = false;
+
+ private:
+  ~nsStaticAtomRunner() = default;
+};
+
+TEST(Atoms, ConcurrentStaticAtoms)
+{
+  static const size_t kThreadCount = 4;
+  RefPtr<nsStaticAtomRunner> runners[kThreadCount];
+  nsCOMPtr<nsIThread> threads[kThreadCount];
+  for (size_t i = 0; i < kThreadCount; i++) {
+    runners[i] = new nsStaticAtomRunner;
+    nsresult rv = NS_NewNamedThread("Atom Test", getter_AddRefs(threads[i]),
+                                    runners[i]);
+    EXPECT_TRUE(NS_SUCCEEDED(rv));
+  }
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads[i]->Shutdown();
+    EXPECT_FALSE(runners[i]->mFailed);
+  }
+}
+
 }  // namespace TestAtoms
@@ -0,0 +1,103 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "js/SliceBudget.h"
+#include "mozilla/Preferences.h"
+#include "nsCycleCollectionParticipant.h"
+#include "nsCycleCollector.h"
+#include "nsISupportsImpl.h"
+
+#include "gtest/gtest.h"
+
+using namespace mozilla;
+
+class TestCCObject final : public nsISupports {
+ public:
+  NS_DECL_CYCLE_COLLECTING_ISUPPORTS
+  NS_DECL_CYCLE_COLLECTION_CLASS(TestCCObject)
+
+  // AddRef and Release leave the object purple, in the purple buffer.
+  void Suspect() {
+    AddRef();
+    Release();
+  }
+
+  bool IsSuspected() const { return mRefCnt.IsInPurpleBuffer(); }
+
+ private:
+  ~TestCCObject() = default;
+};
+
+NS_IMPL_CYCLE_COLLECTION_0(TestCCObject)
+
+NS_IMPL_CYCLE_COLLECTING_ADDREF(TestCCObject)
+NS_IMPL_CYCLE_COLLECTING_RELEASE(TestCCObject)
+
+NS_INTERFACE_MAP_BEGIN_CYCLE_COLLECTION(TestCCObject)
+  NS_INTERFACE_MAP_ENTRY(nsISupports)
+NS_INTERFACE_MAP_END
+
+static void YoungCollection() {
+  js::SliceBudget budget = js::SliceBudget::unlimited();
+  nsCycleCollector_collectSlice(budget, CCReason::TIMED);
+}
+
+TEST(CycleCollector, DeferredSuspects)
+{
+  // A manual collection is always full, so the young collections below
+  // aren't interrupted by a periodic full one.
+  nsCycleCollector_collect(CCReason::API, nullptr);
+
+  RefPtr<TestCCObject> a = new TestCCObject();
+
+  // |a| stays alive through three collections in a row, so it is promoted.
+  for (int i = 0; i < 3; i++) {
+    a->Suspect();
+    ASSERT_TRUE(a->IsSuspected());
+    YoungCollection();
+    ASSERT_FALSE(a->IsSuspected());
+  }
+
+  // The next young collection leaves it in the purple buffer, and it isn't
+  // counted as a suspect.
+  a->Suspect();
+  YoungCollection();
+  ASSERT_TRUE(a->IsSuspected());
+  nsCycleCollector_doDeferredDeletion();
+  uint32_t count = nsCycleCollector_suspectedCount();
+
+  RefPtr<TestCCObject> b = new TestCCObject();
+  b->Suspect();
+  EXPECT_EQ(nsCycleCollector_suspectedCount(), count + 1);
+
+  // Freeing |a| removes it from the purple buffer. The deferred count must
+  // not then be subtracted from the remaining suspects, such as |b|.
+  a = nullptr;
+  nsCycleCollector_doDeferredDeletion();
+  EXPECT_GE(nsCycleCollector_suspectedCount(), count + 1);
+
+  // A manual collection scans the remaining suspects.
+  nsCycleCollector_collect(CCReason::API, nullptr);
+  EXPECT_FALSE(b->IsSuspected());
+}
+
+TEST(CycleCollector, GenerationalDisabled)
+{
+  Preferences::SetBool("dom.cycle_collector.generational", false);
+  nsCycleCollector_collect(CCReason::API, nullptr);
+
+  // With generational collection turned off, long-lived suspects are never
+  // deferred and every collection scans them.
+  RefPtr<TestCCObject> a = new TestCCObject();
+  for (int i = 0; i < 5; i++) {
+    a->Suspect();
+    ASSERT_TRUE(a->IsSuspected());
+    YoungCollection();
+    EXPECT_FALSE(a->IsSuspected());
+  }
+
+  Preferences::ClearUser("dom.cycle_collector.generational");
+}
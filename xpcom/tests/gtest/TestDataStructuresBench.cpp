@@ -0,0 +1,105 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Microbenchmarks for core XPCOM/MFBT containers that don't already have one.
+// Hash tables are covered by xpcom/rust/gtest/bench-collections and strings
+// by TestStrings.cpp. Like those, these use MOZ_GTEST_BENCH so that results
+// are reported to PerfHerder and can be compared across pushes.
+//
+// To run just these:
+//
+//   ./mach gtest 'DataStructuresBench.*'
+
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH
+#include "gtest/BlackBox.h"
+
+#include "mozilla/SPSCQueue.h"
+#include "mozilla/Vector.h"
+#include "nsAtom.h"
+#include "nsPrintfCString.h"
+#include "nsTArray.h"
+
+using namespace mozilla;
+
+static const size_t kNumElements = 100000;
+static const size_t kNumAtoms = 1000;
+
+MOZ_GTEST_BENCH(DataStructuresBench, TArrayAppend, [] {
+  nsTArray<uint32_t> array;
+  for (size_t i = 0; i < kNumElements; i++) {
+    array.AppendElement(uint32_t(i));
+  }
+  MOZ_RELEASE_ASSERT(BlackBox(&array)->Length() == kNumElements);
+});
+
+MOZ_GTEST_BENCH(DataStructuresBench, TArraySetCapacityAppend, [] {
+  nsTArray<uint32_t> array;
+  array.SetCapacity(kNumElements);
+  for (size_t i = 0; i < kNumElements; i++) {
+    array.AppendElement(uint32_t(i));
+  }
+  MOZ_RELEASE_ASSERT(BlackBox(&array)->Length() == kNumElements);
+});
+
+MOZ_GTEST_BENCH(DataStructuresBench, TArraySort, [] {
+  nsTArray<uint32_t> array(kNumElements);
+  uint32_t s = 0;
+  for (size_t i = 0; i < kNumElements; i++) {
+    s = s * 1103515245 + 12345;
+    array.AppendElement(s);
+  }
+  array.Sort();
+  MOZ_RELEASE_ASSERT(BlackBox(&array)->Length() == kNumElements);
+});
+
+MOZ_GTEST_BENCH(DataStructuresBench, VectorAppend, [] {
+  Vector<uint32_t> vector;
+  for (size_t i = 0; i < kNumElements; i++) {
+    MOZ_RELEASE_ASSERT(vector.append(uint32_t(i)));
+  }
+  MOZ_RELEASE_ASSERT(BlackBox(&vector)->length() == kNumElements);
+});
+
+MOZ_GTEST_BENCH(DataStructuresBench, VectorInlineAppend, [] {
+  for (size_t i = 0; i < kNumElements / 16; i++) {
+    Vector<uint32_t, 16> vector;
+    for (uint32_t j = 0; j < 16; j++) {
+      MOZ_RELEASE_ASSERT(vector.append(j));
+    }
+    MOZ_RELEASE_ASSERT(BlackBox(&vector)->length() == 16);
+  }
+});
+
+MOZ_GTEST_BENCH(DataStructuresBench, AtomizeExisting, [] {
+  nsTArray<nsCString> strings(kNumAtoms);
+  nsTArray<RefPtr<nsAtom>> atoms(kNumAtoms);
+  for (size_t i = 0; i < kNumAtoms; i++) {
+    strings.AppendElement(nsPrintfCString("bench-atom-%zu", i));
+    atoms.AppendElement(NS_Atomize(strings.LastElement()));
+  }
+  // Every lookup hits an entry in the atom table.
+  for (size_t n = 0; n < 100; n++) {
+    for (size_t i = 0; i < kNumAtoms; i++) {
+      RefPtr<nsAtom> atom = NS_Atomize(*BlackBox(&strings[i]));
+      MOZ_RELEASE_ASSERT(atom == atoms[i]);
+    }
+  }
+});
+
+MOZ_GTEST_BENCH(DataStructuresBench, SPSCQueueRoundTrip, [] {
+  SPSCQueue<uint32_t> queue(1024);
+  uint32_t in[128];
+  uint32_t out[128];
+  for (uint32_t i = 0; i < 128; i++) {
+    in[i] = i;
+  }
+  for (size_t i = 0; i < kNumElements / 128; i++) {
+    MOZ_RELEASE_ASSERT(queue.Enqueue(BlackBox(in), 128) == 128);
+    MOZ_RELEASE_ASSERT(queue.Dequeue(BlackBox(out), 128) == 128);
+  }
+  MOZ_RELEASE_ASSERT(out[127] == 127);
+});
@@ -382,6 +382,44 @@ TEST(PLDHashTableTest, WithEntryHandle)
   ASSERT_EQ(entry1, entry2);
 }
 
+// Only three distinct hash values, so every key shares a probe sequence with
+// many others.
+static PLDHashNumber CollidingHash(const void* key) {
+  return (PLDHashNumber)((size_t)key % 3);
+}
+
+static const PLDHashTableOps collidingOps = {
+    CollidingHash, PLDHashTable::MatchEntryStub, PLDHashTable::MoveEntryStub,
+    PLDHashTable::ClearEntryStub, TrivialInitEntry};
+
+TEST(PLDHashTableTest, CollidingKeysWithRemovals)
+{
+  PLDHashTable t(&collidingOps, sizeof(PLDHashEntryStub));
+
+  for (size_t i = 0; i < 200; i++) {
+    ASSERT_TRUE(t.Add((const void*)i, mozilla::fallible));
+  }
+
+  // Removing keys from the middle of shared probe sequences must not hide the
+  // keys added after them.
+  for (size_t i = 0; i < 200; i += 2) {
+    t.Remove((const void*)i);
+  }
+  ASSERT_EQ(t.EntryCount(), 100u);
+  for (size_t i = 0; i < 200; i++) {
+    ASSERT_EQ(!!t.Search((const void*)i), i % 2 == 1);
+  }
+
+  // Re-adding recycles removed slots.
+  for (size_t i = 0; i < 300; i += 2) {
+    ASSERT_TRUE(t.Add((const void*)i, mozilla::fallible));
+  }
+  ASSERT_EQ(t.EntryCount(), 250u);
+  for (size_t i = 0; i < 300; i++) {
+    ASSERT_EQ(!!t.Search((const void*)i), i < 200 || i % 2 == 0);
+  }
+}
+
 // This test involves resizing a table repeatedly up to 512 MiB in size. On
 // 32-bit platforms (Win32, Android) it sometimes OOMs, causing the test to
 // fail. (See bug 931062 and bug 1267227.) Therefore, we only run it on 64-bit
@@ -54,9 +54,17 @@ struct TaskMarker {
     return MakeStringSpan("Task");
   }
   static void StreamJSONMarkerData(baseprofiler::SpliceableJSONWriter& aWriter,
-                                   const nsCString& aName, uint32_t aPriority) {
+                                   const nsCString& aName, uint32_t aPriority,
+                                   const TimeStamp& aInsertionTime,
+                                   const TimeStamp& aStartTime) {
     aWriter.StringProperty("name", aName);
     aWriter.IntProperty("priority", aPriority);
+    // Time the task spent queued between dispatch and starting to run. This
+    // is computed at serialization time to keep the hot path cheap.
+    if (!aInsertionTime.IsNull() && !aStartTime.IsNull()) {
+      aWriter.DoubleProperty("queueDelay",
+                             (aStartTime - aInsertionTime).ToMilliseconds());
+    }
 
 #  define EVENT_PRIORITY(NAME, VALUE)                \
     if (aPriority == (VALUE)) {                      \
@@ -79,14 +87,17 @@ struct TaskMarker {
     schema.AddKeyLabelFormat("priorityName", "Priority Name",
                              MS::Format::String);
     schema.AddKeyLabelFormat("priority", "Priority level", MS::Format::Integer);
+    schema.AddKeyLabelFormat("queueDelay", "Queue Delay",
+                             MS::Format::Duration);
     return schema;
   }
 };
 
 class MOZ_RAII AutoProfileTask {
  public:
-  explicit AutoProfileTask(nsACString& aName, uint64_t aPriority)
-      : mName(aName), mPriority(aPriority) {
+  AutoProfileTask(nsACString& aName, uint64_t aPriority,
+                  const TimeStamp& aInsertionTime)
+      : mInsertionTime(aInsertionTime), mName(aName), mPriority(aPriority) {
     if (profiler_is_active()) {
       mStartTime = TimeStamp::Now();
     }
@@ -103,10 +114,12 @@ class MOZ_RAII AutoProfileTask {
                         mStartTime.IsNull()
                             ? MarkerTiming::IntervalEnd()
                             : MarkerTiming::IntervalUntilNowFrom(mStartTime),
-                        TaskMarker{}, mName, mPriority);
+                        TaskMarker{}, mName, mPriority, mInsertionTime,
+                        mStartTime);
   }
 
  private:
+  TimeStamp mInsertionTime;
   TimeStamp mStartTime;
   nsAutoCString mName;
   uint32_t mPriority;
@@ -116,7 +129,8 @@ class MOZ_RAII AutoProfileTask {
     nsAutoCString name;                                                      \
     (task)->GetName(name);                                                   \
     AUTO_PROFILER_LABEL_DYNAMIC_NSCSTRING_NONSENSITIVE("Task", OTHER, name); \
-    mozilla::AutoProfileTask PROFILER_RAII(name, (task)->GetPriority());
+    mozilla::AutoProfileTask PROFILER_RAII(name, (task)->GetPriority(),   \
+                                           (task)->mInsertionTime);
 #else
 #  define AUTO_PROFILE_FOLLOWING_TASK(task)
 #endif
@@ -264,6 +278,18 @@ void TaskController::ShutdownThreadPoolInternal() {
 
 void TaskController::ShutdownInternal() { sSingleton = nullptr; }
 
+// Wake up an idle pool thread, unless every idle thread has already been
+// notified. A woken thread wakes up another one if it leaves threadable tasks
+// behind, so there's no need to wake a thread per task, and none of them would
+// make progress without the graph mutex anyway.
+void TaskController::WakePoolThread() {
+  mGraphMutex.AssertCurrentThreadOwns();
+  if (mIdlePoolThreadCount > mPendingPoolWakeups) {
+    mPendingPoolWakeups++;
+    mThreadPoolCV.Notify();
+  }
+}
+
 void TaskController::RunPoolThread() {
   IOInterposer::RegisterCurrentThread();
 
@@ -316,7 +342,7 @@ void TaskController::RunPoolThread() {
           // more threadable tasks to process. Notifying all threads at once
           // isn't actually better for performance since they all need the
           // GraphMutex to proceed anyway.
-          mThreadPoolCV.Notify();
+          WakePoolThread();
         }
 
         bool taskCompleted = false;
@@ -361,8 +387,11 @@ void TaskController::RunPoolThread() {
       }
     }
 
-    // Ensure the last task is released before we enter the wait state.
-    if (lastTask) {
+    // Ensure the last task is released before we enter the wait state. If
+    // there may be another task to run, keep it instead: it is released while
+    // that task runs, which saves unlocking and relocking the graph mutex
+    // between tasks.
+    if (lastTask && (!ranTask || mThreadableTasks.empty())) {
       MutexAutoUnlock unlock(mGraphMutex);
       lastTask = nullptr;
 
@@ -379,7 +408,12 @@ void TaskController::RunPoolThread() {
       }
 
       AUTO_PROFILER_LABEL("TaskController::RunPoolThread", IDLE);
+      mIdlePoolThreadCount++;
       mThreadPoolCV.Wait();
+      mIdlePoolThreadCount--;
+      if (mPendingPoolWakeups) {
+        mPendingPoolWakeups--;
+      }
     }
   }
 }
@@ -886,7 +920,7 @@ bool TaskController::DoExecuteNextTaskOnlyMainThreadInternal(
           // We're going to wake up a single thread in our pool. This thread
           // is responsible for waking up additional threads in the situation
           // where more than one task became available.
-          mThreadPoolCV.Notify();
+          WakePoolThread();
         }
       }
 
@@ -965,7 +999,7 @@ void TaskController::MaybeInterruptTask(Task* aTask) {
     Task* lowestPriorityTask = nullptr;
     for (PoolThread& thread : mPoolThreads) {
       if (!thread.mCurrentTask) {
-        mThreadPoolCV.Notify();
+        WakePoolThread();
         // There's a free thread, no need to interrupt anything.
         return;
       }
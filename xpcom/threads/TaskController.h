@@ -372,6 +372,7 @@ class TaskController {
   void ShutdownInternal();
 
   void RunPoolThread();
+  void WakePoolThread();
 
   static std::unique_ptr<TaskController> sSingleton;
   static StaticMutex sSingletonMutex MOZ_UNANNOTATED;
@@ -401,6 +402,11 @@ class TaskController {
   // We can use a raw pointer since tasks always hold on to their TaskManager.
   std::set<TaskManager*> mTaskManagers;
 
+  // The number of pool threads blocked on mThreadPoolCV, and how many of them
+  // have been notified but haven't woken up yet. See WakePoolThread().
+  uint32_t mIdlePoolThreadCount = 0;
+  uint32_t mPendingPoolWakeups = 0;
+
   // This ensures we keep running the main thread if we processed a task there.
   bool mMayHaveMainThreadTask = true;
   bool mShuttingDown = false;
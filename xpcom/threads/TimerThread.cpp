@@ -574,6 +574,12 @@ TimerThread::Run() {
           // round up, wait the minimum time we can wait
           waitFor = TimeDuration::FromMicroseconds(1);
         }
+
+        // Wait a little longer if asked to, so that the timers due within
+        // the slack of this one fire in the same wakeup.
+        if (uint32_t slack = StaticPrefs::timer_coalescing_slack_ms()) {
+          waitFor += TimeDuration::FromMilliseconds(slack);
+        }
       }
 
       if (MOZ_LOG_TEST(GetTimerLog(), LogLevel::Debug)) {